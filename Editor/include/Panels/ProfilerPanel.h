@@ -1 +1,29 @@
 #pragma once
+
+#include "Panels/EditorPanel.h"
+#include "Physics2D/Physics2DManager.h"
+#include "Scene/SceneBinarySerializer.h"
+
+#include <memory>
+
+namespace Luden
+{
+	class Scene;
+
+	class ProfilerPanel : public EditorPanel
+	{
+	public:
+		ProfilerPanel() : EditorPanel("Profiler") {}
+		~ProfilerPanel() = default;
+
+		void SetContext(const std::shared_ptr<Scene>& context) { m_Context = context; }
+
+	private:
+		virtual void RenderContent() override final;
+
+	private:
+		std::shared_ptr<Scene> m_Context;
+		PhysicsBenchmarkResult m_BenchmarkResult;
+		SceneLoadBenchmarkResult m_SceneLoadResult;
+	};
+}
@@ -7,6 +7,7 @@
 #include "Panels/ResourceBrowserPanel.h"
 #include "Panels/DebugSettingsPanel.h"
 #include "Panels/CollisionChannelPanel.h"
+#include "Panels/ProfilerPanel.h"
 #include "Scene/Scene.h"
 
 #include <SFML/Graphics/RenderTexture.hpp>
@@ -92,6 +93,7 @@ namespace Luden
 		ResourceBrowserPanel m_ResourceBrowserPanel;
 		DebugSettingsPanel m_DebugSettingsPanel;
 		CollisionChannelPanel m_CollisionChannelPanel;
+		ProfilerPanel m_ProfilerPanel;
 
 		std::filesystem::path m_ActiveScenePath = std::filesystem::canonical(".");
 
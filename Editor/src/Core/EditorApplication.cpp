@@ -10,6 +10,7 @@
 #include "Utils/ImGuiStyle.h"
 #include "NativeScript/NativeScriptModuleLoader.h"
 #include "Core/Config.h"
+#include "Physics2D/Physics2DManager.h"
 #include <Tabs/Animation2DEditorTab.h>
 #include "Tabs/SpriteEditorTab.h"
 #include "Tabs/PrefabEditorTab.h"
@@ -32,6 +33,8 @@ namespace Luden
 
 	void EditorApplication::Init() 
 	{
+		GEngine.GetJobSystem().Init(0, Physics2DManager::MaxWorkerCount);
+
 		// Editor window
 		m_Window.create(sf::VideoMode(sf::Vector2u(1920, 1080)), "Luden Editor", sf::Style::Titlebar);
 		m_Window.setFramerateLimit(60);
@@ -110,6 +113,8 @@ namespace Luden
 		{
 			Project::GetResourceManager()->Shutdown();
 		}
+
+		GEngine.GetJobSystem().Shutdown();
 	}
 
 	void EditorApplication::OnUpdate(TimeStep timestep)
@@ -3,6 +3,7 @@
 #include "ImGui/ImGuiUtils.h"
 #include "Project/Project.h"
 #include "Graphics/Animation.h"
+#include "Graphics/ParticleEmitter.h"
 #include "ECS/Components/Components.h"
 #include "NativeScript/NativeScriptGenerator.h"
 #include "NativeScript/NativeScript.h"
@@ -22,6 +23,110 @@ namespace Luden
 	constexpr ImGuiTreeNodeFlags innerTreeNodeFlags = ImGuiTreeNodeFlags_OpenOnDoubleClick |
 		ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_FramePadding;
 
+	static void DrawCollisionEvents(uint8_t& collisionEvents)
+	{
+		ImGuiUtils::PrefixLabel("Collision Events");
+
+		auto eventCheckbox = [&](const char* label, CollisionEvent event)
+			{
+				bool enabled = HasCollisionEvent(collisionEvents, event);
+				if (ImGui::Checkbox(label, &enabled))
+				{
+					if (enabled)
+						collisionEvents |= (uint8_t)event;
+					else
+						collisionEvents &= ~(uint8_t)event;
+				}
+			};
+
+		eventCheckbox("Begin##CollisionEvents", CollisionEvent::Begin);
+		ImGui::SameLine();
+		eventCheckbox("End##CollisionEvents", CollisionEvent::End);
+		ImGui::SameLine();
+		eventCheckbox("Hit##CollisionEvents", CollisionEvent::Hit);
+
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Events this collider reports to its script. The script must ask for them too.");
+
+		ImGuiUtils::PrefixLabel("Trigger Events");
+		eventCheckbox("Begin##TriggerEvents", CollisionEvent::TriggerBegin);
+		ImGui::SameLine();
+		eventCheckbox("End##TriggerEvents", CollisionEvent::TriggerEnd);
+
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Overlaps a sensor collider reports. A sensor with both unchecked detects nothing.");
+	}
+
+	static void DrawCollisionFiltering(uint16_t& categoryBits, uint16_t& maskBits, uint16_t& groupIndex)
+	{
+		const auto& allChannels = CollisionChannelRegistry::Instance().GetAllChannels();
+
+		auto channelCombo = [&](const char* label, const char* id, uint16_t& bits)
+			{
+				std::string selectedText;
+				for (const auto& channel : allChannels)
+				{
+					if (bits & channel.Bit)
+					{
+						if (!selectedText.empty())
+							selectedText += ", ";
+						selectedText += channel.Name;
+					}
+				}
+
+				ImGuiUtils::PrefixLabel(label);
+				if (ImGui::BeginCombo(id, selectedText.empty() ? "(None)" : selectedText.c_str()))
+				{
+					for (const auto& channel : allChannels)
+					{
+						bool isSelected = (bits & channel.Bit) != 0;
+						if (ImGui::Checkbox(channel.Name.c_str(), &isSelected))
+						{
+							if (isSelected)
+								bits |= channel.Bit;
+							else
+								bits &= ~channel.Bit;
+						}
+					}
+					ImGui::EndCombo();
+				}
+			};
+
+		ImGui::Separator();
+		ImGui::Text("Collision Filtering");
+		ImGui::Separator();
+
+		channelCombo("Category (I am)", "##CategoryBits", categoryBits);
+		channelCombo("Mask (Collides with)", "##MaskBits", maskBits);
+
+		ImGuiUtils::PrefixLabel("Group Index");
+		int group = static_cast<int16_t>(groupIndex);
+		if (ImGui::DragInt("##GroupIndex", &group, 1, -32768, 32767))
+			groupIndex = static_cast<uint16_t>(group);
+	}
+
+	static void DrawColliderPoints(std::vector<glm::vec2>& points, size_t maxPoints)
+	{
+		ImGui::Text("Points:");
+		for (size_t i = 0; i < points.size(); i++)
+		{
+			ImGui::PushID((int)i);
+			ImGuiUtils::PrefixLabel(("Point " + std::to_string(i)).c_str());
+			ImGuiUtils::DragFloat2Colored("##Point", &points[i].x, 0.1f);
+			ImGui::PopID();
+		}
+
+		if (points.size() < maxPoints && ImGui::Button(ICON_FA_PLUS " Add Point"))
+		{
+			glm::vec2 next = points.empty() ? glm::vec2(0.0f, 0.0f) : points.back() + glm::vec2(1.0f, 0.0f);
+			points.push_back(next);
+		}
+		if (!points.empty() && ImGui::Button(ICON_FA_MINUS " Remove Last Point"))
+		{
+			points.pop_back();
+		}
+	}
+
 	void InspectorPanel::SetContext(const std::shared_ptr<Scene>& context, SceneHierarchyPanel* sceneHierarchyPanel, EditorApplication* editorApplication)
 	{
 		m_Context = context;
@@ -86,12 +191,17 @@ namespace Luden
 				DisplayComponentInPopup<Camera2DComponent>(ICON_FA_CAMERA " Camera2D Component");
 				DisplayComponentInPopup<BoxCollider2DComponent>(ICON_FA_SQUARE " Box Collider 2D Component");
 				DisplayComponentInPopup<CircleCollider2DComponent>(ICON_FA_CIRCLE " Circle Collider 2D Component");
+				DisplayComponentInPopup<CapsuleCollider2DComponent>(ICON_FA_CAPSULES " Capsule Collider 2D Component");
+				DisplayComponentInPopup<PolygonCollider2DComponent>(ICON_FA_DRAW_POLYGON " Polygon Collider 2D Component");
+				DisplayComponentInPopup<ChainCollider2DComponent>(ICON_FA_LINK " Chain Collider 2D Component");
 				DisplayComponentInPopup<RigidBody2DComponent>(ICON_FA_CUBES " RigidBody 2D Component");
 				DisplayComponentInPopup<PrefabComponent>(ICON_FA_CUBE " Prefab Component");
 				DisplayComponentInPopup<NativeScriptComponent>(ICON_FA_CODE " Native Script Component");
 				DisplayComponentInPopup<SpriteAnimatorComponent>(ICON_FA_PLAY " Animation Component");
 				DisplayComponentInPopup<TextComponent>(ICON_FA_FONT " Text Component");
 				DisplayComponentInPopup<SpriteRendererComponent>(ICON_FA_IMAGE " Sprite Renderer Component");
+				DisplayComponentInPopup<TilemapComponent>(ICON_FA_TABLE_CELLS " Tilemap Component");
+				DisplayComponentInPopup<ParticleEmitterComponent>(ICON_FA_WAND_MAGIC_SPARKLES " Particle Emitter Component");
 				DisplayComponentInPopup<InvincibilityComponent>(ICON_FA_SHIELD_HALVED " Invincibility Component");
 				DisplayComponentInPopup<LifespanComponent>(ICON_FA_CLOCK " Lifespan Component");
 				DisplayComponentInPopup<PatrolComponent>(ICON_FA_ROAD " Patrol Component");
@@ -220,6 +330,9 @@ namespace Luden
 
 						ImGuiUtils::PrefixLabel("Gravity Scale");
 						ImGui::DragFloat("##GravityScale", &rb.GravityScale, 0.1f, 0.0f, 10.0f);
+
+						ImGuiUtils::PrefixLabel("Bullet");
+						ImGui::Checkbox("##IsBullet", &rb.IsBullet);
 					});
 
 				DisplayComponentInInspector<BoxCollider2DComponent>(ICON_FA_SQUARE " Box Collider 2D Component", entity, true, [&]()
@@ -243,6 +356,9 @@ namespace Luden
 						ImGuiUtils::PrefixLabel("Restitution");
 						ImGui::DragFloat("##Restitution", &box.Restitution, 0.1f, 0.0f, 10.0f);
 
+						ImGuiUtils::PrefixLabel("Is Sensor");
+						ImGui::Checkbox("##IsSensor", &box.IsSensor);
+
 						ImGui::Separator();
 						ImGui::Text("Collision Filtering");
 						ImGui::Separator();
@@ -359,6 +475,8 @@ namespace Luden
 							);
 						}
 
+						DrawCollisionEvents(box.CollisionEvents);
+
 						// Quick Presets
 						if (ImGui::TreeNode("Quick Presets"))
 						{
@@ -424,6 +542,9 @@ namespace Luden
 						ImGuiUtils::PrefixLabel("Restitution");
 						ImGui::DragFloat("##Restitution", &circle.Restitution, 0.1f, 0.0f, 10.0f);
 
+						ImGuiUtils::PrefixLabel("Is Sensor");
+						ImGui::Checkbox("##IsSensor", &circle.IsSensor);
+
 						ImGui::Separator();
 						ImGui::Text("Collision Filtering");
 						ImGui::Separator();
@@ -540,6 +661,8 @@ namespace Luden
 							);
 						}
 
+						DrawCollisionEvents(circle.CollisionEvents);
+
 						// Quick Presets
 						if (ImGui::TreeNode("Quick Presets"))
 						{
@@ -573,6 +696,92 @@ namespace Luden
 						}
 				});
 
+				DisplayComponentInInspector<CapsuleCollider2DComponent>(ICON_FA_CAPSULES " Capsule Collider 2D Component", entity, true, [&]()
+					{
+						auto& capsule = entity.Get<CapsuleCollider2DComponent>();
+
+						ImGuiUtils::PrefixLabel("Offset");
+						ImGuiUtils::DragFloat2Colored("##Offset", &capsule.Offset.x, 0.1f);
+
+						ImGuiUtils::PrefixLabel("Height");
+						ImGui::DragFloat("##Height", &capsule.Height, 0.1f, 0.0f, 10000.0f);
+
+						ImGuiUtils::PrefixLabel("Radius");
+						ImGui::DragFloat("##Radius", &capsule.Radius, 0.1f, 0.0f, 10000.0f);
+
+						ImGuiUtils::PrefixLabel("Horizontal");
+						ImGui::Checkbox("##Horizontal", &capsule.Horizontal);
+
+						ImGuiUtils::PrefixLabel("Density");
+						ImGui::DragFloat("##Density", &capsule.Density, 0.1f, 0.0f, 10.0f);
+
+						ImGuiUtils::PrefixLabel("Friction");
+						ImGui::DragFloat("##Friction", &capsule.Friction, 0.1f, 0.0f, 10.0f);
+
+						ImGuiUtils::PrefixLabel("Restitution");
+						ImGui::DragFloat("##Restitution", &capsule.Restitution, 0.1f, 0.0f, 10.0f);
+
+						ImGuiUtils::PrefixLabel("Is Sensor");
+						ImGui::Checkbox("##IsSensor", &capsule.IsSensor);
+
+						DrawCollisionFiltering(capsule.CategoryBits, capsule.MaskBits, capsule.GroupIndex);
+						DrawCollisionEvents(capsule.CollisionEvents);
+					});
+
+				DisplayComponentInInspector<PolygonCollider2DComponent>(ICON_FA_DRAW_POLYGON " Polygon Collider 2D Component", entity, true, [&]()
+					{
+						auto& polygon = entity.Get<PolygonCollider2DComponent>();
+
+						ImGuiUtils::PrefixLabel("Offset");
+						ImGuiUtils::DragFloat2Colored("##Offset", &polygon.Offset.x, 0.1f);
+
+						DrawColliderPoints(polygon.Points, B2_MAX_POLYGON_VERTICES);
+
+						if (polygon.Points.size() < 3)
+							ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "Needs at least 3 points");
+
+						ImGuiUtils::PrefixLabel("Corner Radius");
+						ImGui::DragFloat("##Radius", &polygon.Radius, 0.1f, 0.0f, 10000.0f);
+
+						ImGuiUtils::PrefixLabel("Density");
+						ImGui::DragFloat("##Density", &polygon.Density, 0.1f, 0.0f, 10.0f);
+
+						ImGuiUtils::PrefixLabel("Friction");
+						ImGui::DragFloat("##Friction", &polygon.Friction, 0.1f, 0.0f, 10.0f);
+
+						ImGuiUtils::PrefixLabel("Restitution");
+						ImGui::DragFloat("##Restitution", &polygon.Restitution, 0.1f, 0.0f, 10.0f);
+
+						ImGuiUtils::PrefixLabel("Is Sensor");
+						ImGui::Checkbox("##IsSensor", &polygon.IsSensor);
+
+						DrawCollisionFiltering(polygon.CategoryBits, polygon.MaskBits, polygon.GroupIndex);
+						DrawCollisionEvents(polygon.CollisionEvents);
+					});
+
+				DisplayComponentInInspector<ChainCollider2DComponent>(ICON_FA_LINK " Chain Collider 2D Component", entity, true, [&]()
+					{
+						auto& chain = entity.Get<ChainCollider2DComponent>();
+
+						DrawColliderPoints(chain.Points, SIZE_MAX);
+
+						ImGuiUtils::PrefixLabel("Loop");
+						ImGui::Checkbox("##Loop", &chain.Loop);
+
+						if (chain.Points.size() >= 4)
+							ImGui::TextDisabled("One-sided chain, collides on the right of each segment");
+						else
+							ImGui::TextDisabled("Two-sided segments");
+
+						ImGuiUtils::PrefixLabel("Friction");
+						ImGui::DragFloat("##Friction", &chain.Friction, 0.1f, 0.0f, 10.0f);
+
+						ImGuiUtils::PrefixLabel("Restitution");
+						ImGui::DragFloat("##Restitution", &chain.Restitution, 0.1f, 0.0f, 10.0f);
+
+						DrawCollisionFiltering(chain.CategoryBits, chain.MaskBits, chain.GroupIndex);
+					});
+
 				DisplayComponentInInspector<PrefabComponent>(ICON_FA_CUBE " Prefab Component", entity, true, [&]()
 				{
 					auto& prefabComp = entity.Get<PrefabComponent>();
@@ -1246,6 +1455,184 @@ namespace Luden
 						}
 					});
 
+				DisplayComponentInInspector<TilemapComponent>(ICON_FA_TABLE_CELLS " Tilemap Component", entity, true, [&]()
+					{
+						auto& tilemapComponent = entity.Get<TilemapComponent>();
+
+						ImGuiUtils::PrefixLabel("Tileset");
+						if (ImGuiUtils::ResourceButton(tilemapComponent.TilesetHandle, ResourceType::Tileset))
+						{
+							//TODO: Open tileset editor
+						}
+
+						ImGuiUtils::PrefixLabel(ICON_FA_PALETTE " Tint");
+
+						ImVec4 color = {
+							tilemapComponent.Tint.r / 255.0f,
+							tilemapComponent.Tint.g / 255.0f,
+							tilemapComponent.Tint.b / 255.0f,
+							tilemapComponent.Tint.a / 255.0f
+						};
+
+						if (ImGui::ColorEdit4("##TilemapTint", &color.x))
+						{
+							tilemapComponent.Tint = sf::Color(
+								static_cast<uint8_t>(color.x * 255.0f),
+								static_cast<uint8_t>(color.y * 255.0f),
+								static_cast<uint8_t>(color.z * 255.0f),
+								static_cast<uint8_t>(color.w * 255.0f)
+							);
+						}
+
+						ImGuiUtils::PrefixLabel("Generate Colliders");
+						ImGui::Checkbox("##GenerateColliders", &tilemapComponent.GenerateColliders);
+
+						ImGui::BeginDisabled(!tilemapComponent.GenerateColliders);
+						ImGuiUtils::PrefixLabel("Friction");
+						ImGui::DragFloat("##TilemapFriction", &tilemapComponent.Friction, 0.01f, 0.0f, 1.0f);
+
+						ImGuiUtils::PrefixLabel("Restitution");
+						ImGui::DragFloat("##TilemapRestitution", &tilemapComponent.Restitution, 0.01f, 0.0f, 1.0f);
+						ImGui::EndDisabled();
+
+						size_t tileCount = 0;
+						for (const auto& [key, chunk] : tilemapComponent.Chunks)
+							tileCount += chunk.TileCount;
+
+						ImGui::Text("Chunks: %zu  Tiles: %zu", tilemapComponent.Chunks.size(), tileCount);
+
+						ImGui::SeparatorText("Fill");
+
+						static int fillRect[4] = { 0, 0, 1, 1 };
+						static int fillTile = 0;
+
+						ImGuiUtils::PrefixLabel("Position");
+						ImGui::DragInt2("##FillPosition", &fillRect[0]);
+
+						ImGuiUtils::PrefixLabel("Size");
+						ImGui::DragInt2("##FillSize", &fillRect[2], 1.0f, 1, 4096);
+
+						ImGuiUtils::PrefixLabel("Tile");
+						ImGui::DragInt("##FillTile", &fillTile, 1.0f, 0, UINT16_MAX - 1);
+
+						if (ImGui::Button("Fill"))
+						{
+							tilemapComponent.Fill(fillRect[0], fillRect[1], fillRect[2], fillRect[3], (uint16_t)(fillTile + 1));
+						}
+						ImGui::SameLine();
+						if (ImGui::Button("Erase"))
+						{
+							tilemapComponent.Fill(fillRect[0], fillRect[1], fillRect[2], fillRect[3], 0);
+						}
+						ImGui::SameLine();
+						if (ImGui::Button("Clear"))
+						{
+							tilemapComponent.Clear();
+						}
+					});
+
+				DisplayComponentInInspector<ParticleEmitterComponent>(ICON_FA_WAND_MAGIC_SPARKLES " Particle Emitter Component", entity, true, [&]()
+					{
+						auto& emitterComponent = entity.Get<ParticleEmitterComponent>();
+
+						ImGuiUtils::PrefixLabel("Emitter");
+						ImGuiUtils::ResourceButton(emitterComponent.EmitterHandle, ResourceType::ParticleEmitter);
+
+						ImGuiUtils::PrefixLabel("Playing");
+						ImGui::Checkbox("##EmitterPlaying", &emitterComponent.Playing);
+
+						ImGuiUtils::PrefixLabel("Simulation Speed");
+						ImGui::DragFloat("##EmitterSimulationSpeed", &emitterComponent.SimulationSpeed, 0.01f, 0.0f, 10.0f);
+
+						if (ImGui::Button(ICON_FA_ROTATE_RIGHT " Restart"))
+						{
+							m_Context->GetParticleSystem().Reset(entity.UUID());
+						}
+
+						auto emitter = ResourceManager::GetResource<ParticleEmitter>(emitterComponent.EmitterHandle);
+						if (!emitter)
+							return;
+
+						// The emitter is a shared resource, edits apply to every entity using it
+						ImGui::SeparatorText(emitter->GetName().c_str());
+
+						ImGuiUtils::PrefixLabel("Sprite");
+						ImGuiUtils::ResourceButton(emitter->SpriteHandle, ResourceType::Sprite);
+
+						int maxParticles = (int)emitter->MaxParticles;
+						ImGuiUtils::PrefixLabel("Max Particles");
+						if (ImGui::DragInt("##MaxParticles", &maxParticles, 10.0f, 1, 1000000))
+							emitter->MaxParticles = (uint32_t)maxParticles;
+
+						ImGuiUtils::PrefixLabel("Emission Rate");
+						ImGui::DragFloat("##EmissionRate", &emitter->EmissionRate, 1.0f, 0.0f, 100000.0f);
+
+						int burstCount = (int)emitter->BurstCount;
+						ImGuiUtils::PrefixLabel("Burst");
+						if (ImGui::DragInt("##BurstCount", &burstCount, 1.0f, 0, 100000))
+							emitter->BurstCount = (uint32_t)burstCount;
+
+						ImGuiUtils::PrefixLabel("Duration");
+						ImGui::DragFloat("##EmitterDuration", &emitter->Duration, 0.05f, 0.0f, 1000.0f);
+
+						ImGuiUtils::PrefixLabel("Looping");
+						ImGui::Checkbox("##EmitterLooping", &emitter->Looping);
+
+						ImGuiUtils::PrefixLabel("World Space");
+						ImGui::Checkbox("##EmitterWorldSpace", &emitter->WorldSpace);
+
+						ImGuiUtils::PrefixLabel("Lifetime");
+						ImGui::DragFloatRange2("##Lifetime", &emitter->LifetimeMin, &emitter->LifetimeMax, 0.01f, 0.0f, 100.0f);
+
+						ImGuiUtils::PrefixLabel("Speed");
+						ImGui::DragFloatRange2("##Speed", &emitter->SpeedMin, &emitter->SpeedMax, 1.0f, 0.0f, 10000.0f);
+
+						ImGuiUtils::PrefixLabel("Direction");
+						ImGui::DragFloat("##EmitterDirection", &emitter->Direction, 1.0f, -360.0f, 360.0f);
+
+						ImGuiUtils::PrefixLabel("Spread");
+						ImGui::DragFloat("##EmitterSpread", &emitter->Spread, 1.0f, 0.0f, 360.0f);
+
+						ImGuiUtils::PrefixLabel("Gravity");
+						ImGui::DragFloat2("##EmitterGravity", &emitter->Gravity.x, 1.0f);
+
+						ImGuiUtils::PrefixLabel("Drag");
+						ImGui::DragFloat("##EmitterDrag", &emitter->Drag, 0.01f, 0.0f, 100.0f);
+
+						auto colorEdit = [](const char* label, sf::Color& color)
+							{
+								ImVec4 value = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+								if (ImGui::ColorEdit4(label, &value.x))
+								{
+									color = sf::Color(
+										static_cast<uint8_t>(value.x * 255.0f),
+										static_cast<uint8_t>(value.y * 255.0f),
+										static_cast<uint8_t>(value.z * 255.0f),
+										static_cast<uint8_t>(value.w * 255.0f)
+									);
+								}
+							};
+
+						ImGuiUtils::PrefixLabel("Start Color");
+						colorEdit("##StartColor", emitter->StartColor);
+
+						ImGuiUtils::PrefixLabel("End Color");
+						colorEdit("##EndColor", emitter->EndColor);
+
+						ImGuiUtils::PrefixLabel("Start Size");
+						ImGui::DragFloat("##StartSize", &emitter->StartSize, 0.1f, 0.0f, 1000.0f);
+
+						ImGuiUtils::PrefixLabel("End Size");
+						ImGui::DragFloat("##EndSize", &emitter->EndSize, 0.1f, 0.0f, 1000.0f);
+
+						ImGui::Text("Live Particles: %u", m_Context->GetParticleSystem().GetLiveParticleCount());
+
+						if (ImGui::Button(ICON_FA_FLOPPY_DISK " Save Emitter"))
+						{
+							ResourceImporter::Serialize(emitter);
+						}
+					});
+
 				DisplayComponentInInspector<InvincibilityComponent>(ICON_FA_SHIELD_HALVED " Invincibility Component", entity, true, [&]()
 					{
 						auto& invincibilityComponent = entity.Get<InvincibilityComponent>();
@@ -0,0 +1,103 @@
+#include "Panels/ProfilerPanel.h"
+#include "Scene/Scene.h"
+#include "Project/Project.h"
+
+#include <imgui.h>
+#include <IconsFontAwesome7.h>
+
+namespace Luden
+{
+	void ProfilerPanel::RenderContent()
+	{
+		ImGuiIO& io = ImGui::GetIO();
+		ImGui::Text("Frame: %.2f ms (%.0f FPS)", 1000.0f / io.Framerate, io.Framerate);
+
+		std::shared_ptr<ResourceManagerBase> resourceManager = Project::GetResourceManager();
+		const ResourceCacheStats* cacheStats = resourceManager ? resourceManager->GetCacheStats() : nullptr;
+		if (cacheStats && ImGui::CollapsingHeader(ICON_FA_MEMORY " Resources", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			constexpr float megabyte = 1024.0f * 1024.0f;
+
+			if (cacheStats->BudgetBytes > 0)
+				ImGui::Text("Resident: %.1f / %.1f MB", cacheStats->ResidentBytes / megabyte, cacheStats->BudgetBytes / megabyte);
+			else
+				ImGui::Text("Resident: %.1f MB", cacheStats->ResidentBytes / megabyte);
+
+			ImGui::Text("Loaded: %u (%u pinned)", cacheStats->ResidentCount, cacheStats->PinnedCount);
+			ImGui::Text("Hits: %llu  Misses: %llu", (unsigned long long)cacheStats->Hits, (unsigned long long)cacheStats->Misses);
+			ImGui::Text("Evictions: %llu", (unsigned long long)cacheStats->Evictions);
+			ImGui::Separator();
+
+			for (uint32_t type = 1; type < ResourceTypeCount; type++)
+			{
+				if (cacheStats->ResidentBytesByType[type] == 0)
+					continue;
+
+				ImGui::Text("%s: %.1f MB", Utils::ResourceTypeToString((ResourceType)type), cacheStats->ResidentBytesByType[type] / megabyte);
+			}
+		}
+
+		if (ImGui::CollapsingHeader(ICON_FA_STOPWATCH " Scene Load Benchmark"))
+		{
+			if (ImGui::Button("50k entities"))
+				m_SceneLoadResult = SceneBinarySerializer::RunLoadBenchmark(50000, 3);
+
+			if (m_SceneLoadResult.IterationCount > 0)
+			{
+				ImGui::Text("%u entities, %.1f MB binary", m_SceneLoadResult.EntityCount, m_SceneLoadResult.BinarySize / (1024.0f * 1024.0f));
+				ImGui::Text("Binary: %.2f ms", m_SceneLoadResult.BinaryLoadTime);
+				ImGui::Text("JSON: %.2f ms", m_SceneLoadResult.JsonLoadTime);
+			}
+		}
+
+		if (m_Context == nullptr)
+			return;
+
+		auto& physics = m_Context->GetPhysicsManager();
+
+		if (ImGui::CollapsingHeader(ICON_FA_GEAR " Physics Step", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			int subStepCount = physics.GetSubStepCount();
+			if (ImGui::SliderInt("Sub-steps", &subStepCount, 1, 8))
+				physics.SetSubStepCount(subStepCount);
+
+			bool continuous = physics.IsContinuousEnabled();
+			if (ImGui::Checkbox("Continuous Collision", &continuous))
+				physics.SetContinuousEnabled(continuous);
+		}
+
+		if (ImGui::CollapsingHeader(ICON_FA_GAUGE " Physics Stats", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			const PhysicsStepStats& stats = physics.GetStepStats();
+
+			ImGui::Text("Step: %.3f ms", stats.StepTime);
+			ImGui::Text("Collide: %.3f ms", stats.CollideTime);
+			ImGui::Text("Solve: %.3f ms", stats.SolveTime);
+			ImGui::Text("Bullet TOI: %.3f ms", stats.BulletTime);
+			ImGui::Separator();
+			ImGui::Text("Sub-steps: %d", stats.SubStepCount);
+			ImGui::Text("Bodies: %d (%d moved)", stats.BodyCount, stats.MovedBodyCount);
+			ImGui::Text("Contacts: %d", stats.ContactCount);
+			ImGui::Text("TOI sweeps: %d", stats.BulletBodyCount);
+		}
+
+		if (ImGui::CollapsingHeader(ICON_FA_STOPWATCH " Physics Benchmark"))
+		{
+			// 5 seconds of simulation in a standalone world, blocks the editor while it runs
+			constexpr uint32_t stepCount = 300;
+
+			if (ImGui::Button("5k bodies"))
+				m_BenchmarkResult = Physics2DManager::RunStepBenchmark(5000, stepCount, physics.GetSubStepCount());
+			ImGui::SameLine();
+			if (ImGui::Button("20k bodies"))
+				m_BenchmarkResult = Physics2DManager::RunStepBenchmark(20000, stepCount, physics.GetSubStepCount());
+
+			if (m_BenchmarkResult.StepCount > 0)
+			{
+				ImGui::Text("%u bodies, %u steps, %d workers", m_BenchmarkResult.BodyCount, m_BenchmarkResult.StepCount, m_BenchmarkResult.WorkerCount);
+				ImGui::Text("Step: %.3f ms (max %.3f ms)", m_BenchmarkResult.AverageStepTime, m_BenchmarkResult.MaxStepTime);
+				ImGui::Text("Solve: %.3f ms", m_BenchmarkResult.AverageSolveTime);
+			}
+		}
+	}
+}
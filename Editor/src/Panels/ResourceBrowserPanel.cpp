@@ -439,6 +439,76 @@ namespace Luden
 
 		ImGui::SameLine();
 
+		if (ImGui::Button(ICON_FA_TABLE_CELLS " New Tileset"))
+		{
+			ImGui::OpenPopup("CreateTilesetDialog");
+		}
+
+		if (ImGui::BeginPopupModal("CreateTilesetDialog", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+		{
+			static char tilesetName[256] = "";
+			// UI
+			ImGui::InputText("Tileset Name", tilesetName, sizeof(tilesetName));
+
+			if (tilesetName[0] != '\0')
+			{
+				if (ImGui::Button("Create"))
+				{
+					std::string fileName = std::string(tilesetName) + ".ltileset";
+					Project::GetEditorResourceManager()->CreateResource(ResourceType::Tileset, m_CurrentDirectory / fileName);
+
+					tilesetName[0] = '\0';
+					ImGui::CloseCurrentPopup();
+				}
+			}
+
+			ImGui::SameLine();
+
+			if (ImGui::Button("Cancel"))
+			{
+				ImGui::CloseCurrentPopup();
+			}
+
+			ImGui::EndPopup();
+		}
+
+		ImGui::SameLine();
+
+		if (ImGui::Button(ICON_FA_WAND_MAGIC_SPARKLES " New Particle Emitter"))
+		{
+			ImGui::OpenPopup("CreateParticleEmitterDialog");
+		}
+
+		if (ImGui::BeginPopupModal("CreateParticleEmitterDialog", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+		{
+			static char emitterName[256] = "";
+			// UI
+			ImGui::InputText("Particle Emitter Name", emitterName, sizeof(emitterName));
+
+			if (emitterName[0] != '\0')
+			{
+				if (ImGui::Button("Create"))
+				{
+					std::string fileName = std::string(emitterName) + ".lparticle";
+					Project::GetEditorResourceManager()->CreateResource(ResourceType::ParticleEmitter, m_CurrentDirectory / fileName);
+
+					emitterName[0] = '\0';
+					ImGui::CloseCurrentPopup();
+				}
+			}
+
+			ImGui::SameLine();
+
+			if (ImGui::Button("Cancel"))
+			{
+				ImGui::CloseCurrentPopup();
+			}
+
+			ImGui::EndPopup();
+		}
+
+		ImGui::SameLine();
+
 		if (ImGui::Button(ICON_FA_CUBE " New Prefab"))
 		{
 			ImGui::OpenPopup("CreatePrefabDialog");
@@ -540,6 +610,16 @@ namespace Luden
 				m_SelectedFilter = ResourceType::Sprite;
 			}
 
+			if (ImGui::Selectable("Tileset", m_SelectedFilter == ResourceType::Tileset))
+			{
+				m_SelectedFilter = ResourceType::Tileset;
+			}
+
+			if (ImGui::Selectable("Particle Emitter", m_SelectedFilter == ResourceType::ParticleEmitter))
+			{
+				m_SelectedFilter = ResourceType::ParticleEmitter;
+			}
+
 			ImGui::EndCombo();
 		}
 	}
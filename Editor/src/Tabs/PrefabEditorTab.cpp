@@ -85,7 +85,7 @@ namespace Luden
 
 				if (m_PrefabScene)
 				{
-					m_PrefabScene->OnUpdateEditor(0.016f, m_RenderTexture, m_EditorCamera);
+					m_PrefabScene->OnUpdateEditor(0.016f, *m_RenderTexture, m_EditorCamera);
 				}
 
 				ImGui::Image(*m_RenderTexture);
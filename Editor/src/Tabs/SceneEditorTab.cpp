@@ -127,6 +127,7 @@ namespace Luden
 		m_ResourceBrowserPanel.OnImGuiRender();
 		m_DebugSettingsPanel.OnImGuiRender();
 		m_CollisionChannelPanel.OnImGuiRender();
+		m_ProfilerPanel.OnImGuiRender();
 
 		if (m_Appearing)
 		{ 
@@ -211,6 +212,10 @@ namespace Luden
 
 					m_ViewportBounds[0] = { imageMin.x, imageMin.y };
 					m_ViewportBounds[1] = { imageMin.x + displaySize.x, imageMin.y + displaySize.y };
+
+					// Scripts map the mouse through the letterboxed image, not the whole panel
+					ImVec2 mainViewportPos = ImGui::GetMainViewport()->Pos;
+					GEngine.SetViewportBounds({ imageMin.x - mainViewportPos.x, imageMin.y - mainViewportPos.y }, { displaySize.x, displaySize.y });
 				}
 				else
 				{
@@ -484,6 +489,7 @@ namespace Luden
 		m_ResourceBrowserPanel.DockTo(dockDown);
 		m_DebugSettingsPanel.DockTo(dockRight);
 		m_CollisionChannelPanel.DockTo(dockLeft);
+		m_ProfilerPanel.DockTo(dockDown);
 
 		ImGui::DockBuilderFinish(dockSpaceMainID);
 		m_Appearing = true;
@@ -513,10 +519,10 @@ namespace Luden
 
 		switch (m_SceneState) {
 		case SceneState::Edit:
-			m_ActiveScene->OnUpdateEditor(timestep, m_RenderTexture, m_EditorCamera);
+			m_ActiveScene->OnUpdateEditor(timestep, *m_RenderTexture, m_EditorCamera);
 			break;
 		case SceneState::Play:
-			m_ActiveScene->OnUpdateRuntime(timestep, m_RenderTexture);
+			m_ActiveScene->OnUpdateRuntime(timestep, *m_RenderTexture);
 			break;
 		}
 
@@ -566,6 +572,7 @@ namespace Luden
 		m_ToolbarPanel.SetContext(m_ActiveScene, &m_SceneHierarchyPanel, &m_EditorCamera);
 		m_InspectorPanel.SetContext(m_ActiveScene, &m_SceneHierarchyPanel, m_EditorApplication);
 		m_ResourceBrowserPanel.SetContext(m_EditorApplication);
+		m_ProfilerPanel.SetContext(m_ActiveScene);
 		m_Appearing = true;
 	}
 
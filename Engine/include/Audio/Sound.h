@@ -43,6 +43,8 @@ namespace Luden
 
 		static ResourceType GetStaticType() { return ResourceType::Sound; }
 		virtual ResourceType GetResourceType() const override { return GetStaticType(); }
+
+		virtual uint64_t GetMemorySize() const override { return m_SoundBuffer.getSampleCount() * sizeof(int16_t); }
 	private:
 		std::filesystem::path m_FilePath;
 		sf::SoundBuffer m_SoundBuffer;
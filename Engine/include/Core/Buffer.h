@@ -104,6 +104,41 @@ namespace Luden {
 		inline uint64_t GetSize() const { return Size; }
 	};
 
+	// Read-only view into memory owned by someone else, e.g. a mapped resource pack
+	struct BufferView
+	{
+		const void* Data = nullptr;
+		uint64_t Size = 0;
+
+		BufferView() = default;
+
+		BufferView(const void* data, uint64_t size)
+			: Data(data), Size(size) {
+		}
+
+		BufferView(const Buffer& buffer)
+			: Data(buffer.Data), Size(buffer.Size) {
+		}
+
+		BufferView SubView(uint64_t offset, uint64_t size) const
+		{
+			return BufferView((const uint8_t*)Data + offset, size);
+		}
+
+		operator bool() const
+		{
+			return (bool)Data;
+		}
+
+		template<typename T>
+		const T* As() const
+		{
+			return (const T*)Data;
+		}
+
+		inline uint64_t GetSize() const { return Size; }
+	};
+
 	struct BufferSafe : public Buffer
 	{
 		~BufferSafe()
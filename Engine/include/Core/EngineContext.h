@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Core/JobSystem.h"
 
 #include <glm/glm.hpp>
 
@@ -50,6 +51,8 @@ namespace Luden
 		glm::vec2 GetViewportPosition() const { return m_ViewportPosition; }
 		glm::vec2 GetViewportSize() const { return m_ViewportSize; }
 
+		JobSystem& GetJobSystem() { return m_JobSystem; }
+
 		EngineContext(const EngineContext&) = delete;
 		EngineContext& operator =(EngineContext&) = delete;
 
@@ -67,6 +70,8 @@ namespace Luden
 
 		sf::RenderWindow* m_Window = nullptr;
 		sf::RenderTexture* m_RenderTexture = nullptr;
+
+		JobSystem m_JobSystem;
 	};
 
 	#define GEngine EngineContext::Instance()
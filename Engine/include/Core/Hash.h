@@ -0,0 +1,22 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "Core/Buffer.h"
+
+#include <cstdint>
+
+namespace Luden
+{
+	// Non-cryptographic 64 bit hashing (XXH64), used to tell whether build inputs and outputs changed
+	class ENGINE_API Hash
+	{
+	public:
+		static uint64_t Bytes(const void* data, uint64_t size, uint64_t seed = 0);
+		static uint64_t Bytes(BufferView data, uint64_t seed = 0) { return Bytes(data.Data, data.Size, seed); }
+
+		static uint64_t Combine(uint64_t seed, uint64_t value)
+		{
+			return seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 12) + (seed >> 4));
+		}
+	};
+}
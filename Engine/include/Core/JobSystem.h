@@ -0,0 +1,85 @@
+#pragma once
+
+#include "EngineAPI.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Luden
+{
+	// Tracks a group of submitted jobs, JobSystem::Wait returns once all of them have run
+	struct ENGINE_API JobCounter
+	{
+		std::atomic<uint32_t> Pending = 0;
+
+		bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+	};
+
+	// Work-stealing thread pool shared by the engine systems (physics solver, particles...).
+	// Every worker owns a queue: it pops its own jobs from the back and steals from the front of the others when idle.
+	// The thread that called Init owns worker index 0 and runs queued jobs while it waits instead of blocking.
+	// Other threads can submit and wait, but never run jobs of the pool, so a job never shares its worker index.
+	class ENGINE_API JobSystem
+	{
+	public:
+		using Job = std::function<void()>;
+
+		JobSystem() = default;
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		// 0 uses one thread per hardware core, the calling thread included. maxThreadCount caps it, 0 for no cap
+		void Init(uint32_t threadCount = 0, uint32_t maxThreadCount = 0);
+		void Shutdown();
+
+		// Runs the job inline when the pool is not running
+		void Submit(Job job, JobCounter* counter = nullptr);
+		void Wait(JobCounter& counter);
+
+		// Splits [0, count) into ranges of at least minRange items and runs them across the workers
+		void ParallelFor(uint32_t count, uint32_t minRange, const std::function<void(uint32_t, uint32_t)>& func);
+
+		bool IsRunning() const { return m_Running.load(std::memory_order_acquire); }
+
+		// Threads that can run jobs, the owning thread included. Worker indices are in [0, GetWorkerCount())
+		uint32_t GetWorkerCount() const { return m_Queues.empty() ? 1 : (uint32_t)m_Queues.size(); }
+
+		// Index of the worker running the current job, 0 outside of the workers
+		static uint32_t GetCurrentWorkerIndex();
+	private:
+		struct QueuedJob
+		{
+			Job Function;
+			JobCounter* Counter = nullptr;
+		};
+
+		struct WorkQueue
+		{
+			std::mutex Mutex;
+			std::deque<QueuedJob> Jobs;
+		};
+
+		void WorkerLoop(uint32_t workerIndex);
+		bool TryRunJob(uint32_t workerIndex);
+		bool PopJob(uint32_t workerIndex, QueuedJob& outJob);
+	private:
+		std::vector<std::unique_ptr<WorkQueue>> m_Queues;
+		std::vector<std::thread> m_Threads;
+
+		std::atomic<uint32_t> m_QueuedJobs = 0;
+		std::atomic<uint32_t> m_NextQueue = 0;
+		std::atomic<bool> m_Running = false;
+		std::thread::id m_OwnerThread;
+
+		std::mutex m_WakeMutex;
+		std::condition_variable m_WakeCondition;
+	};
+}
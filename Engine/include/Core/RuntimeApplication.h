@@ -5,6 +5,7 @@
 #include "Resource/ResourceManager.h"
 #include "Project/Project.h"
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/System/Clock.hpp>
 #include <memory>
@@ -12,12 +13,20 @@
 
 namespace Luden {
 
+	enum class PresentMode
+	{
+		Direct,		// The scene renders straight into the window, letterboxed by the view
+		Offscreen	// The scene renders into a texture first, for post-processing or resolution scaling
+	};
+
 	struct ENGINE_API ApplicationSpecification
 	{
 		std::string Name = "Luden Runtime";
-		uint32_t WindowWidth = 1920;
+		uint32_t WindowWidth = 1920; // Also the game resolution, kept when the window is resized
 		uint32_t WindowHeight = 1080;
 		bool VSync = true;
+		PresentMode Presentation = PresentMode::Direct;
+		float RenderScale = 1.0f; // Offscreen only, size of the offscreen texture relative to the game resolution
 		std::string WorkingDirectory;
 		std::filesystem::path ProjectPath;
 	};
@@ -48,13 +57,18 @@ namespace Luden {
 
 		virtual void OnUpdate(TimeStep ts);
 
+		// Offscreen only, lets the project set a shader on the blit of the scene texture to the window
+		virtual void OnPostProcess(sf::RenderStates& states) {}
+
+		sf::FloatRect CalculateLetterbox(const sf::Vector2u& windowSize) const;
+
 	protected:
 		std::shared_ptr<EditorResourceManager> m_ResourceManager;
 		std::shared_ptr<Scene> m_CurrentScene;
 		std::string m_CurrentSceneName;
 		ApplicationSpecification m_Specification;
 		std::unique_ptr<sf::RenderWindow> m_Window;
-		std::shared_ptr<sf::RenderTexture> m_RenderTexture;  
+		std::shared_ptr<sf::RenderTexture> m_RenderTexture; // Only created in PresentMode::Offscreen
 		std::unique_ptr<NativeScriptModuleLoader> m_NativeScriptModuleLoader;
 		sf::Clock m_Clock;
 		bool m_Running = true;
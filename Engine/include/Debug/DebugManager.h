@@ -3,10 +3,13 @@
 	#include "EngineAPI.h"
 
 	#include <memory>
+	#include <vector>
 
 	#include <glm/vec3.hpp>
 	#include <SFML/Graphics/Color.hpp>
-	#include "SFML/Graphics/RenderTexture.hpp"
+	#include <SFML/Graphics/RenderTarget.hpp>
+	#include <SFML/Graphics/Vertex.hpp>
+	#include <SFML/Graphics/VertexBuffer.hpp>
 	#include <box2d/box2d.h>
 
 	namespace Luden
@@ -56,7 +59,20 @@
 			sf::Color color;
 			float duration;
 			float timeRemaining;
-			bool rendered = false;
+			bool filled = false;
+		};
+
+		// Vertex streams of the debug geometry, lines and filled triangles are drawn with one call each
+		struct ENGINE_API DebugGeometry
+		{
+			std::vector<sf::Vertex> lines;
+			std::vector<sf::Vertex> triangles;
+
+			void Clear()
+			{
+				lines.clear();
+				triangles.clear();
+			}
 		};
 
 		class ENGINE_API DebugManager
@@ -71,15 +87,21 @@
 			DebugManager(const DebugManager&) = delete;
 			DebugManager& operator =(const DebugManager&) = delete;
 
+			// Pass as duration to keep the shape until ClearPersistent(), it is tessellated and uploaded only once
+			static constexpr float Persistent = -1.0f;
+
 			void DrawLine(const glm::vec3& start, const glm::vec3& end, const sf::Color& color, float duration);
 
 			void DrawCircle(const glm::vec3& center, float radius, const sf::Color& color, float duration);
+			void DrawSolidCircle(const glm::vec3& center, float radius, const sf::Color& color, float duration);
 
 			void DrawBox(const glm::vec3& center, const glm::vec3& extent, const sf::Color& color, float duration);
+			void DrawSolidBox(const glm::vec3& center, const glm::vec3& extent, const sf::Color& color, float duration);
 
 			void Update(float deltaTime);
-			void Render(std::shared_ptr<sf::RenderTexture> target);
+			void Render(sf::RenderTarget& target);
 			void Clear();
+			void ClearPersistent();
 
 			Box2DDebugConfig& GetDebugConfig() { return m_DebugConfig; }
 
@@ -101,10 +123,23 @@
 			static sf::Color ConvertColor(b2HexColor color);
 			static glm::vec3 TransformB2Point(const b2Vec2& point, const Box2DDebugContext* ctx);
 
+			void Submit(const DebugDrawCommand& cmd);
+
+			static void AppendCommand(DebugGeometry& geometry, const DebugDrawCommand& cmd);
+			static void AppendLine(DebugGeometry& geometry, const sf::Vector2f& p1, const sf::Vector2f& p2, const sf::Color& color);
+			static void AppendCircle(DebugGeometry& geometry, const sf::Vector2f& center, float radius, const sf::Color& color, bool filled);
+			static void AppendPolygon(DebugGeometry& geometry, const sf::Vector2f* points, int count, const sf::Color& color, bool filled);
+
 		private:
 			DebugManager() = default;
 
-			std::vector<DebugDrawCommand> m_Commands;
+			std::vector<DebugDrawCommand> m_TimedCommands;
+			DebugGeometry m_FrameGeometry; // Single frame shapes and Box2D output, cleared after every Render
+			DebugGeometry m_PersistentGeometry;
+
+			sf::VertexBuffer m_PersistentLines{ sf::PrimitiveType::Lines, sf::VertexBuffer::Usage::Static };
+			sf::VertexBuffer m_PersistentTriangles{ sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static };
+			bool m_PersistentDirty = false;
 
 			Box2DDebugConfig m_DebugConfig;
 			Box2DDebugContext m_B2DebugContext;
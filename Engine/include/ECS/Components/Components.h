@@ -9,9 +9,14 @@
 #include "Input/InputAction.h"
 #include "Input/InputTypes.h"
 #include "Render/Camera2D.h"
+#include "Physics2D/CollisionEvent.h"
 
 #include <glm/vec2.hpp>
 #include <box2d/box2d.h>
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <vector>
 #include "glm/ext/vector_float3.hpp"
 #include "SFML/Graphics/Color.hpp"
 
@@ -101,6 +106,7 @@ namespace Luden
 		float LinearDrag = 0.01f;
 		float AngularDrag = 0.05f;
 		float GravityScale = 1.0f;
+		bool IsBullet = false; // Swept against dynamic bodies too, for fast projectiles
 		b2BodyId RuntimeBodyId = b2_nullBodyId;
 
 		RigidBody2DComponent() = default;
@@ -126,6 +132,9 @@ namespace Luden
 		uint16_t MaskBits = 0x00FF;
 		uint16_t GroupIndex = 0;
 
+		uint8_t CollisionEvents = (uint8_t)CollisionEvent::All;
+		bool IsSensor = false; // Detects overlaps without colliding, reported as trigger events
+
 		BoxCollider2DComponent() = default;
 		BoxCollider2DComponent(const BoxCollider2DComponent& other) = default;
 	};
@@ -145,10 +154,83 @@ namespace Luden
 		uint16_t MaskBits = 0x00FF;
 		uint16_t GroupIndex = 0;
 
+		uint8_t CollisionEvents = (uint8_t)CollisionEvent::All;
+		bool IsSensor = false;
+
 		CircleCollider2DComponent() = default;
 		CircleCollider2DComponent(const CircleCollider2DComponent& other) = default;
 	};
 
+	struct ENGINE_API CapsuleCollider2DComponent : public IComponent
+	{
+		glm::vec2 Offset = { 0.0f,0.0f };
+		float Height = 1.0f; // Total length, caps included
+		float Radius = 0.25f;
+		bool Horizontal = false;
+
+		float Density = 1.0f;
+		float Friction = 1.0f;
+		float Restitution = 0.0f;
+
+		b2ShapeId RuntimeShapeId = b2_nullShapeId;
+
+		uint16_t CategoryBits = 0x0001;
+		uint16_t MaskBits = 0x00FF;
+		uint16_t GroupIndex = 0;
+
+		uint8_t CollisionEvents = (uint8_t)CollisionEvent::All;
+		bool IsSensor = false;
+
+		CapsuleCollider2DComponent() = default;
+		CapsuleCollider2DComponent(const CapsuleCollider2DComponent& other) = default;
+	};
+
+	// Convex hull of Points, at most B2_MAX_POLYGON_VERTICES of them are used
+	struct ENGINE_API PolygonCollider2DComponent : public IComponent
+	{
+		glm::vec2 Offset = { 0.0f,0.0f };
+		std::vector<glm::vec2> Points = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.0f, 0.5f } };
+		float Radius = 0.0f; // Rounds the corners
+
+		float Density = 1.0f;
+		float Friction = 1.0f;
+		float Restitution = 0.0f;
+
+		b2ShapeId RuntimeShapeId = b2_nullShapeId;
+
+		uint16_t CategoryBits = 0x0001;
+		uint16_t MaskBits = 0x00FF;
+		uint16_t GroupIndex = 0;
+
+		uint8_t CollisionEvents = (uint8_t)CollisionEvent::All;
+		bool IsSensor = false;
+
+		PolygonCollider2DComponent() = default;
+		PolygonCollider2DComponent(const PolygonCollider2DComponent& other) = default;
+	};
+
+	// Level outlines in the same local space as collider offsets. From 4 points up it is a Box2D chain: one-sided,
+	// colliding on the right of each segment (a counter-clockwise loop is solid inside), and smooth across the joints.
+	// Fewer points become two-sided segments.
+	struct ENGINE_API ChainCollider2DComponent : public IComponent
+	{
+		std::vector<glm::vec2> Points = { { -0.5f, 0.0f }, { 0.5f, 0.0f } };
+		bool Loop = false;
+
+		float Friction = 1.0f;
+		float Restitution = 0.0f;
+
+		b2ChainId RuntimeChainId = b2_nullChainId;
+		std::vector<b2ShapeId> RuntimeSegmentIds;
+
+		uint16_t CategoryBits = 0x0001;
+		uint16_t MaskBits = 0x00FF;
+		uint16_t GroupIndex = 0;
+
+		ChainCollider2DComponent() = default;
+		ChainCollider2DComponent(const ChainCollider2DComponent& other) = default;
+	};
+
 	class ScriptableEntity;
 	class Entity;
 
@@ -162,6 +244,7 @@ namespace Luden
 	{
 		ScriptableEntity* Instance = nullptr;
 		ResourceHandle ScriptHandle = 0;
+		uint8_t CollisionEvents = (uint8_t)CollisionEvent::None; // Read from the instance when it is created
 
 		ScriptInstantiateFunc InstantiateScript = nullptr;
 		ScriptDestroyFunc DestroyScript = nullptr;
@@ -293,6 +376,67 @@ namespace Luden
 		}
 	};
 
+	struct ENGINE_API TilemapChunk
+	{
+		static constexpr int32_t Size = 32;
+
+		// 0 = empty, otherwise tileset index + 1
+		std::array<uint16_t, Size * Size> Tiles{};
+		uint32_t Revision = 0;
+		uint32_t TileCount = 0;
+	};
+
+	struct ENGINE_API TilemapComponent : public IComponent
+	{
+		ResourceHandle TilesetHandle = 0;
+		sf::Color Tint = sf::Color::White;
+
+		bool GenerateColliders = true;
+		float Friction = 1.0f;
+		float Restitution = 0.0f;
+		uint16_t CategoryBits = 0x0001;
+		uint16_t MaskBits = 0x00FF;
+
+		std::map<uint64_t, TilemapChunk> Chunks; // ChunkKey->TilemapChunk
+
+		// Bumped on every edit, used to know when the colliders must be rebuilt
+		uint32_t Revision = 0;
+		uint32_t RuntimeColliderRevision = 0;
+		b2BodyId RuntimeBodyId = b2_nullBodyId;
+
+		// Chains of each chunk, rebuilt when the chunk or one of its neighbours changes
+		struct ChunkCollider
+		{
+			uint32_t Revision = 0;
+			std::vector<b2ChainId> Chains;
+		};
+		std::unordered_map<uint64_t, ChunkCollider> RuntimeChunkColliders; // ChunkKey->ChunkCollider
+
+		TilemapComponent() = default;
+		TilemapComponent(const TilemapComponent& other) = default;
+
+		uint16_t GetTile(int32_t x, int32_t y) const;
+		void SetTile(int32_t x, int32_t y, uint16_t tile);
+		void Fill(int32_t x, int32_t y, int32_t width, int32_t height, uint16_t tile);
+		void Clear();
+
+		bool GetBounds(int32_t& outMinX, int32_t& outMinY, int32_t& outMaxX, int32_t& outMaxY) const;
+
+		static uint64_t ChunkKey(int32_t chunkX, int32_t chunkY) { return ((uint64_t)(uint32_t)chunkX << 32) | (uint32_t)chunkY; }
+		static int32_t ChunkKeyX(uint64_t key) { return (int32_t)(uint32_t)(key >> 32); }
+		static int32_t ChunkKeyY(uint64_t key) { return (int32_t)(uint32_t)(key & 0xFFFFFFFF); }
+	};
+
+	struct ENGINE_API ParticleEmitterComponent : public IComponent
+	{
+		ResourceHandle EmitterHandle = 0;
+		bool Playing = true;
+		float SimulationSpeed = 1.0f;
+
+		ParticleEmitterComponent() = default;
+		ParticleEmitterComponent(const ParticleEmitterComponent& other) = default;
+	};
+
 	struct ENGINE_API InvincibilityComponent : public IComponent
 	{
 	public:
@@ -346,6 +490,15 @@ namespace Luden
 		glm::vec3 Scale = { 1.0f, 1.0f, 1.0f };
 		float angle = 0;
 
+		// Set when physics moved the entity during the last step, cleared on the next one
+		bool Dirty = false;
+
+		// Pose drawn this frame, blended between the last two physics steps. Translation and angle keep the
+		// simulated pose that scripts and snapshots read
+		glm::vec2 RenderTranslation = { 0.0f, 0.0f };
+		float RenderAngle = 0.0f;
+		bool Interpolated = false;
+
 		TransformComponent() = default;
 
 		explicit TransformComponent(const glm::vec3& t) : Translation(t) {}
@@ -37,6 +37,7 @@ namespace Luden
 
 		EntityMap& GetEntityMap();
 		const EntityVec& GetEntityVec();
+		const EntityVec& GetPendingEntities() const { return m_EntitiesToAdd; }
 
 		void Clear();
 
@@ -20,6 +20,10 @@ namespace Luden
 	using PoolIndex = std::size_t;
 	using EntityID = UUID;
 
+	// Pool slot in the low 32 bits and the low 32 bits of the entity UUID in the high ones, so it fits in a pointer
+	// sized user data field. A handle whose entity was destroyed, or whose slot was reused, resolves to 0.
+	using EntityHandle = uint64_t;
+
 	using EntityComponentVectorTuple = std::tuple<
 		std::vector<Luden::RelationshipComponent>,
 		std::vector<Luden::DamageComponent>,
@@ -32,11 +36,16 @@ namespace Luden
 		std::vector<Luden::RigidBody2DComponent>,
 		std::vector<Luden::BoxCollider2DComponent>,
 		std::vector<Luden::CircleCollider2DComponent>,
+		std::vector<Luden::CapsuleCollider2DComponent>,
+		std::vector<Luden::PolygonCollider2DComponent>,
+		std::vector<Luden::ChainCollider2DComponent>,
 		std::vector<Luden::PrefabComponent>,
 		std::vector<Luden::NativeScriptComponent>,
 		std::vector<Luden::SpriteAnimatorComponent>,
 		std::vector<Luden::TextComponent>,
 		std::vector<Luden::SpriteRendererComponent>,
+		std::vector<Luden::TilemapComponent>,
+		std::vector<Luden::ParticleEmitterComponent>,
 		std::vector<Luden::LifespanComponent>,
 		std::vector<Luden::InvincibilityComponent>,
 		std::vector<Luden::PatrolComponent>,
@@ -66,6 +75,9 @@ namespace Luden
 		bool IsActive(const EntityID& entityID) const;
 		bool Exists(const EntityID& entityID) const;
 
+		EntityHandle GetHandle(const EntityID& entityID) const;
+		EntityID ResolveHandle(EntityHandle handle) const;
+
 		template <typename T>
 		T& GetComponent(const EntityID& entityID)
 		{
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "Resource/Resource.h"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+
+namespace Luden
+{
+	// Describes how an emitter spawns particles and how they evolve over their lifetime.
+	// Shared by every ParticleEmitterComponent that references it; the live particles belong to the scene's ParticleSystem.
+	class ENGINE_API ParticleEmitter : public Resource
+	{
+	public:
+		ParticleEmitter() = default;
+		~ParticleEmitter() = default;
+
+		static ResourceType GetStaticType() { return ResourceType::ParticleEmitter; }
+		virtual ResourceType GetResourceType() const override { return GetStaticType(); }
+
+	public:
+		ResourceHandle SpriteHandle = 0; // 0 draws untextured quads
+
+		uint32_t MaxParticles = 1000;
+		float EmissionRate = 50.0f; // Particles per second
+		uint32_t BurstCount = 0; // Emitted at once when the emitter starts
+		float Duration = 0.0f; // Seconds, 0 emits forever
+		bool Looping = true;
+		bool WorldSpace = true; // Particles stay where they were spawned when the entity moves
+
+		float LifetimeMin = 1.0f;
+		float LifetimeMax = 1.0f;
+		float SpeedMin = 50.0f;
+		float SpeedMax = 100.0f;
+		float Direction = 0.0f; // Degrees
+		float Spread = 360.0f; // Degrees
+		sf::Vector2f Gravity = { 0.0f, 0.0f };
+		float Drag = 0.0f;
+
+		sf::Color StartColor = sf::Color::White;
+		sf::Color EndColor = sf::Color(255, 255, 255, 0);
+		float StartSize = 8.0f;
+		float EndSize = 0.0f;
+	};
+}
@@ -1,9 +1,15 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Core/Buffer.h"
 #include "Resource/Resource.h"
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Texture.hpp>
 
+#include <optional>
+#include <vector>
+
 namespace Luden
 {
 	class ENGINE_API Texture : public Resource
@@ -17,9 +23,47 @@ namespace Luden
 
 		void SetTexture(const sf::Texture& texture) { m_Texture = texture; }
 
+		// Pixels decoded off the main thread, UploadPendingImage creates the texture from them on the main thread
+		void SetPendingImage(sf::Image image) { m_PendingImage = std::move(image); }
+		bool UploadPendingImage();
+
+		// Raw RGBA8 rows, uploaded a stripe at a time by UploadPendingRows or all at once by UploadPendingImage.
+		// The view is not copied, its memory must stay valid until the last row is uploaded
+		void SetPendingPixels(sf::Vector2u size, std::vector<uint8_t> pixels);
+		void SetPendingPixels(sf::Vector2u size, BufferView pixels);
+		bool HasPendingRows() const { return m_PendingView.Data != nullptr; }
+
+		// Uploads about maxBytes of the pending rows, at least one row, and returns how many bytes it uploaded
+		uint64_t UploadPendingRows(uint64_t maxBytes);
+
+		// Set from the pack's texture header
+		void SetGenerateMipmap(bool generateMipmap) { m_GenerateMipmap = generateMipmap; }
+		bool GeneratesMipmap() const { return m_GenerateMipmap; }
+
+		void SetPremultipliedAlpha(bool premultipliedAlpha) { m_PremultipliedAlpha = premultipliedAlpha; }
+		bool HasPremultipliedAlpha() const { return m_PremultipliedAlpha; }
+
+		// Premultiplied pixels are blended with One instead of SrcAlpha, tints must be premultiplied as well
+		const sf::BlendMode& GetBlendMode() const;
+
 		static ResourceType GetStaticType() { return ResourceType::Texture; }
 		virtual ResourceType GetResourceType() const override { return GetStaticType(); }
+
+		// RGBA8 on the GPU
+		virtual uint64_t GetMemorySize() const override { return (uint64_t)m_Texture.getSize().x * m_Texture.getSize().y * 4; }
+	private:
+		void ReleasePendingPixels();
 	private:
 		sf::Texture m_Texture;
+		std::optional<sf::Image> m_PendingImage;
+
+		std::vector<uint8_t> m_PendingPixels; // Owned pixels, empty when the view points into a mapped pack
+		BufferView m_PendingView;
+		sf::Vector2u m_PendingSize;
+		uint32_t m_UploadedRows = 0;
+		bool m_UploadFailed = false;
+
+		bool m_GenerateMipmap = false;
+		bool m_PremultipliedAlpha = false;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "Resource/Resource.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <memory>
+#include <unordered_set>
+
+namespace Luden
+{
+	class Texture;
+
+	// A grid of equally sized tiles cut from a single texture.
+	// Tile indices start at 0; tilemaps store index + 1 so that 0 can mean "empty".
+	class ENGINE_API Tileset : public Resource
+	{
+	public:
+		Tileset() = default;
+		~Tileset() = default;
+
+		ResourceHandle GetTextureHandle() const { return m_TextureHandle; }
+		void SetTextureHandle(ResourceHandle handle) { m_TextureHandle = handle; }
+
+		std::shared_ptr<Texture> GetTexture();
+
+		const sf::Vector2u& GetTileSize() const { return m_TileSize; }
+		void SetTileSize(const sf::Vector2u& tileSize) { m_TileSize = tileSize; }
+
+		uint32_t GetColumns() const { return m_Columns; }
+		void SetColumns(uint32_t columns) { m_Columns = columns; }
+
+		uint32_t GetTileCount() const { return m_TileCount; }
+		void SetTileCount(uint32_t tileCount) { m_TileCount = tileCount; }
+
+		uint32_t GetMargin() const { return m_Margin; }
+		void SetMargin(uint32_t margin) { m_Margin = margin; }
+
+		uint32_t GetSpacing() const { return m_Spacing; }
+		void SetSpacing(uint32_t spacing) { m_Spacing = spacing; }
+
+		sf::IntRect GetTileRect(uint32_t tileIndex) const;
+
+		bool IsTileSolid(uint32_t tileIndex) const { return m_SolidTiles.find(tileIndex) != m_SolidTiles.end(); }
+		void SetTileSolid(uint32_t tileIndex, bool solid);
+		const std::unordered_set<uint32_t>& GetSolidTiles() const { return m_SolidTiles; }
+
+		static ResourceType GetStaticType() { return ResourceType::Tileset; }
+		virtual ResourceType GetResourceType() const override { return GetStaticType(); }
+
+	private:
+		ResourceHandle m_TextureHandle = 0;
+		sf::Vector2u m_TileSize = { 16, 16 };
+		uint32_t m_Columns = 1;
+		uint32_t m_TileCount = 0;
+		uint32_t m_Margin = 0;
+		uint32_t m_Spacing = 0;
+
+		std::unordered_set<uint32_t> m_SolidTiles;
+	};
+}
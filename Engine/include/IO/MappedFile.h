@@ -0,0 +1,35 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "Core/Buffer.h"
+
+#include <filesystem>
+
+namespace Luden
+{
+	// Read-only memory mapping of a whole file. Views into it stay valid until the file is closed
+	class ENGINE_API MappedFile
+	{
+	public:
+		MappedFile() = default;
+		MappedFile(const std::filesystem::path& path);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+
+		bool Open(const std::filesystem::path& path);
+		void Close();
+
+		bool IsOpen() const { return m_Data != nullptr; }
+		uint64_t GetSize() const { return m_Size; }
+		BufferView GetView() const { return BufferView(m_Data, m_Size); }
+
+	private:
+		const void* m_Data = nullptr;
+		uint64_t m_Size = 0;
+#ifdef _WIN32
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+#endif
+	};
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "IO/StreamWriter.h"
+#include "IO/StreamReader.h"
+#include "Core/Buffer.h"
+
+#include <vector>
+
+namespace Luden
+{
+	//==============================================================================
+	/// MemoryStreamWriter
+	// Appends to a caller owned vector, reusing its capacity when the same vector is written every frame
+	class ENGINE_API MemoryStreamWriter : public StreamWriter
+	{
+	public:
+		MemoryStreamWriter(std::vector<uint8_t>& buffer);
+		MemoryStreamWriter(const MemoryStreamWriter&) = delete;
+		virtual ~MemoryStreamWriter() = default;
+
+		bool IsStreamGood() const final { return true; }
+		uint64_t GetStreamPosition() final { return m_Position; }
+		void SetStreamPosition(uint64_t position) final { m_Position = position; }
+		bool WriteData(const char* data, size_t size) final;
+
+	private:
+		std::vector<uint8_t>& m_Buffer;
+		uint64_t m_Position = 0;
+	};
+
+	//==============================================================================
+	/// MemoryStreamReader
+	// Reads from memory it does not own, buffers can be read as views into it
+	class ENGINE_API MemoryStreamReader : public StreamReader
+	{
+	public:
+		MemoryStreamReader(BufferView buffer);
+		MemoryStreamReader(const MemoryStreamReader&) = delete;
+		virtual ~MemoryStreamReader() = default;
+
+		bool IsStreamGood() const final { return m_Good; }
+		uint64_t GetStreamPosition() override { return m_Position; }
+		void SetStreamPosition(uint64_t position) override { m_Position = position; }
+		bool ReadData(char* destination, size_t size) override;
+		bool ReadBufferView(BufferView& outView) override;
+
+	private:
+		BufferView m_Buffer;
+		uint64_t m_Position = 0;
+		bool m_Good = true;
+	};
+
+}
@@ -1,13 +1,15 @@
 #pragma once
 
+#include "EngineAPI.h"
 #include "Core/Buffer.h"
 #include <map>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 namespace Luden
 {
-	class StreamReader
+	class ENGINE_API StreamReader
 	{
 	public:
 		virtual ~StreamReader() = default;
@@ -20,6 +22,10 @@ namespace Luden
 		operator bool() const { return IsStreamGood(); }
 
 		void ReadBuffer(Buffer& buffer, uint32_t size = 0);
+
+		// Points outView at the next size-prefixed buffer instead of copying it.
+		// Only readers over memory that outlives the view support this
+		virtual bool ReadBufferView(BufferView& outView) { return false; }
 		void ReadString(std::string& string);
 
 		template<typename T>
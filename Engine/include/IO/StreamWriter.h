@@ -1,14 +1,16 @@
 #pragma once
 
+#include "EngineAPI.h"
 #include "Core/Buffer.h"
 
 #include <string>
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 namespace Luden
 {
-	class StreamWriter
+	class ENGINE_API StreamWriter
 	{
 	public:
 		virtual ~StreamWriter() = default;
@@ -3,6 +3,8 @@
 #include "Core/TimeStep.h"
 #include "ECS/Entity.h"
 #include "EngineAPI.h"
+#include "IO/StreamReader.h"
+#include "IO/StreamWriter.h"
 #include "Luden.h"
 #include "Resource/ResourceManager.h"  
 #include "Project/Project.h"  
@@ -40,19 +42,11 @@
 			template<typename T>
 			std::shared_ptr<T> GetResource(const std::string& name)
 			{
-				auto handles = ResourceManager::template GetAllResourcesWithType<T>();
+				ResourceHandle handle = ResourceManager::template FindResourceByName<T>(name);
+				if (handle == 0)
+					return nullptr;
 
-				for (auto handle : handles)
-				{
-					const auto& metadata = Project::GetEditorResourceManager()->GetMetadata(handle);
-					std::string filename = Utils::RemoveExtension(metadata.FilePath.filename().string());
-
-					if (Utils::String::EqualsIgnoreCase(filename, name))
-					{
-						return ResourceManager::template GetResource<T>(handle);
-					}
-				}
-				return nullptr;
+				return ResourceManager::template GetResource<T>(handle);
 			}
 
 			Entity GetEntity() { return m_Entity; }
@@ -60,12 +54,26 @@
 			//Life cycle
 			virtual void OnCreate() {}
 			virtual void OnUpdate(TimeStep ts) {}
+			virtual void OnFixedUpdate(TimeStep ts) {} // Runs at the scene's fixed tick rate, before the physics step
 			virtual void OnDestroy() {}
 
 			//Physics2D
 			virtual void OnCollisionBegin(const CollisionContact& contact) {}
 			virtual void OnCollisionEnd(const CollisionContact& contact) {}
 			virtual void OnCollisionHit(const CollisionContact& contact) {}
+
+			// A sensor collider and another shape started or stopped overlapping, called on both entities
+			virtual void OnTriggerBegin(const CollisionContact& contact) {}
+			virtual void OnTriggerEnd(const CollisionContact& contact) {}
+
+			// Collision callbacks this script handles, the others are never generated for its shapes
+			virtual uint8_t GetCollisionEvents() const { return (uint8_t)CollisionEvent::All; }
+
+			//Snapshots
+			// Gameplay state the script keeps in its own members, written into scene snapshots for replays and rollback.
+			// OnLoadState must read back exactly what OnSaveState wrote.
+			virtual void OnSaveState(StreamWriter& writer) {}
+			virtual void OnLoadState(StreamReader& reader) {}
 		private:
 			Entity m_Entity;
 			friend struct NativeScriptComponent;
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Luden
+{
+	// Collision callbacks a script or collider wants. Shapes only ask Box2D for the events
+	// both their collider and their entity's script are interested in.
+	enum class CollisionEvent : uint8_t
+	{
+		None = 0,
+		Begin = 1 << 0,
+		End = 1 << 1,
+		Hit = 1 << 2,
+		TriggerBegin = 1 << 3, // A sensor and another shape started overlapping, reported to both entities
+		TriggerEnd = 1 << 4,
+		All = Begin | End | Hit | TriggerBegin | TriggerEnd
+	};
+
+	inline uint8_t operator|(CollisionEvent a, CollisionEvent b) { return (uint8_t)a | (uint8_t)b; }
+	inline bool HasCollisionEvent(uint8_t events, CollisionEvent event) { return (events & (uint8_t)event) != 0; }
+}
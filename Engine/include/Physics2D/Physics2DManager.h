@@ -1,18 +1,69 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Core/JobSystem.h"
 #include "Core/TimeStep.h"
+#include "Core/UUID.h"
+#include "ECS/Entity.h"
+#include "Physics2D/CollisionContact.h"
+#include "Physics2D/CollisionEvent.h"
+#include "Resource/Resource.h"
 
 #include <box2d/box2d.h>
+#include <glm/vec2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <vector>
 
 namespace Luden
 {
 	class Scene;
-	class Entity;
+	class ScriptableEntity;
+	class Tileset;
+
+	// Simulation state of a body in physics space, enough to resume stepping from it
+	struct PhysicsBodyState
+	{
+		b2Vec2 Position;
+		b2Rot Rotation;
+		b2Vec2 LinearVelocity;
+		float AngularVelocity;
+		uint8_t Awake;
+	};
+
+	// Cost of the last world step, times in milliseconds
+	struct PhysicsStepStats
+	{
+		float StepTime = 0.0f;
+		float CollideTime = 0.0f;
+		float SolveTime = 0.0f;
+		float BulletTime = 0.0f; // Time of impact sweeps of the bullet bodies
+		int SubStepCount = 0;
+		int BodyCount = 0;
+		int ContactCount = 0;
+		int MovedBodyCount = 0;
+		int BulletBodyCount = 0; // Moved bullets, each got a time of impact sweep
+	};
+
+	// Wall-clock cost of Physics2DManager::RunStepBenchmark, times in milliseconds
+	struct PhysicsBenchmarkResult
+	{
+		uint32_t BodyCount = 0;
+		uint32_t StepCount = 0;
+		int WorkerCount = 0;
+		float AverageStepTime = 0.0f;
+		float MaxStepTime = 0.0f;
+		float AverageSolveTime = 0.0f;
+	};
 
 	class ENGINE_API Physics2DManager
 	{
 	public:
+		// Box2D indexes its per-worker scratch with the job system worker index, the pool must not outgrow it
+		static constexpr uint32_t MaxWorkerCount = B2_MAX_WORKERS;
+
 		Physics2DManager() = default;
 
 		Physics2DManager(const Physics2DManager&) = delete;
@@ -22,11 +73,16 @@ namespace Luden
 		void Update(TimeStep ts);
 		void Shutdown();
 
+		// Queues the body of entity, bodies are created in a batch before the next step
 		void RegisterEntity(Entity entity);
 		void UnregisterEntity(Entity entity);
 
+		// Applies edits of the physics components of entity to its live body and shapes
 		void UpdateEntityPhysics(Entity entity);
 
+		// Re-reads the collision events the entity's colliders and script want, after its script was created
+		void UpdateCollisionEvents(Entity entity);
+
 		b2WorldId GetPhysicsWorldId() { return m_PhysicsWorldId; }
 		void SetPhysicsWorldId(b2WorldId physicsWorldId) { m_PhysicsWorldId = physicsWorldId; }
 
@@ -36,14 +92,96 @@ namespace Luden
 		b2Vec2 GetGravity() { return m_Gravity; }
 		void SetGravity(b2Vec2 gravity);
 
-		int GetSubStepCount() { return m_SubStepCount; }
-		void SetSubStepCount(int subStepCount) { m_SubStepCount = subStepCount; }
+		int GetSubStepCount() const { return m_SubStepCount; }
+		void SetSubStepCount(int subStepCount) { m_SubStepCount = std::max(subStepCount, 1); }
+
+		// Continuous collision of dynamic bodies against static ones. Bullets also sweep against dynamic bodies,
+		// so fast projectiles don't need a higher sub-step count for the whole world
+		bool IsContinuousEnabled() const { return m_ContinuousEnabled; }
+		void SetContinuousEnabled(bool enabled);
+
+		const PhysicsStepStats& GetStepStats() const { return m_StepStats; }
 
 		uint32_t GetViewportWidth() const { return m_ViewportWidth; }
 		uint32_t GetViewportHeight() const { return m_ViewportHeight; }
+
+		// Entities whose body moved during the last step
+		const std::vector<UUID>& GetMovedEntities() const { return m_MovedEntities; }
+
+		// Blends the render pose of moving bodies between the last two steps, alpha in [0, 1]
+		void InterpolateTransforms(float alpha);
+		// Bodies are drawn at their simulated pose until they move again
+		void ResetInterpolation();
+
+		// Used by scene snapshots. Restoring also moves the transform and stops blending it from the old position
+		bool SaveBodyState(Entity entity, PhysicsBodyState& outState) const;
+		void RestoreBodyState(Entity entity, const PhysicsBodyState& state);
+
+		// Steps a standalone world of bodyCount boxes falling into a pile, on the engine job system like the scene worlds
+		static PhysicsBenchmarkResult RunStepBenchmark(uint32_t bodyCount, uint32_t stepCount, int subStepCount);
 	private:
+		// Body and shape definitions in local space, shared by every instance of a prefab
+		struct BodyTemplate
+		{
+			b2BodyDef BodyDef;
+			glm::vec2 Scale = { 1.0f, 1.0f };
+			Entity Source; // Entity the definitions were built from, the prefab root for cached templates
+
+			bool HasBox = false;
+			b2Polygon Box;
+			b2ShapeDef BoxShapeDef;
+
+			bool HasCircle = false;
+			b2Circle Circle;
+			b2ShapeDef CircleShapeDef;
+
+			bool HasCapsule = false;
+			b2Capsule Capsule;
+			b2ShapeDef CapsuleShapeDef;
+
+			bool HasPolygon = false;
+			b2Polygon Polygon;
+			b2ShapeDef PolygonShapeDef;
+		};
+
+		void FlushPendingBodies();
+		const BodyTemplate& GetBodyTemplate(Entity entity, BodyTemplate& scratch);
+		BodyTemplate BuildBodyTemplate(Entity source, glm::vec2 scale) const;
+		void CreateBody(Entity entity, const BodyTemplate& bodyTemplate);
+
+		static void ApplyBodyProperties(const RigidBody2DComponent& rb2d, b2BodyDef& bodyDef);
+		b2Polygon MakeBoxGeometry(const BoxCollider2DComponent& bc2d, glm::vec2 scale) const;
+		b2Circle MakeCircleGeometry(const CircleCollider2DComponent& cc2d, glm::vec2 scale) const;
+		b2Capsule MakeCapsuleGeometry(const CapsuleCollider2DComponent& cc2d, glm::vec2 scale) const;
+		bool MakePolygonGeometry(const PolygonCollider2DComponent& pc2d, glm::vec2 scale, b2Polygon& outPolygon) const;
+
+		// Chains are rebuilt from their points, they cannot be patched in place
+		void CreateChainShapes(Entity entity, b2BodyId bodyId);
+		static void DestroyChainShapes(ChainCollider2DComponent& chain);
+
+		void SyncMovedBodies();
+		void StopInterpolation(const UUID& entityID);
 		void ProcessContactEvents();
 
+		static bool WantsCollisionEvent(Entity entity, CollisionEvent event);
+		static ScriptableEntity* GetLiveScript(Entity entity);
+		static uint8_t GetShapeCollisionEvents(Entity entity, uint8_t colliderEvents);
+		static void ApplyCollisionEvents(b2ShapeDef& shapeDef, uint8_t events);
+		static bool EnablesSensorEvents(bool isSensor, uint8_t colliderEvents);
+		glm::vec2 ToWorldPoint(b2Vec2 point) const;
+
+		void CreateTilemapBody(Entity entity);
+		void DestroyTilemapBody(Entity entity);
+		void UpdateTilemapBody(Entity entity);
+		void CreateTilemapChunkChains(Entity entity, const Tileset& tileset, uint64_t chunkKey);
+
+		// Body and shape user data hold the compact EntityHandle so contacts resolve without scanning the scene
+		static void* MakeUserData(const UUID& entityID);
+
+		// Box2D task callbacks, run the solver stages on the engine job system
+		static void* EnqueueTask(b2TaskCallback* task, int itemCount, int minRange, void* taskContext, void* userContext);
+		static void FinishTask(void* userTask, void* userContext);
+
 	private:
 		Scene* m_Scene;
 
@@ -55,5 +193,44 @@ namespace Luden
 		float m_PhysicsScale = 100.0f; // 1 meter = 100 pixel
 		b2Vec2 m_Gravity = { 0.0f, -10.0f };
 		int m_SubStepCount = 4;
+		bool m_ContinuousEnabled = true;
+
+		PhysicsStepStats m_StepStats;
+
+		std::vector<UUID> m_MovedEntities;
+
+		std::vector<Entity> m_PendingBodies;
+
+		struct CollisionDispatch
+		{
+			CollisionDispatch(Entity target) : Target(target) {}
+
+			Entity Target;
+			CollisionContact Contact;
+		};
+
+		// Callbacks of the last step per event type, only for scripts that asked for them
+		std::vector<CollisionDispatch> m_BeginDispatch;
+		std::vector<CollisionDispatch> m_EndDispatch;
+		std::vector<CollisionDispatch> m_HitDispatch;
+		std::vector<CollisionDispatch> m_TriggerBeginDispatch;
+		std::vector<CollisionDispatch> m_TriggerEndDispatch;
+		std::unordered_map<ResourceHandle, BodyTemplate> m_PrefabTemplates; // PrefabHandle->BodyTemplate
+
+		struct BodyInterpolation
+		{
+			glm::vec2 PreviousPosition;
+			glm::vec2 CurrentPosition;
+			float PreviousAngle;
+			float CurrentAngle;
+			uint64_t LastStep;
+		};
+
+		std::unordered_map<UUID, BodyInterpolation> m_Interpolation; // Bodies that moved during the last step
+		uint64_t m_StepIndex = 0;
+
+		static constexpr int s_MaxTasks = 128; // Box2D enqueues a handful of tasks per step
+		std::array<JobCounter, s_MaxTasks> m_TaskCounters;
+		int m_TaskCount = 0;
 	};
 }
\ No newline at end of file
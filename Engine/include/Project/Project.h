@@ -23,6 +23,16 @@ namespace Luden
 		std::string ProjectDirectory;
 
 		ResourceHandle StartSceneHandle;
+
+		// Runtime resource cache budget in bytes, 0 = unlimited
+		uint64_t ResourceMemoryBudget = 512ull << 20;
+
+		// Textures go into the pack as RGBA8 pixels instead of their source files, larger but nothing to decode on load
+		bool PackDecodedTextures = true;
+
+		// Texture import settings, written into every texture of the pack
+		bool GenerateTextureMipmaps = false;
+		bool PremultiplyTextureAlpha = false; // Avoids dark fringes around filtered transparent edges
 	};
 
 	class ENGINE_API Project
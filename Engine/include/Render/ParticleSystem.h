@@ -0,0 +1,80 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "Core/UUID.h"
+#include "Resource/Resource.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace Luden
+{
+	struct ParticleEmitterComponent;
+	class ParticleEmitter;
+
+	// Simulates the particles of every ParticleEmitterComponent in a scene.
+	// Particles are kept in structure-of-arrays buffers so the per-frame update is a few flat float loops the compiler
+	// can vectorize, and each emitter is drawn as a single triangle batch. Emitters with many live particles split the
+	// update and vertex generation across the engine job system.
+	class ENGINE_API ParticleSystem
+	{
+	public:
+		void BeginFrame();
+		void Update(UUID entityID, const ParticleEmitterComponent& component, const sf::Transform& transform, float deltaTime);
+		void EndFrame();
+
+		void Render(UUID entityID, const sf::Transform& transform, sf::RenderTarget& target);
+
+		// Spawns count extra particles on the next update, whether or not the emitter is playing
+		void Emit(UUID entityID, uint32_t count);
+		void Reset(UUID entityID);
+		void Clear();
+
+		uint32_t GetLiveParticleCount() const;
+	private:
+		struct ParticleBuffer
+		{
+			std::vector<float> PositionX;
+			std::vector<float> PositionY;
+			std::vector<float> VelocityX;
+			std::vector<float> VelocityY;
+			std::vector<float> Age; // Normalized, the particle dies at 1
+			std::vector<float> InvLifetime;
+			uint32_t Count = 0;
+
+			void SetCapacity(uint32_t capacity);
+			void Kill(uint32_t index);
+		};
+
+		struct EmitterInstance
+		{
+			ParticleBuffer Particles;
+			std::vector<sf::Vertex> Vertices;
+
+			ResourceHandle EmitterHandle = 0;
+			float Time = 0.0f;
+			float EmissionAccumulator = 0.0f;
+			uint32_t PendingParticles = 0;
+			uint32_t RandomState = 0x9E3779B9;
+			sf::Vector2f LastOrigin;
+			bool Started = false;
+			bool Finished = false;
+			uint64_t LastFrame = 0;
+		};
+
+		static void ResetInstance(EmitterInstance& instance);
+		static void Spawn(EmitterInstance& instance, const ParticleEmitter& emitter, const sf::Transform& transform, uint32_t count);
+		static void Integrate(ParticleBuffer& particles, const ParticleEmitter& emitter, float deltaTime, uint32_t begin, uint32_t end);
+		static void WriteVertices(EmitterInstance& instance, const ParticleEmitter& emitter, const sf::FloatRect& textureRect, bool premultipliedAlpha, uint32_t begin, uint32_t end);
+	private:
+		std::unordered_map<UUID, EmitterInstance> m_Instances;
+		uint64_t m_Frame = 0;
+
+		static constexpr uint32_t s_ParallelThreshold = 16384; // Minimum particles per job
+	};
+}
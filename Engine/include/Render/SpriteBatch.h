@@ -0,0 +1,39 @@
+#pragma once
+
+#include "EngineAPI.h"
+
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+namespace Luden
+{
+	// Collects textured quads and submits them in as few draw calls as possible.
+	// A new draw call is only issued when the texture or blend mode changes, so sprites packed into
+	// the same atlas page are drawn together.
+	class ENGINE_API SpriteBatch
+	{
+	public:
+		SpriteBatch();
+
+		void Begin(sf::RenderTarget& target);
+		void Draw(const sf::Texture& texture, const sf::IntRect& textureRect, const sf::Vector2f& origin, const sf::Color& color, const sf::Transform& transform, const sf::BlendMode& blendMode = sf::BlendAlpha);
+		void Flush();
+		void End();
+
+		uint32_t GetDrawCallCount() const { return m_DrawCallCount; }
+		uint32_t GetQuadCount() const { return m_QuadCount; }
+	private:
+		sf::RenderTarget* m_Target = nullptr;
+		const sf::Texture* m_Texture = nullptr;
+		sf::BlendMode m_BlendMode = sf::BlendAlpha;
+		sf::VertexArray m_Vertices;
+
+		uint32_t m_DrawCallCount = 0;
+		uint32_t m_QuadCount = 0;
+	};
+}
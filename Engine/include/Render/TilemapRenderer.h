@@ -0,0 +1,58 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "Core/UUID.h"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace Luden
+{
+	struct TilemapComponent;
+	class Tileset;
+
+	// Bakes tilemap chunks into static vertex buffers and draws the ones visible by the current view.
+	// A chunk is only rebuilt when its revision changes, so an untouched level costs one draw per visible chunk.
+	class ENGINE_API TilemapRenderer
+	{
+	public:
+		void BeginFrame();
+		void Render(UUID entityID, const TilemapComponent& tilemap, const sf::Transform& transform, sf::RenderTarget& target);
+		void EndFrame();
+
+		void Clear();
+
+		uint32_t GetDrawCallCount() const { return m_DrawCallCount; }
+		uint32_t GetRebuiltChunkCount() const { return m_RebuiltChunkCount; }
+	private:
+		struct ChunkCache
+		{
+			sf::VertexBuffer Buffer{ sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static };
+			std::vector<sf::Vertex> Vertices; // Only kept when vertex buffers are not supported
+			uint32_t Revision = 0;
+			uint64_t TilesetHandle = 0;
+			sf::Color Tint;
+			bool Valid = false;
+		};
+
+		struct TilemapCache
+		{
+			std::unordered_map<uint64_t, ChunkCache> Chunks; // ChunkKey->ChunkCache
+			uint64_t LastFrame = 0;
+		};
+
+		void BuildChunk(ChunkCache& cache, int32_t chunkX, int32_t chunkY, const TilemapComponent& tilemap, const Tileset& tileset);
+	private:
+		std::unordered_map<UUID, TilemapCache> m_Caches;
+		std::vector<sf::Vertex> m_ScratchVertices;
+
+		uint64_t m_Frame = 0;
+		uint32_t m_DrawCallCount = 0;
+		uint32_t m_RebuiltChunkCount = 0;
+	};
+}
@@ -30,6 +30,7 @@ namespace Luden
 		virtual void RegisterDependency(ResourceHandle resourceHandle, ResourceHandle dependency) override;
 
 		virtual std::unordered_set<ResourceHandle> GetAllResourcesWithType(ResourceType type) override;
+		virtual ResourceHandle FindResourceByName(ResourceType type, std::string_view name) override { return m_ResourceRegistry.FindByName(type, name); }
 		virtual std::unordered_map<ResourceHandle, std::shared_ptr<Resource>>& GetLoadedResources() override { return m_LoadedResources; }
 
 		// ------------- Editor-only ----------------
@@ -20,12 +20,15 @@ namespace Luden
 
 		virtual ~Resource() {}
 
-		const std::string& GetName() { return m_Name; }
+		const std::string& GetName() const { return m_Name; }
 		void SetName(const std::string& name) { m_Name = name; }
 
 		static ResourceType GetStaticResourceType() { return ResourceType::None; }
 		virtual ResourceType GetResourceType() const { return ResourceType::None; }
 
+		// Memory kept resident once loaded (pixels, samples...), 0 when the type does not know it
+		virtual uint64_t GetMemorySize() const { return 0; }
+
 		virtual void OnDependencyUpdated(ResourceHandle handle) {}
 
 		virtual bool operator ==(const Resource& other) const
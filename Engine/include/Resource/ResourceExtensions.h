@@ -14,6 +14,8 @@ namespace Luden
 		{".lprefab", ResourceType::Prefab},
 		{".lns", ResourceType::NativeScript},
 		{".lsprite", ResourceType::Sprite},
+		{".ltileset", ResourceType::Tileset},
+		{".lparticle", ResourceType::ParticleEmitter},
 
 
 		//Textures
@@ -18,9 +18,15 @@ namespace Luden
 		static void Serialize(const std::shared_ptr<Resource>& resource);
 		static bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource);
 
-		static bool SerializeToResourcePack(ResourceHandle resourceHandle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo);
-		static std::shared_ptr<Resource> DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo);
-		static std::shared_ptr<Scene> DeserializeSceneFromResourcePack(FileStreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo);
+		static bool SerializeToResourcePack(ResourceHandle resourceHandle, StreamWriter& stream, ResourceSerializationInfo& outInfo);
+		static bool SerializeFileToResourcePack(ResourceType type, const std::filesystem::path& path, StreamWriter& stream, ResourceSerializationInfo& outInfo);
+		static std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo);
+		static std::shared_ptr<Scene> DeserializeSceneFromResourcePack(StreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo);
+		static bool CanDeserializeAsync(ResourceType type);
+		static bool FinalizeResource(const std::shared_ptr<Resource>& resource);
+		static bool FinalizeResourceStep(const std::shared_ptr<Resource>& resource, uint64_t& budgetBytes);
+		static bool SerializeSpriteToResourcePack(const Sprite& sprite, StreamWriter& stream, ResourceSerializationInfo& outInfo);
+		static bool SerializeTextureImageToResourcePack(const sf::Image& image, StreamWriter& stream, ResourceSerializationInfo& outInfo);
 
 		static std::shared_ptr<Resource> CreateResource(ResourceType type, const std::string& name);
 	private:
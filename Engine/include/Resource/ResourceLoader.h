@@ -0,0 +1,100 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "Resource/Resource.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Luden
+{
+	enum class ResourceLoadState : uint8_t
+	{
+		Pending = 0,
+		Ready,
+		Failed
+	};
+
+	// One in-flight load, shared by the loader and every future waiting on it
+	struct ENGINE_API ResourceLoadRequest
+	{
+		ResourceHandle Handle = 0;
+		std::atomic<ResourceLoadState> State = ResourceLoadState::Pending;
+
+		// Decoded by a loader thread, only read by the main thread once the request is finished
+		std::shared_ptr<Resource> Result;
+
+		void Finish(std::shared_ptr<Resource> resource);
+	};
+
+	class ENGINE_API ResourceFuture
+	{
+	public:
+		ResourceFuture() = default;
+		ResourceFuture(std::shared_ptr<ResourceLoadRequest> request) : m_Request(std::move(request)) {}
+
+		// Already finished, for resources that were loaded synchronously
+		static ResourceFuture MakeFinished(ResourceHandle handle, std::shared_ptr<Resource> resource);
+
+		ResourceHandle GetHandle() const { return m_Request ? m_Request->Handle : ResourceHandle(0); }
+		ResourceLoadState GetState() const { return m_Request ? m_Request->State.load(std::memory_order_acquire) : ResourceLoadState::Failed; }
+
+		bool IsPending() const { return GetState() == ResourceLoadState::Pending; }
+		bool IsReady() const { return GetState() == ResourceLoadState::Ready; }
+		bool IsFailed() const { return GetState() == ResourceLoadState::Failed; }
+
+		std::shared_ptr<Resource> Get() const { return IsReady() ? m_Request->Result : nullptr; }
+
+		template<typename T>
+		std::shared_ptr<T> As() const { return std::dynamic_pointer_cast<T>(Get()); }
+	private:
+		std::shared_ptr<ResourceLoadRequest> m_Request;
+	};
+
+	// Background pool that reads and decodes resources. Decoded requests are handed back to the main thread,
+	// which finalizes them (GPU uploads) and publishes the result to the futures
+	class ENGINE_API ResourceLoader
+	{
+	public:
+		using DecodeFunction = std::function<std::shared_ptr<Resource>(ResourceHandle)>;
+
+		ResourceLoader() = default;
+		~ResourceLoader();
+
+		ResourceLoader(const ResourceLoader&) = delete;
+		ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+		// Disk reads and image decodes dominate, a couple of threads keep the disk busy
+		void Init(DecodeFunction decode, uint32_t threadCount = 2);
+		void Shutdown();
+
+		// Queues the handle unless it is already in flight
+		ResourceFuture Load(ResourceHandle handle);
+
+		// Moves the requests the threads finished decoding to outDecoded, the caller must finish them through Finish.
+		// They stay in flight until then, so loading the handle again shares the request
+		void TakeDecoded(std::vector<std::shared_ptr<ResourceLoadRequest>>& outDecoded);
+		void Finish(const std::shared_ptr<ResourceLoadRequest>& request, std::shared_ptr<Resource> resource);
+
+		bool IsRunning() const { return !m_Threads.empty(); }
+	private:
+		void WorkerLoop();
+	private:
+		DecodeFunction m_Decode;
+		std::vector<std::thread> m_Threads;
+		bool m_Running = false;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_WakeCondition;
+		std::deque<std::shared_ptr<ResourceLoadRequest>> m_Queue;
+		std::vector<std::shared_ptr<ResourceLoadRequest>> m_Decoded;
+		std::unordered_map<ResourceHandle, std::shared_ptr<ResourceLoadRequest>> m_InFlight; // Until finished, main thread only
+	};
+}
@@ -4,6 +4,7 @@
 #include "EngineAPI.h"
 #include "Project/Project.h"
 #include "Resource/Resource.h"
+#include "Resource/ResourceLoader.h"
 
 #include <unordered_map>
 #include <unordered_set>
@@ -25,8 +26,12 @@ namespace Luden
 
 		static ResourceType GetResourceType(ResourceHandle resourceHandle) { return Project::GetResourceManager()->GetResourceType(resourceHandle); }
  
-		//TODO
-		//static std::shared_ptr<Resource> GetPlaceholderResource(ResourceType type);
+		// Drawn while the real resource streams in, null for types without one
+		static std::shared_ptr<Resource> GetPlaceholderResource(ResourceType type);
+
+		static ResourceFuture GetResourceAsync(ResourceHandle handle) { return Project::GetResourceManager()->GetResourceAsync(handle); }
+		static void PrefetchScene(ResourceHandle sceneHandle) { Project::GetResourceManager()->PrefetchScene(sceneHandle); }
+		static void Update() { Project::GetResourceManager()->Update(); }
 
 		template<typename T>
 		static std::shared_ptr<T> GetResource(ResourceHandle handle)
@@ -38,12 +43,32 @@ namespace Luden
 			return typed;
 		}
 
+		// For render paths: never blocks on a load, returns the placeholder until the resource is ready
+		template<typename T>
+		static std::shared_ptr<T> GetResourceOrPlaceholder(ResourceHandle handle)
+		{
+			ResourceFuture future = GetResourceAsync(handle);
+			if (future.IsReady())
+				return future.As<T>();
+
+			if (future.IsFailed())
+				return nullptr;
+
+			return std::static_pointer_cast<T>(GetPlaceholderResource(T::GetStaticType()));
+		}
+
 		template<typename T>
 		static std::unordered_set<ResourceHandle> GetAllResourcesWithType()
 		{
 			return Project::GetResourceManager()->GetAllResourcesWithType(T::GetStaticType());
 		}
 
+		template<typename T>
+		static ResourceHandle FindResourceByName(std::string_view name)
+		{
+			return Project::GetResourceManager()->FindResourceByName(T::GetStaticType(), name);
+		}
+
 		static const std::unordered_map<ResourceHandle, std::shared_ptr<Resource>>& GetLoadedResources() { return Project::GetResourceManager()->GetLoadedResources(); }
 
 
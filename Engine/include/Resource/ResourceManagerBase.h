@@ -1,16 +1,32 @@
 #pragma once
 
+#include <array>
+#include <string_view>
 #include <unordered_set>
 #include <unordered_map>
 
 #include "EngineAPI.h"
 #include "Resource/Resource.h"
+#include "Resource/ResourceLoader.h"
 #include "Resource/ResourceMetadata.h"
 
 namespace Luden 
 {
 	using ResourceMap = std::unordered_map<ResourceHandle, std::shared_ptr<Resource>>;
 
+	// Memory and lookups of a manager that keeps its loaded resources within a budget
+	struct ResourceCacheStats
+	{
+		uint64_t ResidentBytes = 0;
+		uint64_t BudgetBytes = 0; // 0 when unlimited
+		std::array<uint64_t, ResourceTypeCount> ResidentBytesByType = {};
+		uint32_t ResidentCount = 0;
+		uint32_t PinnedCount = 0;
+		uint64_t Hits = 0;
+		uint64_t Misses = 0;
+		uint64_t Evictions = 0;
+	};
+
 	class ENGINE_API ResourceManagerBase
 	{
 	public:
@@ -22,6 +38,13 @@ namespace Luden
 		virtual ResourceType GetResourceType(ResourceHandle resourceHandle) = 0;
 		virtual std::shared_ptr<Resource> GetResource(ResourceHandle resourceHandle) = 0;
 
+		// Managers without background loading finish the load right away
+		virtual ResourceFuture GetResourceAsync(ResourceHandle resourceHandle) { return ResourceFuture::MakeFinished(resourceHandle, GetResource(resourceHandle)); }
+		virtual void PrefetchScene(ResourceHandle sceneHandle) {}
+
+		// Called once per frame on the main thread, finishes the background loads
+		virtual void Update() {}
+
 		virtual bool ReloadData(ResourceHandle resourceHandle) = 0;
 		virtual bool EnsureCurrent(ResourceHandle resourceHandle) = 0;
 		virtual bool EnsureAllLoadedCurrent() = 0;
@@ -34,6 +57,12 @@ namespace Luden
 		virtual void RegisterDependency(ResourceHandle resourceHandle, ResourceHandle dependency) = 0;
 
 		virtual std::unordered_set<ResourceHandle> GetAllResourcesWithType(ResourceType type) = 0;
+
+		// Case-insensitive lookup by file name without extension, 0 when there is no such resource
+		virtual ResourceHandle FindResourceByName(ResourceType type, std::string_view name) = 0;
 		virtual std::unordered_map<ResourceHandle, std::shared_ptr<Resource>>& GetLoadedResources() = 0;
+
+		// Null when the manager does not track the memory of its resources
+		virtual const ResourceCacheStats* GetCacheStats() const { return nullptr; }
 	};
 }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "Resource/Resource.h"
+
+#include <array>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Luden
+{
+	// Case-insensitive resource name->handle, one table per type. A resource's name is its file name without the extension
+	class ENGINE_API ResourceNameIndex
+	{
+	public:
+		// The first resource added under a name keeps it
+		void Add(ResourceType type, std::string_view name, ResourceHandle resourceHandle);
+		// Returns true when resourceHandle was the one indexed under the name
+		bool Remove(ResourceType type, std::string_view name, ResourceHandle resourceHandle);
+		void Clear();
+
+		// 0 when no resource of that type has the name
+		ResourceHandle Find(ResourceType type, std::string_view name) const;
+
+		static std::string GetResourceName(const std::filesystem::path& filePath);
+	private:
+		// Case-insensitive and transparent, so lookups hash the caller's string_view without building a lowered copy
+		struct NameHash
+		{
+			using is_transparent = void;
+			size_t operator()(std::string_view name) const;
+		};
+
+		struct NameEqual
+		{
+			using is_transparent = void;
+			bool operator()(std::string_view a, std::string_view b) const;
+		};
+	private:
+		std::array<std::unordered_map<std::string, ResourceHandle, NameHash, NameEqual>, ResourceTypeCount> m_Handles;
+	};
+}
@@ -1,5 +1,6 @@
 #include "EngineAPI.h"
 #include "Resource/ResourceMetadata.h"
+#include "Resource/ResourceNameIndex.h"
 
 
 #include <unordered_map>
@@ -17,11 +18,17 @@ namespace Luden
 		size_t Remove(const ResourceHandle& resourceHandle);
 		void Clear();
 
+		// 0 when no resource of the type is named like that, see ResourceNameIndex
+		ResourceHandle FindByName(ResourceType type, std::string_view name) const { return m_NameIndex.Find(type, name); }
+
 		auto begin() { return m_ResourceRegistry.begin(); }
 		auto end() { return m_ResourceRegistry.end(); }
 		auto begin() const { return m_ResourceRegistry.cbegin(); }
 		auto end() const { return m_ResourceRegistry.cend(); }
+	private:
+		void RemoveName(const ResourceMetadata& metadata);
 	private:
 		std::unordered_map<ResourceHandle, ResourceMetadata> m_ResourceRegistry;
+		ResourceNameIndex m_NameIndex;
 	};
 }
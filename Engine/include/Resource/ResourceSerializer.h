@@ -5,11 +5,18 @@
 #include "Resource/ResourceMetadata.h"
 #include "Serialization/ResourcePackFile.h"
 
+#include <filesystem>
 #include <memory>
 
+namespace sf
+{
+	class Image;
+}
+
 namespace Luden
 {
 	class Scene;
+	class Sprite;
 
 	struct ENGINE_API ResourceSerializationInfo
 	{
@@ -23,8 +30,19 @@ namespace Luden
 		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const = 0;
 		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const = 0;
 
-		virtual bool SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const = 0;
-		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const = 0;
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const = 0;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const = 0;
+
+		// Types packed from their source file. Takes the resolved path so the pack builder's workers never query the editor
+		virtual bool SerializeFileToResourcePack(const std::filesystem::path& path, StreamWriter& stream, ResourceSerializationInfo& outInfo) const { return false; }
+
+		// DeserializeFromResourcePack may run on a loader thread when this is true, FinalizeResource always runs on the main thread
+		virtual bool CanDeserializeAsync() const { return true; }
+		virtual bool FinalizeResource(const std::shared_ptr<Resource>& resource) const { return true; }
+
+		// Main thread work that can be spread over frames before FinalizeResource. Does about budgetBytes of it, takes
+		// what it did off the budget and returns false while some is left
+		virtual bool FinalizeResourceStep(const std::shared_ptr<Resource>& resource, uint64_t& budgetBytes) const { return true; }
 	};
 
 	class ENGINE_API TextureSerializer : public ResourceSerializer
@@ -33,8 +51,12 @@ namespace Luden
 		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const override {}
 		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const override;
 
-		virtual bool SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const;
-		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const;
+		virtual bool SerializeFileToResourcePack(const std::filesystem::path& path, StreamWriter& stream, ResourceSerializationInfo& outInfo) const override;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
+		virtual bool FinalizeResource(const std::shared_ptr<Resource>& resource) const override;
+		virtual bool FinalizeResourceStep(const std::shared_ptr<Resource>& resource, uint64_t& budgetBytes) const override;
+		bool SerializeToResourcePack(const sf::Image& image, StreamWriter& stream, ResourceSerializationInfo& outInfo) const;
 	};
 
 	class ENGINE_API SpriteSerializer : public ResourceSerializer
@@ -42,8 +64,9 @@ namespace Luden
 	public:
 		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const override;
 		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const override;
-		virtual bool SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const override;
-		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const override;
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const override;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const override;
+		bool SerializeToResourcePack(const Sprite& sprite, StreamWriter& stream, ResourceSerializationInfo& outInfo) const;
 	};
 
 	class ENGINE_API NativeScriptResourceSerializer : public ResourceSerializer
@@ -52,8 +75,9 @@ namespace Luden
 		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const override;
 		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const override;
 
-		virtual bool SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const override;
-		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const override;
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const override;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const override;
+		virtual bool CanDeserializeAsync() const override { return false; }
 	};
 
 	class ENGINE_API FontSerializer : public ResourceSerializer
@@ -62,8 +86,9 @@ namespace Luden
 		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const override {}
 		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const override;
 
-		virtual bool SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const;
-		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const;
+		virtual bool SerializeFileToResourcePack(const std::filesystem::path& path, StreamWriter& stream, ResourceSerializationInfo& outInfo) const override;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
 	};
 
 	class ENGINE_API SoundResourceSerializer : public ResourceSerializer
@@ -72,8 +97,9 @@ namespace Luden
 		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const override;
 		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const override;
 
-		virtual bool SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const;
-		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const;
+		virtual bool SerializeFileToResourcePack(const std::filesystem::path& path, StreamWriter& stream, ResourceSerializationInfo& outInfo) const override;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
 	};
 
 	class ENGINE_API MusicResourceSerializer : public ResourceSerializer
@@ -82,8 +108,9 @@ namespace Luden
 		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const override;
 		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const override;
 
-		virtual bool SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const;
-		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const;
+		virtual bool SerializeFileToResourcePack(const std::filesystem::path& path, StreamWriter& stream, ResourceSerializationInfo& outInfo) const override;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
 	};
 
 	class ENGINE_API PrefabSerializer : public ResourceSerializer
@@ -92,8 +119,9 @@ namespace Luden
 		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const override;
 		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const override;
 
-		virtual bool SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const;
-		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
+		virtual bool CanDeserializeAsync() const override { return false; }
 	};
 
 	class ENGINE_API SceneResourceSerializer : public ResourceSerializer
@@ -102,9 +130,10 @@ namespace Luden
 		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const override;
 		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const override;
 
-		virtual bool SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const;
-		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
-		std::shared_ptr<Scene> DeserializeSceneFromResourcePack(FileStreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo) const;
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
+		std::shared_ptr<Scene> DeserializeSceneFromResourcePack(StreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo) const;
+		virtual bool CanDeserializeAsync() const override { return false; }
 	};
 
 	class ENGINE_API AnimationResourceSerializer : public ResourceSerializer
@@ -113,7 +142,27 @@ namespace Luden
 		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const override;
 		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const override;
 
-		virtual bool SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const;
-		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const;
+	};
+
+	class ENGINE_API TilesetSerializer : public ResourceSerializer
+	{
+	public:
+		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const override;
+		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const override;
+
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const override;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const override;
+	};
+
+	class ENGINE_API ParticleEmitterSerializer : public ResourceSerializer
+	{
+	public:
+		virtual void Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const override;
+		virtual bool TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const override;
+
+		virtual bool SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const override;
+		virtual std::shared_ptr<Resource> DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const override;
 	};
 }
\ No newline at end of file
@@ -29,9 +29,14 @@ namespace Luden
 		Music,
 		Font,
 		Animation,
-		NativeScript
+		NativeScript,
+		Tileset,
+		ParticleEmitter
 	};
 
+	// Number of ResourceType values, for tables indexed by type
+	constexpr uint32_t ResourceTypeCount = (uint32_t)ResourceType::ParticleEmitter + 1;
+
 	namespace Utils
 	{
 		inline ResourceType ResourceTypeToString(std::string_view resourceType)
@@ -46,6 +51,8 @@ namespace Luden
 			if (resourceType == "Font")				return ResourceType::Font;
 			if (resourceType == "Animation")		return ResourceType::Animation;
 			if (resourceType == "NativeScript")		return ResourceType::NativeScript;
+			if (resourceType == "Tileset")			return ResourceType::Tileset;
+			if (resourceType == "ParticleEmitter")	return ResourceType::ParticleEmitter;
 
 			return ResourceType::None;
 		}
@@ -64,6 +71,8 @@ namespace Luden
 			case ResourceType::Font:			return "Font";
 			case ResourceType::Animation:		return "Animation";
 			case ResourceType::NativeScript:	return "NativeScript";
+			case ResourceType::Tileset:			return "Tileset";
+			case ResourceType::ParticleEmitter:	return "ParticleEmitter";
 			}
 
 			return "None";
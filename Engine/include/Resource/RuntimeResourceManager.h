@@ -4,6 +4,8 @@
 #include "Resource/ResourceManagerBase.h"
 #include "Serialization/ResourcePack.h"
 
+#include <list>
+
 namespace Luden 
 {
 	class ENGINE_API RuntimeResourceManager : public ResourceManagerBase
@@ -12,11 +14,15 @@ namespace Luden
 		RuntimeResourceManager();
 		virtual ~RuntimeResourceManager();
 
-		virtual void Shutdown() override {};
+		virtual void Shutdown() override;
 
 		virtual ResourceType GetResourceType(ResourceHandle resourceHandle) override;
 		virtual std::shared_ptr<Resource> GetResource(ResourceHandle resourceHandle) override;
 
+		virtual ResourceFuture GetResourceAsync(ResourceHandle resourceHandle) override;
+		virtual void PrefetchScene(ResourceHandle sceneHandle) override;
+		virtual void Update() override;
+
 		virtual bool ReloadData(ResourceHandle resourceHandle) override;
 
 		virtual bool EnsureCurrent(ResourceHandle resourceHandle) override;
@@ -31,7 +37,9 @@ namespace Luden
 		virtual void RegisterDependency(ResourceHandle resourceHandle, ResourceHandle dependency) override {};
 
 		virtual std::unordered_set<ResourceHandle> GetAllResourcesWithType(ResourceType type) override;
+		virtual ResourceHandle FindResourceByName(ResourceType type, std::string_view name) override { return m_ResourcePack ? m_ResourcePack->FindResourceByName(type, name) : ResourceHandle(0); }
 		virtual std::unordered_map<ResourceHandle, std::shared_ptr<Resource>>& GetLoadedResources() override { return m_LoadedResources; };
+		virtual const ResourceCacheStats* GetCacheStats() const override { return &m_CacheStats; }
 
 		// ------------- Runtime-only ----------------
 
@@ -39,13 +47,46 @@ namespace Luden
 
 		void SetResourcePack(std::shared_ptr<ResourcePack> resourcePack);
 
+		// Once loaded resources take more than the budget, the least recently used ones nobody else holds are
+		// unloaded on Update. 0 keeps everything
+		void SetMemoryBudget(uint64_t bytes) { m_CacheStats.BudgetBytes = bytes; }
+		uint64_t GetMemoryBudget() const { return m_CacheStats.BudgetBytes; }
+
+		// Pinned resources are never evicted. Pins are counted, every pin needs its unpin
+		void PinResource(ResourceHandle resourceHandle);
+		void UnpinResource(ResourceHandle resourceHandle);
+
+		// The active scene's dependencies are pinned by LoadScene
+		void PinSceneDependencies(ResourceHandle sceneHandle);
+		void UnpinSceneDependencies(ResourceHandle sceneHandle);
+
 	private:
 		void UpdateDependencies(ResourceHandle handle) {}
 
+		void AddLoadedResource(ResourceHandle resourceHandle, const std::shared_ptr<Resource>& resource);
+		void ReleaseResource(ResourceHandle resourceHandle);
+		void TouchResource(ResourceHandle resourceHandle);
+		void TrimToBudget();
+
 	private:
 		std::unordered_map<ResourceHandle, std::shared_ptr<Resource>> m_LoadedResources;
+
+		struct CacheEntry
+		{
+			uint64_t Size = 0;
+			ResourceType Type = ResourceType::None;
+			std::list<ResourceHandle>::iterator LruPosition;
+		};
+
+		std::unordered_map<ResourceHandle, CacheEntry> m_CacheEntries;
+		std::list<ResourceHandle> m_LruList; // Most recently used first
+		std::unordered_map<ResourceHandle, uint32_t> m_PinCounts;
+		ResourceCacheStats m_CacheStats;
 		std::unordered_set<ResourceHandle> m_PendingResources;
 
+		ResourceLoader m_Loader;
+		std::vector<std::shared_ptr<ResourceLoadRequest>> m_DecodedRequests;
+
 		std::shared_ptr<ResourcePack> m_ResourcePack;
 		ResourceHandle m_ActiveScene = 0;
 	};
@@ -9,7 +9,12 @@
 #include "Core/UUID.h"
 #include "Core/TimeStep.h"
 #include "Physics2D/Physics2DManager.h"
+#include "Render/ParticleSystem.h"
+#include "Render/SpriteBatch.h"
+#include "Render/TilemapRenderer.h"
+#include "Scene/SceneSnapshot.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -18,7 +23,8 @@
 #include <SFML/Window.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/View.hpp>
-#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 
 #include <box2d/box2d.h>
 #include "Prefab.h"
@@ -33,14 +39,14 @@ namespace Luden {
 		virtual ~Scene();
 
 		// Update & Render
-		virtual void OnUpdateRuntime(TimeStep ts, std::shared_ptr<sf::RenderTexture> renderTexture);
-		virtual void OnUpdateEditor(TimeStep ts, std::shared_ptr<sf::RenderTexture> renderTexture, Camera2D& editorCamera);
-		virtual void OnRenderRuntime(std::shared_ptr<sf::RenderTexture> target, Camera2D& runtimeCamera);
-		virtual void OnRenderEditor(std::shared_ptr<sf::RenderTexture> target, Camera2D& editorCamera);
+		virtual void OnUpdateRuntime(TimeStep ts, sf::RenderTarget& target);
+		virtual void OnUpdateEditor(TimeStep ts, sf::RenderTarget& target, Camera2D& editorCamera);
+		virtual void OnRenderRuntime(sf::RenderTarget& target, Camera2D& runtimeCamera);
+		virtual void OnRenderEditor(sf::RenderTarget& target, Camera2D& editorCamera);
 
-		void RenderAnimatedEntity(Entity& e, TransformComponent& transform, std::shared_ptr<sf::RenderTexture> target);
-		void RenderStaticSprite(Entity& e, TransformComponent& transform, std::shared_ptr<sf::RenderTexture> target);
-		void RenderText(Entity& e, TransformComponent& transform, std::shared_ptr<sf::RenderTexture> target);
+		void RenderAnimatedEntity(Entity& e, TransformComponent& transform, sf::RenderTarget& target);
+		void RenderStaticSprite(Entity& e, TransformComponent& transform, sf::RenderTarget& target);
+		void RenderText(Entity& e, TransformComponent& transform, sf::RenderTarget& target);
 
 		// Runtime
 		void OnRuntimeStart();
@@ -82,6 +88,7 @@ namespace Luden {
 
 		Entity FindEntityByBodyId(b2BodyId bodyId);
 		Entity FindEntityByShapeId(b2ShapeId shapeId);
+		Entity FindEntityByUserData(void* userData);
 
 		template<typename T>
 		void CopyComponentIfExists(Entity dest, Entity source)
@@ -106,6 +113,14 @@ namespace Luden {
 		void SetViewportSize(uint32_t width, uint32_t height);
 		uint32_t GetViewportWidth() const { return m_ViewportWidth; }
 		uint32_t GetViewportHeight() const { return m_ViewportHeight; }
+
+		// Fixed game resolution, independent of the size of the render target. {0, 0} follows the target size.
+		void SetRenderResolution(const sf::Vector2u& resolution) { m_RenderResolution = resolution; }
+		const sf::Vector2u& GetRenderResolution() const { return m_RenderResolution; }
+
+		// Normalized area of the render target the scene is drawn into, used for letterboxing
+		void SetPresentViewport(const sf::FloatRect& viewport) { m_PresentViewport = viewport; }
+		const sf::FloatRect& GetPresentViewport() const { return m_PresentViewport; }
 		
 		Entity GetMainCameraEntity();
 
@@ -117,6 +132,12 @@ namespace Luden {
 		void DrawLine(const glm::vec2& p1, const glm::vec2& p2);
 		std::unordered_set<ResourceHandle> GetResourceList();
 
+		const SpriteBatch& GetSpriteBatch() const { return m_SpriteBatch; }
+		const TilemapRenderer& GetTilemapRenderer() const { return m_TilemapRenderer; }
+
+		ParticleSystem& GetParticleSystem() { return m_ParticleSystem; }
+		const ParticleSystem& GetParticleSystem() const { return m_ParticleSystem; }
+
 		b2WorldId GetPhysicsWorldId();
 		Physics2DManager& GetPhysicsManager() { return m_PhysicsManager; }
 		const Physics2DManager& GetPhysicsManager() const { return m_PhysicsManager; }
@@ -128,6 +149,36 @@ namespace Luden {
 		void SetPaused(bool paused) { m_Paused = paused; }
 		bool IsPaused() const { return m_Paused; }
 
+		// Scripts' OnFixedUpdate and the physics step run at this rate, whatever the frame rate
+		void SetFixedTickRate(float ticksPerSecond);
+		float GetFixedTickRate() const { return 1.0f / m_FixedTimeStep; }
+		float GetFixedTimeStep() const { return m_FixedTimeStep; }
+
+		// Caps the fixed steps run in a single frame, the remaining time is dropped after a hitch
+		void SetMaxFixedSteps(int maxSteps) { m_MaxFixedSteps = std::max(maxSteps, 1); }
+		int GetMaxFixedSteps() const { return m_MaxFixedSteps; }
+
+		// Fraction of a fixed step elapsed since the last one, used to blend physics transforms
+		float GetInterpolationAlpha() const { return m_FixedAccumulator / m_FixedTimeStep; }
+
+		// Fixed steps run since the runtime started
+		uint64_t GetFixedTick() const { return m_FixedTick; }
+
+		// Runs a single fixed step right away, used to re-simulate the ticks after a rollback
+		void StepFixed();
+
+		// Binary copy of the simulation state: transforms, bodies, health and what scripts write in OnSaveState.
+		// Entities spawned or destroyed since the snapshot was taken are left as they are on restore.
+		void SaveSnapshot(SceneSnapshot& snapshot);
+		bool RestoreSnapshot(const SceneSnapshot& snapshot);
+
+		// Snapshots the scene at the end of each of the last frameCount fixed ticks, 0 disables it
+		void SetSnapshotHistory(uint32_t frameCount) { m_SnapshotHistory.SetCapacity(frameCount); }
+		const SceneSnapshotBuffer& GetSnapshotHistory() const { return m_SnapshotHistory; }
+
+		// Restores the state at the end of tick and drops the newer snapshots, false when tick is no longer kept
+		bool RollbackToTick(uint64_t tick);
+
 		static ResourceType GetStaticType() { return ResourceType::Scene; }
 		virtual ResourceType GetResourceType() const override { return GetStaticType(); }
 
@@ -136,6 +187,12 @@ namespace Luden {
 	public:
 		static std::shared_ptr<Scene> CreateEmpty();
 
+	private:
+		void OnFixedUpdate(TimeStep ts);
+		void UpdateParticles(TimeStep ts);
+		void ClearTarget(sf::RenderTarget& target);
+		sf::Vector2u ResolveRenderResolution(const sf::RenderTarget& target) const;
+
 	private:
 		EntityManager m_EntityManager;
 
@@ -145,11 +202,24 @@ namespace Luden {
 
 		size_t m_CurrentFrame = 0;
 
+		float m_FixedTimeStep = 1.0f / 60.0f;
+		float m_FixedAccumulator = 0.0f;
+		int m_MaxFixedSteps = 5;
+		uint64_t m_FixedTick = 0;
+
+		SceneSnapshotBuffer m_SnapshotHistory;
+
 		uint32_t m_ViewportWidth = 0;
 		uint32_t m_ViewportHeight = 0;
+		sf::Vector2u m_RenderResolution = { 0, 0 };
+		sf::FloatRect m_PresentViewport = { { 0.0f, 0.0f }, { 1.0f, 1.0f } };
 
 		//Physics2D
 		Physics2DManager m_PhysicsManager;
+
+		SpriteBatch m_SpriteBatch;
+		TilemapRenderer m_TilemapRenderer;
+		ParticleSystem m_ParticleSystem;
 	};
 
 }
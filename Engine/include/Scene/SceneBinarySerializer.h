@@ -0,0 +1,43 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "IO/StreamWriter.h"
+#include "IO/StreamReader.h"
+
+#include <memory>
+
+namespace Luden
+{
+	class Scene;
+
+	// Wall-clock cost of SceneBinarySerializer::RunLoadBenchmark, times in milliseconds
+	struct SceneLoadBenchmarkResult
+	{
+		uint32_t EntityCount = 0;
+		uint32_t IterationCount = 0;
+		uint64_t BinarySize = 0;
+		float BinaryLoadTime = 0.0f;
+		float JsonLoadTime = 0.0f;
+	};
+
+	// Shipped scene encoding, written by the pack builder. JSON stays the editor and source format.
+	// Layout: header, shared string table, entity UUIDs and tag indices, then one block per component type holding
+	// the indices of the entities that have it and their packed POD records. Parents and children are stored as
+	// entity indices. Blocks carry their byte size so unknown component types can be skipped.
+	class ENGINE_API SceneBinarySerializer
+	{
+	public:
+		SceneBinarySerializer(std::shared_ptr<Scene> scene);
+
+		bool Serialize(StreamWriter& stream);
+		bool Deserialize(StreamReader& stream);
+
+		// Builds a scene of entityCount sprites, a third of them with a body and in small hierarchies, then loads it
+		// from its binary and JSON forms. Times are averages over the iterations. Needs room for entityCount more entities
+		static SceneLoadBenchmarkResult RunLoadBenchmark(uint32_t entityCount, uint32_t iterationCount);
+
+		static constexpr uint32_t Version = 1;
+	private:
+		const std::shared_ptr<Scene> m_Scene;
+	};
+}
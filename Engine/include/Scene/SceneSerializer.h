@@ -21,8 +21,8 @@ namespace Luden
 		bool SerializeToJSON(nlohmann::json& outJson);
 		bool DeserializeFromJSON(const nlohmann::json& inJson);
 
-		bool SerializeToResourcePack(FileStreamWriter& stream, ResourceSerializationInfo& outInfo);
-		bool DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo);
+		bool SerializeToResourcePack(StreamWriter& stream, ResourceSerializationInfo& outInfo);
+		bool DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo);
 
 	public:
 		inline static std::string_view FileFilter = "Luden Scene (*.lscene)\0*.lscene\0";
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "EngineAPI.h"
+
+#include <vector>
+
+namespace Luden
+{
+	// Binary simulation state of a scene at the end of a fixed tick, written by Scene::SaveSnapshot
+	struct ENGINE_API SceneSnapshot
+	{
+		uint64_t Tick = 0;
+		std::vector<uint8_t> Data;
+	};
+
+	// Keeps the snapshots of the last N fixed ticks. Slots are reused so their memory is only allocated once.
+	class ENGINE_API SceneSnapshotBuffer
+	{
+	public:
+		SceneSnapshotBuffer() = default;
+		explicit SceneSnapshotBuffer(uint32_t capacity) { SetCapacity(capacity); }
+
+		void SetCapacity(uint32_t capacity);
+		uint32_t GetCapacity() const { return (uint32_t)m_Snapshots.size(); }
+		uint32_t GetCount() const { return m_Count; }
+
+		// Slot for tick, overwrites the oldest snapshot once the buffer is full. The capacity must not be 0
+		SceneSnapshot& Acquire(uint64_t tick);
+		const SceneSnapshot* Find(uint64_t tick) const;
+
+		// Drops the snapshots newer than tick, they are stale after rolling back to it
+		void DiscardAfter(uint64_t tick);
+		void Clear();
+
+		const SceneSnapshot* GetOldest() const;
+		const SceneSnapshot* GetNewest() const;
+	private:
+		uint32_t SlotOf(uint32_t age) const { return (m_Head + GetCapacity() - 1 - age) % GetCapacity(); }
+	private:
+		std::vector<SceneSnapshot> m_Snapshots;
+		uint32_t m_Head = 0; // Next slot to write
+		uint32_t m_Count = 0;
+	};
+}
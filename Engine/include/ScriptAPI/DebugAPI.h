@@ -14,5 +14,8 @@ namespace Luden
 		void ENGINE_API DrawDebugCircle(const glm::vec3& center, float radius, const sf::Color& color, float duration);
 
 		void ENGINE_API DrawDebugBox(const glm::vec3& center, const glm::vec3& extent, const sf::Color& color, float duration);
+
+		// Removes the shapes drawn with DebugManager::Persistent as duration
+		void ENGINE_API ClearPersistentDebugDraw();
 	}
 }
\ No newline at end of file
@@ -31,6 +31,7 @@ namespace Luden
 
 		ENGINE_API Entity FindEntityWithTag(const String& tag);
 		ENGINE_API Vector<Entity> FindAllEntitiesWithTag(const String& tag);
+		// Checks every transform, Physics2DAPI::OverlapCircle finds entities with colliders through the broadphase
 		ENGINE_API Vector<Entity> FindEntitiesInRadius(const Vec3& center, float radius);
 		ENGINE_API Entity FindClosestEntity(const Vec3& position, const String& tag);
 
@@ -82,7 +83,7 @@ namespace Luden
 		ENGINE_API void SetCameraZoom(float zoom);
 
 		ENGINE_API Vec2 GetMousePosition();              
-		ENGINE_API Entity GetEntityUnderMouse();
+		ENGINE_API Entity GetEntityUnderMouse(); // Bodies are hit by their colliders, other entities by their rect. The first in entity order wins
 
 		ENGINE_API bool IsOnScreen(Entity entity);
 		ENGINE_API bool IsOnScreen(const Vec3& worldPos);
@@ -4,6 +4,8 @@
 #include "ECS/Entity.h"
 
 #include <glm/vec2.hpp>
+#include <span>
+#include <string>
 #include <vector>
 
 namespace Luden
@@ -20,6 +22,12 @@ namespace Luden
 			b2ShapeId shapeId = b2_nullShapeId;
 		};
 
+		struct ENGINE_API Ray
+		{
+			glm::vec2 start;
+			glm::vec2 end;
+		};
+
 		struct ENGINE_API RaycastContext
 		{
 			std::vector<RaycastHit>* hits;
@@ -46,6 +54,22 @@ namespace Luden
 
 		ENGINE_API RaycastHit RaycastClosest(glm::vec2 start, glm::vec2 end);
 		ENGINE_API std::vector<RaycastHit> RaycastAll(glm::vec2 start, glm::vec2 end);
+
+		// Broadphase queries. Positions are in world space (pixels, y down) and only shapes whose category
+		// is in channelMask are reported. Entities are resolved through the shape user data.
+		constexpr uint16_t AllChannels = 0xFFFF;
+		ENGINE_API uint16_t ChannelMask(const std::vector<std::string>& channelNames);
+
+		ENGINE_API std::vector<Entity> OverlapPoint(glm::vec2 point, uint16_t channelMask = AllChannels);
+		ENGINE_API std::vector<Entity> OverlapCircle(glm::vec2 center, float radius, uint16_t channelMask = AllChannels);
+		ENGINE_API std::vector<Entity> OverlapAABB(glm::vec2 min, glm::vec2 max, uint16_t channelMask = AllChannels); // Tests shape bounds only
+		ENGINE_API std::vector<Entity> OverlapPolygon(const std::vector<glm::vec2>& points, uint16_t channelMask = AllChannels); // Convex, up to 8 points
+
+		// Sweeps a convex shape (radius rounds it, a single point with a radius is a circle) by translation, closest hit
+		ENGINE_API RaycastHit ShapeCast(const std::vector<glm::vec2>& points, float radius, glm::vec2 translation, uint16_t channelMask = AllChannels);
+
+		// Closest hit of every ray, large batches are split across the job system
+		ENGINE_API std::vector<RaycastHit> RaycastBatch(std::span<const Ray> rays, uint16_t channelMask = AllChannels);
 	}
 }
 
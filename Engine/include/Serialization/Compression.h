@@ -0,0 +1,21 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "Core/Buffer.h"
+
+#include <vector>
+
+namespace Luden
+{
+	// Block compression for resource pack entries. LZ4 decompresses far faster than the disk reads it saves,
+	// its slower high compression mode is only paid once, when the pack is built
+	class ENGINE_API Compression
+	{
+	public:
+		// False when the data cannot be compressed, e.g. past the 2GB LZ4 block limit
+		static bool CompressLZ4(BufferView source, std::vector<uint8_t>& outCompressed);
+
+		// Fails unless source decompresses to exactly destinationSize bytes
+		static bool DecompressLZ4(BufferView source, void* destination, uint64_t destinationSize);
+	};
+}
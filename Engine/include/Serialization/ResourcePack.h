@@ -2,10 +2,13 @@
 
 #include <filesystem>
 #include <map>
-#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 #include "Core/UUID.h"
+#include "IO/MappedFile.h"
 #include "Resource/Resource.h"
+#include "Resource/ResourceNameIndex.h"
 #include "Serialization/ResourcePackFile.h"
 #include "Serialization/ResourcePackSerializer.h"
 
@@ -23,15 +26,31 @@ namespace Luden
 		void Serialize();
 
 		std::shared_ptr<Scene> LoadScene(ResourceHandle sceneHandle);
-		std::shared_ptr<Resource> LoadResource(ResourceHandle sceneHandle, ResourceHandle resourceHandle);
+		std::shared_ptr<Resource> LoadResource(ResourceHandle resourceHandle);
+
+		// LoadResource without the main thread finalization, safe on loader threads for types that allow it.
+		// ResourceImporter::FinalizeResource completes the resource
+		std::shared_ptr<Resource> DecodeResource(ResourceHandle resourceHandle) const;
+
+		// Everything the scene needs, as gathered by the pack builder
+		std::vector<ResourceHandle> GetSceneDependencies(ResourceHandle sceneHandle) const;
 
 		bool IsResourceHandleValid(ResourceHandle resourceHandle) const;
 		bool IsResourceHandleValid(ResourceHandle sceneHandle, ResourceHandle resourceHandle) const;
 
-		Buffer ReadAppBinary();
-		uint64_t GetBuildVersion();
+		BufferView ReadAppBinary() const;
+		uint64_t GetBuildVersion() const;
+
+		ResourceType GetResourceType(ResourceHandle resourceHandle) const;
+
+		// Resources by their file name as it was when the pack was built, see ResourceNameIndex
+		ResourceHandle FindResourceByName(ResourceType type, std::string_view name) const { return m_NameIndex.Find(type, name); }
 
-		ResourceType GetResourceType(ResourceHandle sceneHandle, ResourceHandle resourceHandle) const;
+		const ResourcePackFile::SceneInfo* FindSceneInfo(ResourceHandle sceneHandle) const;
+		const ResourcePackFile::ResourceInfo* FindResourceInfo(ResourceHandle resourceHandle) const;
+
+		// The whole pack as mapped, offsets in the index are relative to it
+		BufferView GetData() const { return m_Mapping.GetView(); }
 
 		// This will create a complete resource pack from ALL referenced resources
 		// in currently active project. This should change in the future to
@@ -40,12 +59,20 @@ namespace Luden
 		static std::shared_ptr<ResourcePack> CreateFromActiveProject(std::atomic<float>& progress);
 		static std::shared_ptr<ResourcePack> Load(const std::filesystem::path& path);
 		static std::shared_ptr<ResourcePack> LoadActiveProject();
+	private:
+		// Thread safe, compressed entries are decompressed on whichever thread decodes them
+		bool DecompressEntry(uint64_t offset, uint64_t packedSize, uint64_t unpackedSize, std::vector<uint8_t>& outData) const;
 	private:
 		std::filesystem::path m_Path;
 		ResourcePackFile m_File;
 
+		// Mapped once on load, every scene and resource is read straight from it
+		MappedFile m_Mapping;
+
 		ResourcePackSerializer m_Serializer;
 
-		std::unordered_set<ResourceHandle> m_ResourceHandleIndex;
+		// ResourceHandle->index into the index's resource table, built on load
+		std::unordered_map<ResourceHandle, uint32_t> m_ResourceLookup;
+		ResourceNameIndex m_NameIndex;
 	};
 }
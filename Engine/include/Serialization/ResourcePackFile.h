@@ -1,27 +1,66 @@
 #pragma once
 
 #include <map>
+#include <string>
+#include <vector>
 
 #include "Resource/Resource.h"
 
 namespace Luden {
 
+	enum class ResourcePackFlag : uint16_t
+	{
+		None = 0,
+		AtlasPage = BIT(0),
+		CompressedLZ4 = BIT(1)
+	};
+
+	enum class TexturePackFormat : uint16_t
+	{
+		Encoded = 0, // The source PNG/JPG..., decoded when loaded
+		RGBA8 // Pixels ready to upload
+	};
+
+	enum class TexturePackFlag : uint16_t
+	{
+		None = 0,
+		GenerateMipmap = BIT(0), // Built on the GPU once the pixels are uploaded
+		PremultipliedAlpha = BIT(1) // RGB is multiplied by alpha once loaded, drawn with a premultiplied blend mode
+	};
+
 	struct ResourcePackFile
 	{
 		struct ResourceInfo
 		{
+			uint64_t Handle;
 			uint64_t PackedOffset;
-			uint64_t PackedSize;
+			uint64_t PackedSize; // As stored in the pack
+			uint64_t UnpackedSize; // Once decompressed, equal to PackedSize for raw entries
+			uint64_t SourceHash; // Everything the entry was built from, 0 if it can not be tracked
+			uint64_t ContentHash; // Serialized data before compression
 			uint16_t Type;
-			uint16_t Flags; // compressed type, etc.
+			uint16_t Flags; // ResourcePackFlag
 		};
 
 		struct SceneInfo
 		{
 			uint64_t PackedOffset = 0;
 			uint64_t PackedSize = 0;
-			uint16_t Flags = 0; // compressed type, etc.
-			std::map<uint64_t, ResourceInfo> Resources; // ResourceHandle->ResourceInfo
+			uint64_t UnpackedSize = 0;
+			uint64_t SourceHash = 0;
+			uint64_t ContentHash = 0;
+			uint16_t Flags = 0; // ResourcePackFlag
+			uint32_t FirstDependency = 0; // Range of IndexTable::Dependencies
+			uint32_t DependencyCount = 0;
+		};
+
+		struct AtlasRegion
+		{
+			uint64_t PageHandle;
+			int32_t X;
+			int32_t Y;
+			int32_t Width;
+			int32_t Height;
 		};
 
 		struct IndexTable
@@ -29,13 +68,29 @@ namespace Luden {
 			uint64_t PackedAppBinaryOffset = 0;
 			uint64_t PackedAppBinarySize = 0;
 			std::map<uint64_t, SceneInfo> Scenes; // ResourceHandle->SceneInfo
+			std::vector<ResourceInfo> Resources; // Sorted by handle, every resource once no matter how many scenes use it
+			std::vector<uint32_t> Dependencies; // Indices into Resources, the scenes' ranges back to back
+			std::vector<std::string> ResourceNames; // Parallel to Resources, empty for resources made by the builder
+			std::map<uint64_t, AtlasRegion> AtlasRegions; // SpriteHandle->AtlasRegion
+		};
+
+		// Starts every texture entry, followed by the size-prefixed pixel or encoded data
+		struct TextureHeader
+		{
+			uint32_t Width = 0; // 0 for encoded data
+			uint32_t Height = 0;
+			uint16_t Format = 0; // TexturePackFormat
+			uint16_t Flags = 0; // TexturePackFlag
 		};
 
 		struct FileHeader
 		{
 			const char HEADER[4] = { 'L','Z','A','P' };
-			uint32_t Version = 3;
+			uint32_t Version = 10;
 			uint64_t BuildVersion = 0; // Usually date/time format (eg. 202210061535)
+			uint64_t BaseBuildVersion = 0; // Build unchanged entries were copied from, 0 for a full build
+			uint32_t ReusedEntries = 0;
+			uint32_t RebuiltEntries = 0;
 		};
 
 		FileHeader Header;
@@ -2,16 +2,22 @@
 
 #include "Serialization/ResourcePackFile.h"
 #include "Core/Buffer.h"
+#include "IO/StreamReader.h"
 
 #include <filesystem>
 
 namespace Luden {
 
+	class ResourcePack;
+	class TextureAtlasBuilder;
+
 	class ResourcePackSerializer
 	{
 	public:
-		static void Serialize(const std::filesystem::path& path, ResourcePackFile& file, Buffer appBinary, std::atomic<float>& progress);
-		static bool DeserializeIndex(const std::filesystem::path& path, ResourcePackFile& file);
+		// Entries of basePack whose sources are unchanged are copied instead of serialized again. basePack must not be
+		// the file at path, it stays mapped while the new pack is written
+		static void Serialize(const std::filesystem::path& path, ResourcePackFile& file, Buffer appBinary, const TextureAtlasBuilder& atlas, std::atomic<float>& progress, const ResourcePack* basePack = nullptr);
+		static bool DeserializeIndex(StreamReader& stream, ResourcePackFile& file);
 	private:
 		static uint64_t CalculateIndexTableSize(const ResourcePackFile& file);
 	};
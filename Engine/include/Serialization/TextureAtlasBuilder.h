@@ -0,0 +1,82 @@
+#pragma once
+
+#include "EngineAPI.h"
+#include "Resource/Resource.h"
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Luden
+{
+	struct ENGINE_API TextureAtlasPage
+	{
+		ResourceHandle Handle;
+		sf::Image Image;
+	};
+
+	struct ENGINE_API TextureAtlasRegion
+	{
+		ResourceHandle PageHandle = 0;
+		sf::IntRect Rect;
+	};
+
+	// Packs sprite regions into a small number of large texture pages (MaxRects, best short side fit).
+	// Used by the resource pack build so sprites of a scene end up sharing a handful of textures.
+	class ENGINE_API TextureAtlasBuilder
+	{
+	public:
+		TextureAtlasBuilder(uint32_t pageSize = 2048, uint32_t padding = 2);
+
+		// Packs every sprite in spriteHandles that is not already part of the atlas into new pages.
+		// Returns the texture handles the sprites reference afterwards (atlas pages, plus the original
+		// textures of sprites that could not be packed).
+		std::unordered_set<ResourceHandle> AddSprites(const std::unordered_set<ResourceHandle>& spriteHandles);
+
+		const TextureAtlasRegion* GetRegion(ResourceHandle spriteHandle) const;
+		const TextureAtlasPage* GetPage(ResourceHandle pageHandle) const;
+
+		const std::unordered_map<ResourceHandle, TextureAtlasRegion>& GetRegions() const { return m_Regions; }
+		const std::vector<TextureAtlasPage>& GetPages() const { return m_Pages; }
+
+		uint32_t GetPageSize() const { return m_PageSize; }
+		uint32_t GetPadding() const { return m_Padding; }
+	private:
+		class MaxRectsBin
+		{
+		public:
+			MaxRectsBin(uint32_t width, uint32_t height);
+
+			bool Insert(sf::Vector2i size, sf::IntRect& outRect);
+			bool FindPosition(sf::Vector2i size, sf::IntRect& outRect, int& outScore) const;
+			void PlaceRect(const sf::IntRect& rect);
+
+			sf::Vector2i GetUsedSize() const { return m_UsedSize; }
+		private:
+			bool SplitFreeRect(const sf::IntRect& freeRect, const sf::IntRect& usedRect);
+			void PruneFreeRects();
+		private:
+			std::vector<sf::IntRect> m_FreeRects;
+			std::vector<sf::IntRect> m_NewFreeRects;
+			sf::Vector2i m_UsedSize = { 0, 0 };
+		};
+
+		// Only depends on the page's position, incremental pack builds match pages by handle and compare their pixels
+		static ResourceHandle GetPageHandle(uint32_t pageIndex);
+
+		const sf::Image* GetSourceImage(ResourceHandle textureHandle);
+		void ExtrudeEdges(sf::Image& page, const sf::IntRect& rect) const;
+	private:
+		uint32_t m_PageSize;
+		uint32_t m_Padding;
+
+		std::vector<TextureAtlasPage> m_Pages;
+		std::unordered_map<ResourceHandle, TextureAtlasRegion> m_Regions; // SpriteHandle->TextureAtlasRegion
+
+		std::unordered_map<ResourceHandle, sf::Image> m_SourceImages;
+		std::unordered_set<ResourceHandle> m_FailedImages;
+	};
+}
@@ -17,7 +17,10 @@ project "Engine"
         "include/**.h",
         "../extern/imgui/*.cpp",
         "../extern/ImGui-SFML/*.cpp",
-        "../extern/ImGui-SFML/*.h"
+        "../extern/ImGui-SFML/*.h",
+        "../extern/lz4/lib/lz4.c",
+        "../extern/lz4/lib/lz4hc.c",
+        "../extern/lz4/lib/xxhash.c"
     }
 
     includedirs {
@@ -30,6 +33,7 @@ project "Engine"
         "../%{IncludeDirs.json}",
         "../%{IncludeDirs.IconFontCpp}",
         "../%{IncludeDirs.nfd}",
+        "../%{IncludeDirs.lz4}",
         "../Tools"
     }
 
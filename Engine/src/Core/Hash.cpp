@@ -0,0 +1,11 @@
+#include "Core/Hash.h"
+
+#include <xxhash.h>
+
+namespace Luden
+{
+	uint64_t Hash::Bytes(const void* data, uint64_t size, uint64_t seed)
+	{
+		return XXH64(data, (size_t)size, seed);
+	}
+}
@@ -0,0 +1,210 @@
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+
+namespace Luden
+{
+	static thread_local uint32_t s_WorkerIndex = 0;
+	static thread_local const JobSystem* s_WorkerPool = nullptr;
+
+	JobSystem::~JobSystem()
+	{
+		Shutdown();
+	}
+
+	void JobSystem::Init(uint32_t threadCount, uint32_t maxThreadCount)
+	{
+		if (IsRunning())
+			return;
+
+		if (threadCount == 0)
+			threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+		if (maxThreadCount > 0)
+			threadCount = std::min(threadCount, maxThreadCount);
+
+		m_OwnerThread = std::this_thread::get_id();
+
+		m_Queues.clear();
+		for (uint32_t i = 0; i < threadCount; i++)
+			m_Queues.push_back(std::make_unique<WorkQueue>());
+
+		m_Running.store(true, std::memory_order_release);
+
+		// Queue 0 belongs to the thread that waits on jobs, the others get a thread each
+		for (uint32_t i = 1; i < threadCount; i++)
+			m_Threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!IsRunning())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_WakeMutex);
+			m_Running.store(false, std::memory_order_release);
+		}
+		m_WakeCondition.notify_all();
+
+		for (auto& thread : m_Threads)
+		{
+			if (thread.joinable())
+				thread.join();
+		}
+		m_Threads.clear();
+
+		// Run whatever is left so no counter stays pending
+		QueuedJob job;
+		while (PopJob(0, job))
+		{
+			job.Function();
+			if (job.Counter)
+				job.Counter->Pending.fetch_sub(1, std::memory_order_acq_rel);
+		}
+
+		m_Queues.clear();
+	}
+
+	void JobSystem::Submit(Job job, JobCounter* counter)
+	{
+		if (!IsRunning() || m_Threads.empty())
+		{
+			job();
+			return;
+		}
+
+		if (counter)
+			counter->Pending.fetch_add(1, std::memory_order_acq_rel);
+
+		uint32_t queueIndex = s_WorkerPool == this
+			? s_WorkerIndex
+			: m_NextQueue.fetch_add(1, std::memory_order_relaxed) % (uint32_t)m_Queues.size();
+
+		{
+			WorkQueue& queue = *m_Queues[queueIndex];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			queue.Jobs.push_back({ std::move(job), counter });
+		}
+
+		m_QueuedJobs.fetch_add(1, std::memory_order_acq_rel);
+
+		{
+			std::lock_guard<std::mutex> lock(m_WakeMutex);
+		}
+		m_WakeCondition.notify_one();
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		// Jobs may rely on a unique worker index (per-worker scratch of the physics solver),
+		// a thread outside the pool would share one with a worker so it only waits
+		bool canRunJobs = s_WorkerPool == this || std::this_thread::get_id() == m_OwnerThread;
+		uint32_t workerIndex = s_WorkerPool == this ? s_WorkerIndex : 0;
+
+		while (!counter.IsDone())
+		{
+			if (!canRunJobs || !TryRunJob(workerIndex))
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t minRange, const std::function<void(uint32_t, uint32_t)>& func)
+	{
+		if (count == 0)
+			return;
+
+		uint32_t rangeCount = std::min(GetWorkerCount(), std::max(count / std::max(minRange, 1u), 1u));
+		if (rangeCount <= 1 || !IsRunning())
+		{
+			func(0, count);
+			return;
+		}
+
+		uint32_t rangeSize = (count + rangeCount - 1) / rangeCount;
+
+		JobCounter counter;
+		for (uint32_t begin = rangeSize; begin < count; begin += rangeSize)
+		{
+			uint32_t end = std::min(begin + rangeSize, count);
+			Submit([&func, begin, end]() { func(begin, end); }, &counter);
+		}
+
+		func(0, rangeSize);
+		Wait(counter);
+	}
+
+	uint32_t JobSystem::GetCurrentWorkerIndex()
+	{
+		return s_WorkerPool ? s_WorkerIndex : 0;
+	}
+
+	void JobSystem::WorkerLoop(uint32_t workerIndex)
+	{
+		s_WorkerIndex = workerIndex;
+		s_WorkerPool = this;
+
+		while (true)
+		{
+			if (TryRunJob(workerIndex))
+				continue;
+
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+			m_WakeCondition.wait(lock, [this]()
+				{
+					return m_QueuedJobs.load(std::memory_order_acquire) > 0 || !m_Running.load(std::memory_order_acquire);
+				});
+
+			if (!m_Running.load(std::memory_order_acquire))
+				return;
+		}
+	}
+
+	bool JobSystem::TryRunJob(uint32_t workerIndex)
+	{
+		QueuedJob job;
+		if (!PopJob(workerIndex, job))
+			return false;
+
+		job.Function();
+
+		if (job.Counter)
+			job.Counter->Pending.fetch_sub(1, std::memory_order_acq_rel);
+
+		return true;
+	}
+
+	bool JobSystem::PopJob(uint32_t workerIndex, QueuedJob& outJob)
+	{
+		if (m_Queues.empty() || m_QueuedJobs.load(std::memory_order_acquire) == 0)
+			return false;
+
+		uint32_t queueCount = (uint32_t)m_Queues.size();
+
+		// Own queue first (newest job, still warm in cache), then steal the oldest job of the others
+		for (uint32_t i = 0; i < queueCount; i++)
+		{
+			WorkQueue& queue = *m_Queues[(workerIndex + i) % queueCount];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+
+			if (queue.Jobs.empty())
+				continue;
+
+			if (i == 0)
+			{
+				outJob = std::move(queue.Jobs.back());
+				queue.Jobs.pop_back();
+			}
+			else
+			{
+				outJob = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+			}
+
+			m_QueuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+			return true;
+		}
+
+		return false;
+	}
+}
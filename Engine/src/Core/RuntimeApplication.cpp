@@ -6,11 +6,14 @@
 #include "Resource/ResourceManager.h"
 #include "NativeScript/NativeScriptModuleLoader.h"
 #include "Core/Config.h"
+#include "Physics2D/Physics2DManager.h"
 #include "IO/FileSystem.h"
 #include "SFML/Graphics/Sprite.hpp"
 
 #include <imgui-SFML.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #include "Core/EngineContext.h"
@@ -28,6 +31,8 @@ namespace Luden {
 
 	void RuntimeApplication::Init()
 	{
+		GEngine.GetJobSystem().Init(0, Physics2DManager::MaxWorkerCount);
+
 		sf::VideoMode vm(sf::Vector2u(m_Specification.WindowWidth, m_Specification.WindowHeight));
 		m_Window = std::make_unique<sf::RenderWindow>(
 			sf::VideoMode{ {m_Specification.WindowWidth, m_Specification.WindowHeight} },
@@ -45,13 +50,23 @@ namespace Luden {
 		else
 			m_Window->setFramerateLimit(0);
 
-		m_RenderTexture = std::make_shared<sf::RenderTexture>();
-		if (!m_RenderTexture->resize({ m_Specification.WindowWidth, m_Specification.WindowHeight }))
+		if (m_Specification.Presentation == PresentMode::Offscreen)
 		{
-			std::cerr << "[RuntimeApplication] ERROR: Failed to create RenderTexture!\n";
-			return;
+			float renderScale = m_Specification.RenderScale > 0.0f ? m_Specification.RenderScale : 1.0f;
+			sf::Vector2u renderSize = {
+				std::max(1u, (uint32_t)std::lround(m_Specification.WindowWidth * renderScale)),
+				std::max(1u, (uint32_t)std::lround(m_Specification.WindowHeight * renderScale))
+			};
+
+			m_RenderTexture = std::make_shared<sf::RenderTexture>();
+			if (!m_RenderTexture->resize(renderSize))
+			{
+				std::cerr << "[RuntimeApplication] ERROR: Failed to create RenderTexture!\n";
+				return;
+			}
+			m_RenderTexture->setSmooth(renderScale != 1.0f);
+			GEngine.SetRenderTexture(m_RenderTexture.get());
 		}
-		GEngine.SetRenderTexture(m_RenderTexture.get());
 
 		if (m_Specification.VSync)
 			m_Window->setVerticalSyncEnabled(true);
@@ -108,32 +123,48 @@ namespace Luden {
 
 			sf::Time dt = m_Clock.restart();
 			TimeStep timestep(dt.asSeconds());
+
+			// Publish the resources that finished streaming before anything draws this frame
+			if (Project::GetResourceManager())
+				ResourceManager::Update();
+
 			OnUpdate(timestep);
 
-			m_Window->clear(sf::Color(30, 30, 30));
+			sf::Vector2f windowSize(m_Window->getSize());
+			sf::FloatRect letterbox = CalculateLetterbox(m_Window->getSize());
+			GEngine.SetViewportBounds(
+				glm::vec2(letterbox.position.x * windowSize.x, letterbox.position.y * windowSize.y),
+				glm::vec2(letterbox.size.x * windowSize.x, letterbox.size.y * windowSize.y)
+			);
 
-			if (m_CurrentScene)
+			if (!m_CurrentScene)
 			{
-				m_RenderTexture->clear();
-				m_CurrentScene->OnUpdateRuntime(timestep, m_RenderTexture);
+				m_Window->clear(sf::Color::Black);
+			}
+			else if (!m_RenderTexture)
+			{
+				// The scene clears the window itself, the letterbox only changes the view viewport
+				m_CurrentScene->SetPresentViewport(letterbox);
+				m_CurrentScene->OnUpdateRuntime(timestep, *m_Window);
+			}
+			else
+			{
+				m_CurrentScene->OnUpdateRuntime(timestep, *m_RenderTexture);
 				m_RenderTexture->display();
 
-				sf::Vector2u windowSize = m_Window->getSize();
-				sf::Vector2u textureSize = m_RenderTexture->getSize();
+				m_Window->clear(sf::Color::Black);
 
-				sf::View windowView(sf::FloatRect(
-					{ 0.f, 0.f },
-					{ static_cast<float>(windowSize.x), static_cast<float>(windowSize.y) }
-				));
-				m_Window->setView(windowView);
+				sf::View presentView(sf::FloatRect({ 0.0f, 0.0f }, { 1.0f, 1.0f }));
+				presentView.setViewport(letterbox);
+				m_Window->setView(presentView);
 
-				sf::Sprite sprite(m_RenderTexture->getTexture());
-
-				float scaleX = static_cast<float>(windowSize.x) / textureSize.x;
-				float scaleY = static_cast<float>(windowSize.y) / textureSize.y;
-				sprite.setScale({ scaleX, scaleY });
+				sf::Vector2u textureSize = m_RenderTexture->getSize();
+				sf::Sprite frame(m_RenderTexture->getTexture());
+				frame.setScale({ 1.0f / textureSize.x, 1.0f / textureSize.y });
 
-				m_Window->draw(sprite);
+				sf::RenderStates states;
+				OnPostProcess(states);
+				m_Window->draw(frame, states);
 			}
 			std::cout << "FPS: " << 1.f / dt.asSeconds() << "\r" << std::flush;
 
@@ -154,6 +185,8 @@ namespace Luden {
 
 		if (m_Window && m_Window->isOpen())
 			m_Window->close();
+
+		GEngine.GetJobSystem().Shutdown();
 	}
 
 	void RuntimeApplication::OnUpdate(TimeStep ts)
@@ -161,6 +194,24 @@ namespace Luden {
 		// Can be overridden by project app
 	}
 
+	sf::FloatRect RuntimeApplication::CalculateLetterbox(const sf::Vector2u& windowSize) const
+	{
+		if (windowSize.x == 0 || windowSize.y == 0)
+			return { { 0.0f, 0.0f }, { 1.0f, 1.0f } };
+
+		float gameAspect = (float)m_Specification.WindowWidth / (float)m_Specification.WindowHeight;
+		float windowAspect = (float)windowSize.x / (float)windowSize.y;
+
+		if (windowAspect > gameAspect)
+		{
+			float width = gameAspect / windowAspect;
+			return { { (1.0f - width) * 0.5f, 0.0f }, { width, 1.0f } };
+		}
+
+		float height = windowAspect / gameAspect;
+		return { { 0.0f, (1.0f - height) * 0.5f }, { 1.0f, height } };
+	}
+
 	void RuntimeApplication::OpenProject()
 	{
 		std::shared_ptr<Project> project = std::make_shared<Project>();
@@ -198,7 +249,7 @@ namespace Luden {
 
 			if (m_Window)
 			{
-				sf::Vector2u windowSize = m_Window->getSize();
+				m_CurrentScene->SetRenderResolution({ m_Specification.WindowWidth, m_Specification.WindowHeight });
 				m_CurrentScene->SetViewportSize(m_Specification.WindowWidth, m_Specification.WindowHeight);
 			}
 			else
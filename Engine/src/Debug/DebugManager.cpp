@@ -1,11 +1,32 @@
 #include "Debug/DebugManager.h"
 
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
 #include "box2d/box2d.h"
 
 namespace Luden
 {
+	static constexpr int s_CircleSegments = 24;
+
+	static const std::array<sf::Vector2f, s_CircleSegments>& GetUnitCircle()
+	{
+		static const std::array<sf::Vector2f, s_CircleSegments> s_UnitCircle = []()
+			{
+				std::array<sf::Vector2f, s_CircleSegments> points;
+				for (int i = 0; i < s_CircleSegments; i++)
+				{
+					float angle = 2.0f * 3.14159265f * (float)i / (float)s_CircleSegments;
+					points[i] = { std::cos(angle), std::sin(angle) };
+				}
+				return points;
+			}();
+
+		return s_UnitCircle;
+	}
+
 	void DebugManager::DrawLine(const glm::vec3& start, const glm::vec3& end, const sf::Color& color, float duration)
 	{
 		DebugDrawCommand cmd;
@@ -17,7 +38,7 @@ namespace Luden
 		cmd.duration = duration;
 		cmd.timeRemaining = duration;
 
-		m_Commands.push_back(cmd);
+		Submit(cmd);
 	}
 
 	void DebugManager::DrawCircle(const glm::vec3& center, float radius, const sf::Color& color, float duration)
@@ -30,7 +51,21 @@ namespace Luden
 		cmd.duration = duration;
 		cmd.timeRemaining = duration;
 
-		m_Commands.push_back(cmd);
+		Submit(cmd);
+	}
+
+	void DebugManager::DrawSolidCircle(const glm::vec3& center, float radius, const sf::Color& color, float duration)
+	{
+		DebugDrawCommand cmd;
+		cmd.type = DebugDrawCommand::Type::Circle;
+		cmd.p1 = center;
+		cmd.radius = radius;
+		cmd.color = color;
+		cmd.duration = duration;
+		cmd.timeRemaining = duration;
+		cmd.filled = true;
+
+		Submit(cmd);
 	}
 
 	void DebugManager::DrawBox(const glm::vec3& center, const glm::vec3& extent, const sf::Color& color, float duration)
@@ -43,86 +78,176 @@ namespace Luden
 		cmd.duration = duration;
 		cmd.timeRemaining = duration;
 
-		m_Commands.push_back(cmd);
+		Submit(cmd);
+	}
+
+	void DebugManager::DrawSolidBox(const glm::vec3& center, const glm::vec3& extent, const sf::Color& color, float duration)
+	{
+		DebugDrawCommand cmd;
+		cmd.type = DebugDrawCommand::Type::Box;
+		cmd.p1 = center;
+		cmd.p2 = extent;
+		cmd.color = color;
+		cmd.duration = duration;
+		cmd.timeRemaining = duration;
+		cmd.filled = true;
+
+		Submit(cmd);
+	}
+
+	void DebugManager::Submit(const DebugDrawCommand& cmd)
+	{
+		if (cmd.duration < 0.0f)
+		{
+			AppendCommand(m_PersistentGeometry, cmd);
+			m_PersistentDirty = true;
+		}
+		else if (cmd.duration == 0.0f)
+		{
+			// Single frame shapes go straight into the vertex streams
+			AppendCommand(m_FrameGeometry, cmd);
+		}
+		else
+		{
+			m_TimedCommands.push_back(cmd);
+		}
 	}
 
 	void DebugManager::Update(float deltaTime)
 	{
-		for (auto it = m_Commands.begin(); it != m_Commands.end();)
+		// Order does not matter, expired commands are swap-removed
+		for (size_t i = 0; i < m_TimedCommands.size();)
 		{
-			if (it->duration == 0.0f && it->rendered == true)
+			m_TimedCommands[i].timeRemaining -= deltaTime;
+			if (m_TimedCommands[i].timeRemaining <= 0.0f)
 			{
-				it = m_Commands.erase(it);
+				m_TimedCommands[i] = m_TimedCommands.back();
+				m_TimedCommands.pop_back();
 				continue;
-
 			}
-			else if (it->duration > 0.0f)
-			{
-				it->timeRemaining -= deltaTime;
-				if (it->timeRemaining <= 0.0f)
-				{
-					it = m_Commands.erase(it);
-					continue;
-				}
-			}
-			it++;
+			i++;
 		}
 	}
 
-	void DebugManager::Render(std::shared_ptr<sf::RenderTexture> target)
+	void DebugManager::Render(sf::RenderTarget& target)
 	{
-		for (auto& cmd : m_Commands)
+		for (const auto& cmd : m_TimedCommands)
+			AppendCommand(m_FrameGeometry, cmd);
+
+		if (sf::VertexBuffer::isAvailable())
 		{
-			sf::Color sfColor(
-				(cmd.color.r),
-				(cmd.color.g),
-				(cmd.color.b),
-				(cmd.color.a)
-			);
-
-			switch (cmd.type)
-			{
-			case DebugDrawCommand::Type::Line:
+			if (m_PersistentDirty)
 			{
-				sf::VertexArray lines(sf::PrimitiveType::Lines, 2);
-				lines[0].position = sf::Vector2f(cmd.p1.x, cmd.p1.y);
-				lines[1].position = sf::Vector2f(cmd.p2.x, cmd.p2.y);
-				lines[0].color = sfColor;
-				lines[1].color = sfColor;
-				target->draw(lines);
-				break;
-			}
-			case DebugDrawCommand::Type::Circle:
-			{
-				sf::CircleShape circle(cmd.radius);
-				circle.setPosition(sf::Vector2f(cmd.p1.x - cmd.radius, cmd.p1.y - cmd.radius));
-				circle.setFillColor(sf::Color::Transparent);
-				circle.setOutlineColor(sfColor);
-				circle.setOutlineThickness(4.0f);
-				target->draw(circle);
-				break;
-			}
+				if (m_PersistentLines.create(m_PersistentGeometry.lines.size()) && !m_PersistentGeometry.lines.empty())
+					m_PersistentLines.update(m_PersistentGeometry.lines.data());
 
-			case DebugDrawCommand::Type::Box:
-			{
-				sf::RectangleShape box(sf::Vector2f(cmd.p2.x * 2, cmd.p2.y * 2));
-				box.setPosition(sf::Vector2f(cmd.p1.x - cmd.p2.x, cmd.p1.y - cmd.p2.y));
-				box.setFillColor(sf::Color::Transparent);
-				box.setOutlineColor(sfColor);
-				box.setOutlineThickness(4.0f);
-				target->draw(box);
-				break;
-			}
-			default:
-				break;
+				if (m_PersistentTriangles.create(m_PersistentGeometry.triangles.size()) && !m_PersistentGeometry.triangles.empty())
+					m_PersistentTriangles.update(m_PersistentGeometry.triangles.data());
+
+				m_PersistentDirty = false;
 			}
 
-			cmd.rendered = true;
+			if (m_PersistentTriangles.getVertexCount() > 0)
+				target.draw(m_PersistentTriangles);
+
+			if (m_PersistentLines.getVertexCount() > 0)
+				target.draw(m_PersistentLines);
 		}
+		else
+		{
+			if (!m_PersistentGeometry.triangles.empty())
+				target.draw(m_PersistentGeometry.triangles.data(), m_PersistentGeometry.triangles.size(), sf::PrimitiveType::Triangles);
+
+			if (!m_PersistentGeometry.lines.empty())
+				target.draw(m_PersistentGeometry.lines.data(), m_PersistentGeometry.lines.size(), sf::PrimitiveType::Lines);
+		}
+
+		if (!m_FrameGeometry.triangles.empty())
+			target.draw(m_FrameGeometry.triangles.data(), m_FrameGeometry.triangles.size(), sf::PrimitiveType::Triangles);
+
+		if (!m_FrameGeometry.lines.empty())
+			target.draw(m_FrameGeometry.lines.data(), m_FrameGeometry.lines.size(), sf::PrimitiveType::Lines);
+
+		m_FrameGeometry.Clear();
 	}
+
 	void DebugManager::Clear()
 	{
-		m_Commands.clear();
+		m_TimedCommands.clear();
+		m_FrameGeometry.Clear();
+		ClearPersistent();
+	}
+
+	void DebugManager::ClearPersistent()
+	{
+		m_PersistentGeometry.Clear();
+		m_PersistentDirty = true;
+	}
+
+	void DebugManager::AppendCommand(DebugGeometry& geometry, const DebugDrawCommand& cmd)
+	{
+		switch (cmd.type)
+		{
+		case DebugDrawCommand::Type::Line:
+			AppendLine(geometry, { cmd.p1.x, cmd.p1.y }, { cmd.p2.x, cmd.p2.y }, cmd.color);
+			break;
+
+		case DebugDrawCommand::Type::Circle:
+			AppendCircle(geometry, { cmd.p1.x, cmd.p1.y }, cmd.radius, cmd.color, cmd.filled);
+			break;
+
+		case DebugDrawCommand::Type::Box:
+		{
+			sf::Vector2f corners[4] = {
+				{ cmd.p1.x - cmd.p2.x, cmd.p1.y - cmd.p2.y },
+				{ cmd.p1.x + cmd.p2.x, cmd.p1.y - cmd.p2.y },
+				{ cmd.p1.x + cmd.p2.x, cmd.p1.y + cmd.p2.y },
+				{ cmd.p1.x - cmd.p2.x, cmd.p1.y + cmd.p2.y }
+			};
+			AppendPolygon(geometry, corners, 4, cmd.color, cmd.filled);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	void DebugManager::AppendLine(DebugGeometry& geometry, const sf::Vector2f& p1, const sf::Vector2f& p2, const sf::Color& color)
+	{
+		geometry.lines.push_back({ p1, color });
+		geometry.lines.push_back({ p2, color });
+	}
+
+	void DebugManager::AppendCircle(DebugGeometry& geometry, const sf::Vector2f& center, float radius, const sf::Color& color, bool filled)
+	{
+		const auto& unitCircle = GetUnitCircle();
+
+		sf::Vector2f points[s_CircleSegments];
+		for (int i = 0; i < s_CircleSegments; i++)
+			points[i] = center + unitCircle[i] * radius;
+
+		AppendPolygon(geometry, points, s_CircleSegments, color, filled);
+	}
+
+	void DebugManager::AppendPolygon(DebugGeometry& geometry, const sf::Vector2f* points, int count, const sf::Color& color, bool filled)
+	{
+		if (count < 2)
+			return;
+
+		if (filled && count >= 3)
+		{
+			// Convex shapes only, fanned from the first point
+			for (int i = 1; i + 1 < count; i++)
+			{
+				geometry.triangles.push_back({ points[0], color });
+				geometry.triangles.push_back({ points[i], color });
+				geometry.triangles.push_back({ points[i + 1], color });
+			}
+			return;
+		}
+
+		for (int i = 0; i < count; i++)
+			AppendLine(geometry, points[i], points[(i + 1) % count], color);
 	}
 
 	void DebugManager::SetDebugDraw(b2WorldId worldId, float physicsScale, uint32_t viewportHeight, uint32_t viewportWidth)
@@ -173,19 +298,21 @@ namespace Luden
 		}
 	}
 
+	// Box2D output is rebuilt every frame, so the callbacks write straight into the frame vertex streams
+
 	void DebugManager::Box2DDrawPolygon(const b2Vec2* vertices, int vertexCount, b2HexColor color, void* context)
 	{
 		auto* ctx = static_cast<Box2DDebugContext*>(context);
-		sf::Color sfColor = ConvertColor(color);
 
+		sf::Vector2f points[B2_MAX_POLYGON_VERTICES];
+		vertexCount = std::min(vertexCount, (int)B2_MAX_POLYGON_VERTICES);
 		for (int i = 0; i < vertexCount; i++)
 		{
-			int next = (i + 1) % vertexCount;
-			glm::vec3 p1 = TransformB2Point(vertices[i], ctx);
-			glm::vec3 p2 = TransformB2Point(vertices[next], ctx);
-
-			Instance().DrawLine(p1, p2, sfColor, 0.0f);
+			glm::vec3 point = TransformB2Point(vertices[i], ctx);
+			points[i] = { point.x, point.y };
 		}
+
+		AppendPolygon(Instance().m_FrameGeometry, points, vertexCount, ConvertColor(color), false);
 	}
 
 	void DebugManager::Box2DDrawSolidPolygon(b2Transform transform, const b2Vec2* vertices, int vertexCount, float radius, b2HexColor color, void* context)
@@ -194,52 +321,42 @@ namespace Luden
 		sf::Color sfColor = ConvertColor(color);
 		sf::Color fillColor(sfColor.r, sfColor.g, sfColor.b, 100); 
 
+		sf::Vector2f points[B2_MAX_POLYGON_VERTICES];
+		vertexCount = std::min(vertexCount, (int)B2_MAX_POLYGON_VERTICES);
 		for (int i = 0; i < vertexCount; i++)
 		{
-			int next = (i + 1) % vertexCount;
-
-			b2Vec2 v1 = b2TransformPoint(transform, vertices[i]);
-			b2Vec2 v2 = b2TransformPoint(transform, vertices[next]);
-
-			glm::vec3 p1 = TransformB2Point(v1, ctx);
-			glm::vec3 p2 = TransformB2Point(v2, ctx);
-
-			Instance().DrawLine(p1, p2, sfColor, 0.0f);
+			glm::vec3 point = TransformB2Point(b2TransformPoint(transform, vertices[i]), ctx);
+			points[i] = { point.x, point.y };
 		}
 
-		// Center point
-		if (vertexCount > 0)
-		{
-			b2Vec2 center = b2TransformPoint(transform, b2Vec2{ 0, 0 });
-			glm::vec3 centerPos = TransformB2Point(center, ctx);
-			Instance().DrawCircle(centerPos, 2.0f, sf::Color::Red, 0.0f);
-		}
+		DebugGeometry& geometry = Instance().m_FrameGeometry;
+		AppendPolygon(geometry, points, vertexCount, fillColor, true);
+		AppendPolygon(geometry, points, vertexCount, sfColor, false);
 	}
 
 	void DebugManager::Box2DDrawCircle(b2Vec2 center, float radius, b2HexColor color, void* context)
 	{
 		auto* ctx = static_cast<Box2DDebugContext*>(context);
-		sf::Color sfColor = ConvertColor(color);
 
 		glm::vec3 centerPos = TransformB2Point(center, ctx);
-		Instance().DrawCircle(centerPos, radius * ctx->physicsScale, sfColor, 0.0f);
+		AppendCircle(Instance().m_FrameGeometry, { centerPos.x, centerPos.y }, radius * ctx->physicsScale, ConvertColor(color), false);
 	}
 
 	void DebugManager::Box2DDrawSolidCircle(b2Transform transform, float radius, b2HexColor color, void* context)
 	{
 		auto* ctx = static_cast<Box2DDebugContext*>(context);
 		sf::Color sfColor = ConvertColor(color);
+		sf::Color fillColor(sfColor.r, sfColor.g, sfColor.b, 100);
 
-		b2Vec2 center = b2TransformPoint(transform, b2Vec2{ 0, 0 });
-		glm::vec3 centerPos = TransformB2Point(center, ctx);
-
-		Instance().DrawCircle(centerPos, radius * ctx->physicsScale, sfColor, 0.0f);
+		glm::vec3 centerPos = TransformB2Point(transform.p, ctx);
+		sf::Vector2f center = { centerPos.x, centerPos.y };
 
-		b2Vec2 axis = b2RotateVector(transform.q, b2Vec2{ radius, 0 });
-		b2Vec2 endPoint = b2Add(center, axis);
-		glm::vec3 axisEnd = TransformB2Point(endPoint, ctx);
+		DebugGeometry& geometry = Instance().m_FrameGeometry;
+		AppendCircle(geometry, center, radius * ctx->physicsScale, fillColor, true);
+		AppendCircle(geometry, center, radius * ctx->physicsScale, sfColor, false);
 
-		Instance().DrawLine(centerPos, axisEnd, sf::Color::Red, 0.0f);
+		glm::vec3 axisEnd = TransformB2Point(b2Add(transform.p, b2RotateVector(transform.q, b2Vec2{ radius, 0 })), ctx);
+		AppendLine(geometry, center, { axisEnd.x, axisEnd.y }, sf::Color::Red);
 	}
 
 	void DebugManager::Box2DDrawSolidCapsule(b2Vec2 p1, b2Vec2 p2, float radius, b2HexColor color, void* context)
@@ -249,53 +366,62 @@ namespace Luden
 
 		glm::vec3 point1 = TransformB2Point(p1, ctx);
 		glm::vec3 point2 = TransformB2Point(p2, ctx);
+		float pixelRadius = radius * ctx->physicsScale;
+
+		// Sides are offset along the capsule normal
+		sf::Vector2f axis = { point2.x - point1.x, point2.y - point1.y };
+		float length = std::sqrt(axis.x * axis.x + axis.y * axis.y);
+		sf::Vector2f normal = length > 0.0f ? sf::Vector2f(-axis.y / length, axis.x / length) * pixelRadius : sf::Vector2f(pixelRadius, 0.0f);
 
-		// Draw line between centers
-		Instance().DrawLine({ point1.x - radius, point1.y, point1.z}, { point2.x - radius, point2.y, point2.z }, sfColor, 0.0f);
-		Instance().DrawLine({ point1.x + radius, point1.y, point1.z }, { point2.x + radius, point2.y, point2.z }, sfColor, 0.0f);
+		sf::Vector2f a = { point1.x, point1.y };
+		sf::Vector2f b = { point2.x, point2.y };
 
-		// Draw circles at ends
-		Instance().DrawCircle(point1, radius * ctx->physicsScale, sfColor, 0.0f);
-		Instance().DrawCircle(point2, radius * ctx->physicsScale, sfColor, 0.0f);
+		DebugGeometry& geometry = Instance().m_FrameGeometry;
+		AppendLine(geometry, a + normal, b + normal, sfColor);
+		AppendLine(geometry, a - normal, b - normal, sfColor);
+		AppendCircle(geometry, a, pixelRadius, sfColor, false);
+		AppendCircle(geometry, b, pixelRadius, sfColor, false);
 	}
 
 	void DebugManager::Box2DDrawLine(b2Vec2 p1, b2Vec2 p2, b2HexColor color, void* context)
 	{
 		auto* ctx = static_cast<Box2DDebugContext*>(context);
-		sf::Color sfColor = ConvertColor(color);
 
 		glm::vec3 point1 = TransformB2Point(p1, ctx);
 		glm::vec3 point2 = TransformB2Point(p2, ctx);
 
-		Instance().DrawLine(point1, point2, sfColor, 0.0f);
+		AppendLine(Instance().m_FrameGeometry, { point1.x, point1.y }, { point2.x, point2.y }, ConvertColor(color));
 	}
 
 	void DebugManager::Box2DDrawTransform(b2Transform transform, void* context)
 	{
 		auto* ctx = static_cast<Box2DDebugContext*>(context);
 
-		const float axisScale = 0.4f * ctx->physicsScale;
-		b2Vec2 origin = transform.p;
-
-		b2Vec2 xAxis = b2RotateVector(transform.q, b2Vec2{ axisScale, 0 });
-		b2Vec2 xEnd = b2Add(origin, xAxis);
-		glm::vec3 p1 = TransformB2Point(origin, ctx);
-		glm::vec3 p2 = TransformB2Point(xEnd, ctx);
-		Instance().DrawLine(p1, p2, sf::Color::Red, 0.0f);
+		const float axisScale = 0.4f;
+		glm::vec3 origin = TransformB2Point(transform.p, ctx);
+		glm::vec3 xEnd = TransformB2Point(b2Add(transform.p, b2RotateVector(transform.q, b2Vec2{ axisScale, 0 })), ctx);
+		glm::vec3 yEnd = TransformB2Point(b2Add(transform.p, b2RotateVector(transform.q, b2Vec2{ 0, axisScale })), ctx);
 
-		b2Vec2 yAxis = b2RotateVector(transform.q, b2Vec2{ 0, axisScale });
-		b2Vec2 yEnd = b2Add(origin, yAxis);
-		glm::vec3 p3 = TransformB2Point(yEnd, ctx);
-		Instance().DrawLine(p1, p3, sf::Color::Green, 0.0f);
+		DebugGeometry& geometry = Instance().m_FrameGeometry;
+		AppendLine(geometry, { origin.x, origin.y }, { xEnd.x, xEnd.y }, sf::Color::Red);
+		AppendLine(geometry, { origin.x, origin.y }, { yEnd.x, yEnd.y }, sf::Color::Green);
 	}
 
 	void DebugManager::Box2DDrawPoint(b2Vec2 p, float size, b2HexColor color, void* context)
 	{
 		auto* ctx = static_cast<Box2DDebugContext*>(context);
-		sf::Color sfColor = ConvertColor(color);
 
+		// Box2D gives the point size in pixels
 		glm::vec3 point = TransformB2Point(p, ctx);
-		Instance().DrawCircle(point, size * ctx->physicsScale, sfColor, 0.0f);
+		float half = size * 0.5f;
+		sf::Vector2f corners[4] = {
+			{ point.x - half, point.y - half },
+			{ point.x + half, point.y - half },
+			{ point.x + half, point.y + half },
+			{ point.x - half, point.y + half }
+		};
+
+		AppendPolygon(Instance().m_FrameGeometry, corners, 4, ConvertColor(color), true);
 	}
 
 	void DebugManager::Box2DDrawString(b2Vec2 p, const char* s, b2HexColor color, void* context)
@@ -308,8 +434,7 @@ namespace Luden
 		return sf::Color(
 			static_cast<uint8_t>((color >> 16) & 0xFF),
 			static_cast<uint8_t>((color >> 8) & 0xFF),
-			static_cast<uint8_t>(color & 0xFF),
-			static_cast<uint8_t>((color >> 24) & 0xFF)
+			static_cast<uint8_t>(color & 0xFF)
 		);
 	}
 
@@ -4,6 +4,9 @@
 #include "Project/Project.h"
 #include "Resource/ResourceManager.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace Luden
 {
 	template<typename T>
@@ -44,6 +47,7 @@ namespace Luden
 		if (Instance)
 		{
 			Instance->m_Entity = entity;
+			CollisionEvents = Instance->GetCollisionEvents();
 			Instance->OnCreate();
 		}
 	}
@@ -77,4 +81,95 @@ namespace Luden
 		script->GetDestroyFunc()(Instance);
 		Instance = nullptr; 
 	}
+
+	static int32_t FloorDiv(int32_t value, int32_t divisor)
+	{
+		return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+	}
+
+	uint16_t TilemapComponent::GetTile(int32_t x, int32_t y) const
+	{
+		int32_t chunkX = FloorDiv(x, TilemapChunk::Size);
+		int32_t chunkY = FloorDiv(y, TilemapChunk::Size);
+
+		auto it = Chunks.find(ChunkKey(chunkX, chunkY));
+		if (it == Chunks.end())
+			return 0;
+
+		int32_t localX = x - chunkX * TilemapChunk::Size;
+		int32_t localY = y - chunkY * TilemapChunk::Size;
+		return it->second.Tiles[localY * TilemapChunk::Size + localX];
+	}
+
+	void TilemapComponent::SetTile(int32_t x, int32_t y, uint16_t tile)
+	{
+		int32_t chunkX = FloorDiv(x, TilemapChunk::Size);
+		int32_t chunkY = FloorDiv(y, TilemapChunk::Size);
+		uint64_t key = ChunkKey(chunkX, chunkY);
+
+		auto it = Chunks.find(key);
+		if (it == Chunks.end())
+		{
+			if (tile == 0)
+				return;
+
+			it = Chunks.emplace(key, TilemapChunk()).first;
+		}
+
+		TilemapChunk& chunk = it->second;
+		int32_t localX = x - chunkX * TilemapChunk::Size;
+		int32_t localY = y - chunkY * TilemapChunk::Size;
+
+		uint16_t& current = chunk.Tiles[localY * TilemapChunk::Size + localX];
+		if (current == tile)
+			return;
+
+		if (current == 0)
+			chunk.TileCount++;
+		else if (tile == 0)
+			chunk.TileCount--;
+
+		current = tile;
+		chunk.Revision = ++Revision;
+
+		if (chunk.TileCount == 0)
+			Chunks.erase(it);
+	}
+
+	void TilemapComponent::Fill(int32_t x, int32_t y, int32_t width, int32_t height, uint16_t tile)
+	{
+		for (int32_t tileY = y; tileY < y + height; tileY++)
+		{
+			for (int32_t tileX = x; tileX < x + width; tileX++)
+				SetTile(tileX, tileY, tile);
+		}
+	}
+
+	void TilemapComponent::Clear()
+	{
+		Chunks.clear();
+		Revision++;
+	}
+
+	bool TilemapComponent::GetBounds(int32_t& outMinX, int32_t& outMinY, int32_t& outMaxX, int32_t& outMaxY) const
+	{
+		if (Chunks.empty())
+			return false;
+
+		outMinX = outMinY = std::numeric_limits<int32_t>::max();
+		outMaxX = outMaxY = std::numeric_limits<int32_t>::min();
+
+		for (const auto& [key, chunk] : Chunks)
+		{
+			int32_t chunkX = ChunkKeyX(key) * TilemapChunk::Size;
+			int32_t chunkY = ChunkKeyY(key) * TilemapChunk::Size;
+
+			outMinX = std::min(outMinX, chunkX);
+			outMinY = std::min(outMinY, chunkY);
+			outMaxX = std::max(outMaxX, chunkX + TilemapChunk::Size);
+			outMaxY = std::max(outMaxY, chunkY + TilemapChunk::Size);
+		}
+
+		return true;
+	}
 }
\ No newline at end of file
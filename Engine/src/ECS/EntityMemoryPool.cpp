@@ -115,6 +115,7 @@ namespace Luden
 		ClearComponentsAt(idx);
 
 		m_IdToIndex.erase(entityID);
+		m_IDs[idx] = 0;
 
 		m_FreeList.push_back(idx);
 
@@ -172,4 +173,23 @@ namespace Luden
 
 		return true;
 	}
+
+	EntityHandle EntityMemoryPool::GetHandle(const EntityID& entityID) const
+	{
+		PoolIndex idx = IndexOf(entityID);
+		return ((uint64_t)(uint32_t)(uint64_t)entityID << 32) | (uint64_t)(uint32_t)idx;
+	}
+
+	EntityID EntityMemoryPool::ResolveHandle(EntityHandle handle) const
+	{
+		PoolIndex idx = (PoolIndex)(uint32_t)handle;
+		if (idx >= m_IDs.size())
+			return 0;
+
+		const UUID& id = m_IDs[idx];
+		if ((uint64_t)id == 0 || (uint32_t)(uint64_t)id != (uint32_t)(handle >> 32))
+			return 0;
+
+		return id;
+	}
 }
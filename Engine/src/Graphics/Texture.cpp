@@ -1,6 +1,71 @@
 #include "Graphics/Texture.h"
+#include <algorithm>
 #include <iostream>
 
 namespace Luden
 {
-}
\ No newline at end of file
+	static const sf::BlendMode s_PremultipliedBlend(sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha);
+
+	const sf::BlendMode& Texture::GetBlendMode() const
+	{
+		return m_PremultipliedAlpha ? s_PremultipliedBlend : sf::BlendAlpha;
+	}
+
+	bool Texture::UploadPendingImage()
+	{
+		while (HasPendingRows())
+			UploadPendingRows(UINT64_MAX);
+
+		if (!m_PendingImage)
+			return !m_UploadFailed;
+
+		bool uploaded = m_Texture.loadFromImage(*m_PendingImage);
+		m_PendingImage.reset();
+		return uploaded;
+	}
+
+	void Texture::SetPendingPixels(sf::Vector2u size, std::vector<uint8_t> pixels)
+	{
+		m_PendingPixels = std::move(pixels);
+		SetPendingPixels(size, BufferView(m_PendingPixels.data(), m_PendingPixels.size()));
+	}
+
+	void Texture::SetPendingPixels(sf::Vector2u size, BufferView pixels)
+	{
+		m_PendingSize = size;
+		m_PendingView = pixels.Size > 0 ? pixels : BufferView();
+		m_UploadedRows = 0;
+		m_UploadFailed = false;
+	}
+
+	void Texture::ReleasePendingPixels()
+	{
+		std::vector<uint8_t>().swap(m_PendingPixels);
+		m_PendingView = BufferView();
+	}
+
+	uint64_t Texture::UploadPendingRows(uint64_t maxBytes)
+	{
+		if (!HasPendingRows())
+			return 0;
+
+		if (m_UploadedRows == 0 && !m_Texture.resize(m_PendingSize))
+		{
+			std::cerr << "[Texture] Could not create a " << m_PendingSize.x << "x" << m_PendingSize.y << " texture" << std::endl;
+			ReleasePendingPixels();
+			m_UploadFailed = true;
+			return 0;
+		}
+
+		uint64_t rowSize = (uint64_t)m_PendingSize.x * 4;
+		uint32_t rowCount = (uint32_t)std::clamp<uint64_t>(maxBytes / rowSize, 1, m_PendingSize.y - m_UploadedRows);
+
+		m_Texture.update((const uint8_t*)m_PendingView.Data + m_UploadedRows * rowSize, { m_PendingSize.x, rowCount }, { 0, m_UploadedRows });
+		m_UploadedRows += rowCount;
+
+		if (m_UploadedRows == m_PendingSize.y)
+			ReleasePendingPixels();
+
+		return rowCount * rowSize;
+	}
+}
@@ -0,0 +1,34 @@
+#include "Graphics/Tileset.h"
+#include "Graphics/Texture.h"
+#include "Resource/ResourceManager.h"
+
+namespace Luden
+{
+	std::shared_ptr<Texture> Tileset::GetTexture()
+	{
+		if (m_TextureHandle == 0)
+			return nullptr;
+
+		return ResourceManager::GetResource<Texture>(m_TextureHandle);
+	}
+
+	sf::IntRect Tileset::GetTileRect(uint32_t tileIndex) const
+	{
+		uint32_t columns = m_Columns > 0 ? m_Columns : 1;
+		uint32_t column = tileIndex % columns;
+		uint32_t row = tileIndex / columns;
+
+		return {
+			{ (int)(m_Margin + column * (m_TileSize.x + m_Spacing)), (int)(m_Margin + row * (m_TileSize.y + m_Spacing)) },
+			{ (int)m_TileSize.x, (int)m_TileSize.y }
+		};
+	}
+
+	void Tileset::SetTileSolid(uint32_t tileIndex, bool solid)
+	{
+		if (solid)
+			m_SolidTiles.insert(tileIndex);
+		else
+			m_SolidTiles.erase(tileIndex);
+	}
+}
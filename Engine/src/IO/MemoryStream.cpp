@@ -0,0 +1,62 @@
+#include "IO/MemoryStream.h"
+
+#include <cstring>
+
+namespace Luden
+{
+	//==============================================================================
+	/// MemoryStreamWriter
+	MemoryStreamWriter::MemoryStreamWriter(std::vector<uint8_t>& buffer)
+		: m_Buffer(buffer)
+	{
+		m_Buffer.clear();
+	}
+
+	bool MemoryStreamWriter::WriteData(const char* data, size_t size)
+	{
+		if (m_Position + size > m_Buffer.size())
+			m_Buffer.resize(m_Position + size);
+
+		memcpy(m_Buffer.data() + m_Position, data, size);
+		m_Position += size;
+		return true;
+	}
+
+	//==============================================================================
+	/// MemoryStreamReader
+	MemoryStreamReader::MemoryStreamReader(BufferView buffer)
+		: m_Buffer(buffer)
+	{
+	}
+
+	bool MemoryStreamReader::ReadData(char* destination, size_t size)
+	{
+		if (m_Position + size > m_Buffer.Size)
+		{
+			m_Good = false;
+			return false;
+		}
+
+		memcpy(destination, (const uint8_t*)m_Buffer.Data + m_Position, size);
+		m_Position += size;
+		return true;
+	}
+
+	bool MemoryStreamReader::ReadBufferView(BufferView& outView)
+	{
+		uint64_t size = 0;
+		if (!ReadData((char*)&size, sizeof(uint64_t)))
+			return false;
+
+		if (m_Position + size > m_Buffer.Size)
+		{
+			m_Good = false;
+			return false;
+		}
+
+		outView = m_Buffer.SubView(m_Position, size);
+		m_Position += size;
+		return true;
+	}
+
+}
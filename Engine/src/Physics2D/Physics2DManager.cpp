@@ -1,18 +1,305 @@
 #include "Physics2D/Physics2DManager.h"
+#include "Core/EngineContext.h"
 #include "ECS/Components/Components.h"
 #include "Debug/DebugManager.h"
 #include "Scene/Scene.h"
 #include "ECS/Entity.h"
+#include "Graphics/Tileset.h"
+#include "Resource/ResourceManager.h"
+#include "Scene/Prefab.h"
 #include "ScriptAPI/Physics2DAPI.h"
 #include "NativeScript/ScriptableEntity.h"
 
 #include <glm/trigonometric.hpp>
 #include <glm/common.hpp>
+#include <glm/vec2.hpp>
 #include <box2d/box2d.h>
 #include "Physics2D/CollisionContact.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace Luden
 {
+	struct TileOutline
+	{
+		std::vector<glm::ivec2> Points;
+		bool IsLoop = true;
+	};
+
+	// Traces the outline of the solid cells inside a grid (row-major, y down) whose outer ring holds the neighbouring
+	// cells. Loops are returned counter-clockwise in y-up space with the solid side on the left, so the outward
+	// normals of a one-sided Box2D chain face away from the solid tiles. Outlines that carry on into the ring come back
+	// open, with a ghost vertex at each end taken from the neighbouring outline so Box2D smooths over the seam.
+	// Vertices are in grid units.
+	static std::vector<TileOutline> TraceSolidOutlines(const std::vector<uint8_t>& solid, int32_t width, int32_t height)
+	{
+		struct Edge
+		{
+			glm::ivec2 Start;
+			glm::ivec2 End;
+			bool Used = false;
+		};
+
+		auto isSolid = [&](int32_t x, int32_t y)
+		{
+			return x >= 0 && y >= 0 && x < width && y < height && solid[y * width + x] != 0;
+		};
+
+		auto isInside = [&](int32_t x, int32_t y)
+		{
+			return x > 0 && y > 0 && x < width - 1 && y < height - 1;
+		};
+
+		auto vertexKey = [](const glm::ivec2& v)
+		{
+			return ((uint64_t)(uint32_t)v.x << 32) | (uint32_t)v.y;
+		};
+
+		auto appendCellEdges = [&](int32_t x, int32_t y, std::vector<Edge>& outEdges)
+		{
+			if (!isSolid(x, y))
+				return;
+
+			// Cell spans [x, x + 1] and [-(y + 1), -y] in y-up space
+			glm::ivec2 bottomLeft = { x, -(y + 1) };
+			glm::ivec2 bottomRight = { x + 1, -(y + 1) };
+			glm::ivec2 topRight = { x + 1, -y };
+			glm::ivec2 topLeft = { x, -y };
+
+			if (!isSolid(x, y + 1)) outEdges.push_back({ bottomLeft, bottomRight });
+			if (!isSolid(x + 1, y)) outEdges.push_back({ bottomRight, topRight });
+			if (!isSolid(x, y - 1)) outEdges.push_back({ topRight, topLeft });
+			if (!isSolid(x - 1, y)) outEdges.push_back({ topLeft, bottomLeft });
+		};
+
+		// Where two regions touch diagonally, turning left keeps us on the same region
+		auto turnRank = [](const glm::ivec2& direction, const glm::ivec2& nextDirection)
+		{
+			glm::ivec2 left = { -direction.y, direction.x };
+			return nextDirection == left ? 0 : (nextDirection == direction ? 1 : 2);
+		};
+
+		std::vector<Edge> edges;
+		for (int32_t y = 1; y < height - 1; y++)
+		{
+			for (int32_t x = 1; x < width - 1; x++)
+				appendCellEdges(x, y, edges);
+		}
+
+		std::unordered_map<uint64_t, std::vector<size_t>> outgoing;
+		std::unordered_map<uint64_t, int32_t> incomingCount;
+		outgoing.reserve(edges.size());
+		for (size_t i = 0; i < edges.size(); i++)
+		{
+			outgoing[vertexKey(edges[i].Start)].push_back(i);
+			incomingCount[vertexKey(edges[i].End)]++;
+		}
+
+		// Loops stop once they get back to their first edge, open outlines where no unused edge goes on
+		auto followEdges = [&](size_t first, bool isLoop, std::vector<glm::ivec2>& outPoints)
+		{
+			size_t current = first;
+			while (!edges[current].Used)
+			{
+				Edge& edge = edges[current];
+				edge.Used = true;
+				outPoints.push_back(edge.Start);
+
+				glm::ivec2 direction = edge.End - edge.Start;
+				size_t next = current;
+				int bestRank = 3;
+				for (size_t candidate : outgoing[vertexKey(edge.End)])
+				{
+					if (edges[candidate].Used && !(isLoop && candidate == first))
+						continue;
+
+					int rank = turnRank(direction, edges[candidate].End - edges[candidate].Start);
+					if (rank < bestRank)
+					{
+						bestRank = rank;
+						next = candidate;
+					}
+				}
+
+				if (next == current)
+				{
+					outPoints.push_back(edge.End);
+					return;
+				}
+
+				current = next;
+			}
+		};
+
+		// Edges of the ring cells around a vertex, where the open outlines continue
+		auto findGhostVertex = [&](const glm::ivec2& vertex, const glm::ivec2& direction, bool before)
+		{
+			std::vector<Edge> ringEdges;
+			for (int32_t y = -vertex.y - 1; y <= -vertex.y; y++)
+			{
+				for (int32_t x = vertex.x - 1; x <= vertex.x; x++)
+				{
+					if (!isInside(x, y))
+						appendCellEdges(x, y, ringEdges);
+				}
+			}
+
+			glm::ivec2 ghost = before ? vertex - direction : vertex + direction;
+			int bestRank = 3;
+			for (const Edge& edge : ringEdges)
+			{
+				if ((before ? edge.End : edge.Start) != vertex)
+					continue;
+
+				glm::ivec2 edgeDirection = edge.End - edge.Start;
+				int rank = before ? turnRank(edgeDirection, direction) : turnRank(direction, edgeDirection);
+				if (rank < bestRank)
+				{
+					bestRank = rank;
+					ghost = before ? edge.Start : edge.End;
+				}
+			}
+			return ghost;
+		};
+
+		// Merge collinear runs into single segments
+		auto simplify = [](const std::vector<glm::ivec2>& points, bool isLoop)
+		{
+			std::vector<glm::ivec2> simplified;
+			for (size_t i = 0; i < points.size(); i++)
+			{
+				if (!isLoop && (i == 0 || i == points.size() - 1))
+				{
+					simplified.push_back(points[i]);
+					continue;
+				}
+
+				const glm::ivec2& previous = points[(i + points.size() - 1) % points.size()];
+				const glm::ivec2& point = points[i];
+				const glm::ivec2& next = points[(i + 1) % points.size()];
+
+				glm::ivec2 a = point - previous;
+				glm::ivec2 b = next - point;
+				if (a.x * b.y - a.y * b.x != 0)
+					simplified.push_back(point);
+			}
+			return simplified;
+		};
+
+		std::vector<TileOutline> outlines;
+
+		// Open outlines start where more edges leave a vertex than reach it, which only happens on the ring
+		for (size_t first = 0; first < edges.size(); first++)
+		{
+			uint64_t startKey = vertexKey(edges[first].Start);
+			if (edges[first].Used || incomingCount[startKey] >= (int32_t)outgoing[startKey].size())
+				continue;
+
+			std::vector<glm::ivec2> points;
+			followEdges(first, false, points);
+			if (points.size() < 2)
+				continue;
+
+			TileOutline outline;
+			outline.IsLoop = false;
+			outline.Points.push_back(findGhostVertex(points.front(), points[1] - points[0], true));
+			for (const glm::ivec2& point : simplify(points, false))
+				outline.Points.push_back(point);
+			outline.Points.push_back(findGhostVertex(points.back(), points.back() - points[points.size() - 2], false));
+			outlines.push_back(std::move(outline));
+		}
+
+		for (size_t first = 0; first < edges.size(); first++)
+		{
+			if (edges[first].Used)
+				continue;
+
+			std::vector<glm::ivec2> points;
+			followEdges(first, true, points);
+
+			TileOutline outline;
+			outline.Points = simplify(points, true);
+			if (outline.Points.size() >= 4)
+				outlines.push_back(std::move(outline));
+		}
+
+		return outlines;
+	}
+
+	// Material, filter and sensor settings shared by the solid collider components
+	template<typename T>
+	static b2ShapeDef MakeColliderShapeDef(const T& collider)
+	{
+		b2ShapeDef shapeDef = b2DefaultShapeDef();
+		shapeDef.density = collider.Density;
+		shapeDef.material.friction = collider.Friction;
+		shapeDef.material.restitution = collider.Restitution;
+		shapeDef.filter = { collider.CategoryBits, collider.MaskBits, collider.GroupIndex };
+		shapeDef.isSensor = collider.IsSensor;
+		return shapeDef;
+	}
+
+	// Everything a collider contributes to a body template, the collision events are applied per instance
+	template<typename T>
+	static bool HasSameMaterial(const T& a, const T& b)
+	{
+		return a.Offset == b.Offset && a.Density == b.Density && a.Friction == b.Friction && a.Restitution == b.Restitution
+			&& a.CategoryBits == b.CategoryBits && a.MaskBits == b.MaskBits && a.GroupIndex == b.GroupIndex && a.IsSensor == b.IsSensor;
+	}
+
+	static bool HasSameShape(const BoxCollider2DComponent& a, const BoxCollider2DComponent& b)
+	{
+		return HasSameMaterial(a, b) && a.Size == b.Size;
+	}
+
+	static bool HasSameShape(const CircleCollider2DComponent& a, const CircleCollider2DComponent& b)
+	{
+		return HasSameMaterial(a, b) && a.Radius == b.Radius;
+	}
+
+	static bool HasSameShape(const CapsuleCollider2DComponent& a, const CapsuleCollider2DComponent& b)
+	{
+		return HasSameMaterial(a, b) && a.Height == b.Height && a.Radius == b.Radius && a.Horizontal == b.Horizontal;
+	}
+
+	static bool HasSameShape(const PolygonCollider2DComponent& a, const PolygonCollider2DComponent& b)
+	{
+		return HasSameMaterial(a, b) && a.Points == b.Points && a.Radius == b.Radius;
+	}
+
+	template<typename T>
+	static bool HasSameCollider(Entity a, Entity b)
+	{
+		if (a.Has<T>() != b.Has<T>())
+			return false;
+
+		return !a.Has<T>() || HasSameShape(a.Get<T>(), b.Get<T>());
+	}
+
+	// Whether a body template built from source fits entity. Chains are always built per instance
+	static bool HasSameBody(Entity entity, Entity source)
+	{
+		if (!source.Has<RigidBody2DComponent>())
+			return false;
+
+		const auto& a = entity.Get<RigidBody2DComponent>();
+		const auto& b = source.Get<RigidBody2DComponent>();
+		if (a.BodyType != b.BodyType || a.FixedRotation != b.FixedRotation || a.LinearDrag != b.LinearDrag
+			|| a.AngularDrag != b.AngularDrag || a.GravityScale != b.GravityScale || a.IsBullet != b.IsBullet)
+			return false;
+
+		return HasSameCollider<BoxCollider2DComponent>(entity, source)
+			&& HasSameCollider<CircleCollider2DComponent>(entity, source)
+			&& HasSameCollider<CapsuleCollider2DComponent>(entity, source)
+			&& HasSameCollider<PolygonCollider2DComponent>(entity, source);
+	}
+
 	void Physics2DManager::Init(Scene* scene, uint32_t viewportWidth, uint32_t viewportHeight)
 	{
 		m_Scene = scene;
@@ -22,316 +309,1083 @@ namespace Luden
 		if (m_Scene == nullptr)
 			return;
 
-		//TODO: Fix this hacky solution to update the entitiesToAdd
-		m_Scene->GetEntityManager().Update(TimeStep(0.0f));
-
 		b2WorldDef worldDef = b2DefaultWorldDef();
 		worldDef.gravity = m_Gravity;
+		worldDef.enableContinuous = m_ContinuousEnabled;
+		worldDef.workerCount = std::min((int)GEngine.GetJobSystem().GetWorkerCount(), B2_MAX_WORKERS);
+		worldDef.enqueueTask = EnqueueTask;
+		worldDef.finishTask = FinishTask;
+		worldDef.userTaskContext = this;
 		m_PhysicsWorldId = b2CreateWorld(&worldDef);
-		int bodyCount = 0;
 
 		if (!b2World_IsValid(m_PhysicsWorldId))
 			return;
 
+		// Entities created this frame are still waiting in the manager's add list
+		for (auto& entity : m_Scene->GetEntityManager().GetEntities())
+			RegisterEntity(entity);
+
+		for (auto& entity : m_Scene->GetEntityManager().GetPendingEntities())
+			RegisterEntity(entity);
+
+		FlushPendingBodies();
+
+		DebugManager::Instance().SetDebugDraw(m_PhysicsWorldId, m_PhysicsScale, m_ViewportHeight, m_ViewportWidth);
+	}
+
+	void Physics2DManager::Update(TimeStep ts)
+	{
+		if (!b2World_IsValid(m_PhysicsWorldId))
+			return;
+
+		if (m_Scene == nullptr)
+			return;
+
+		FlushPendingBodies();
+
+		m_TaskCount = 0;
+		b2World_Step(m_PhysicsWorldId, static_cast<float>(ts), m_SubStepCount);
+
 		for (auto& entity : m_Scene->GetEntityManager().GetEntities())
 		{
-			if (entity.Has<RigidBody2DComponent>() && entity.Has<TransformComponent>())
+			if (entity.Has<TilemapComponent>())
 			{
-				auto& rb2d = entity.Get<RigidBody2DComponent>();
-				auto& transformComponent = entity.Get<TransformComponent>();
+				auto& tilemap = entity.Get<TilemapComponent>();
+				if (tilemap.Revision != tilemap.RuntimeColliderRevision)
+					UpdateTilemapBody(entity);
+			}
+		}
 
-				b2BodyDef bodyDef = b2DefaultBodyDef();
+		SyncMovedBodies();
 
-				if (rb2d.BodyType == RigidBody2DComponent::Type::Static)
-					bodyDef.type = b2_staticBody;
-				else if (rb2d.BodyType == RigidBody2DComponent::Type::Kinematic)
-					bodyDef.type = b2_kinematicBody;
-				else if (rb2d.BodyType == RigidBody2DComponent::Type::Dynamic)
-					bodyDef.type = b2_dynamicBody;
+		ProcessContactEvents();
 
-				bodyDef.position = b2Vec2(
-					transformComponent.Translation.x / m_PhysicsScale,
-					(m_ViewportHeight - transformComponent.Translation.y) / m_PhysicsScale
-				);
-				bodyDef.rotation = b2MakeRot(glm::radians(transformComponent.angle));
+		b2Profile profile = b2World_GetProfile(m_PhysicsWorldId);
+		b2Counters counters = b2World_GetCounters(m_PhysicsWorldId);
+		m_StepStats.StepTime = profile.step;
+		m_StepStats.CollideTime = profile.collide;
+		m_StepStats.SolveTime = profile.solve;
+		m_StepStats.BulletTime = profile.bullets;
+		m_StepStats.SubStepCount = m_SubStepCount;
+		m_StepStats.BodyCount = counters.bodyCount;
+		m_StepStats.ContactCount = counters.contactCount;
+	}
 
-				if (rb2d.FixedRotation)
-				{
-					bodyDef.motionLocks.angularZ = true;
-				}
+	void Physics2DManager::SetContinuousEnabled(bool enabled)
+	{
+		m_ContinuousEnabled = enabled;
+
+		if (b2World_IsValid(m_PhysicsWorldId))
+			b2World_EnableContinuous(m_PhysicsWorldId, enabled);
+	}
+	
+	void Physics2DManager::SyncMovedBodies()
+	{
+		for (const EntityID& entityID : m_MovedEntities)
+		{
+			if (EntityMemoryPool::Instance().Exists(entityID) && EntityMemoryPool::Instance().HasComponent<TransformComponent>(entityID))
+				EntityMemoryPool::Instance().GetComponent<TransformComponent>(entityID).Dirty = false;
+		}
+		m_MovedEntities.clear();
+		m_StepIndex++;
+
+		// Only awake bodies that moved during the step are reported, static and sleeping bodies cost nothing
+		b2BodyEvents events = b2World_GetBodyEvents(m_PhysicsWorldId);
+		m_StepStats.MovedBodyCount = events.moveCount;
+		m_StepStats.BulletBodyCount = 0;
+		for (int i = 0; i < events.moveCount; i++)
+		{
+			const b2BodyMoveEvent& moveEvent = events.moveEvents[i];
+			if (b2Body_IsBullet(moveEvent.bodyId))
+				m_StepStats.BulletBodyCount++;
+
+			Entity entity = m_Scene->FindEntityByUserData(moveEvent.userData);
+			if (!entity.IsValid() || !entity.Has<TransformComponent>())
+				continue;
+
+			auto& transform = entity.Get<TransformComponent>();
+
+			glm::vec2 position = {
+				moveEvent.transform.p.x * m_PhysicsScale,
+				m_ViewportHeight - (moveEvent.transform.p.y * m_PhysicsScale)
+			};
+			float angle = glm::degrees(b2Rot_GetAngle(moveEvent.transform.q));
+
+			auto [it, inserted] = m_Interpolation.try_emplace(entity.UUID());
+			BodyInterpolation& state = it->second;
+			if (inserted)
+			{
+				// The body was resting, its transform still holds the last simulated state
+				state.CurrentPosition = { transform.Translation.x, transform.Translation.y };
+				state.CurrentAngle = transform.angle;
+			}
+
+			state.PreviousPosition = state.CurrentPosition;
+			state.PreviousAngle = state.CurrentAngle;
+			state.CurrentPosition = position;
+			state.CurrentAngle = angle;
+			state.LastStep = m_StepIndex;
+
+			transform.Translation.x = position.x;
+			transform.Translation.y = position.y;
+			transform.angle = angle;
+			transform.Dirty = true;
+
+			// Drawn at the new pose until the scene blends it
+			transform.RenderTranslation = position;
+			transform.RenderAngle = angle;
+			transform.Interpolated = true;
+
+			m_MovedEntities.push_back(entity.UUID());
+		}
+
+		// Bodies that stopped moving settle on their last state
+		for (auto it = m_Interpolation.begin(); it != m_Interpolation.end();)
+		{
+			if (it->second.LastStep == m_StepIndex)
+			{
+				++it;
+				continue;
+			}
+
+			if (EntityMemoryPool::Instance().Exists(it->first) && EntityMemoryPool::Instance().HasComponent<TransformComponent>(it->first))
+				EntityMemoryPool::Instance().GetComponent<TransformComponent>(it->first).Interpolated = false;
+
+			it = m_Interpolation.erase(it);
+		}
+	}
+
+	void Physics2DManager::InterpolateTransforms(float alpha)
+	{
+		alpha = std::clamp(alpha, 0.0f, 1.0f);
+
+		for (const auto& [entityID, state] : m_Interpolation)
+		{
+			if (!EntityMemoryPool::Instance().Exists(entityID) || !EntityMemoryPool::Instance().HasComponent<TransformComponent>(entityID))
+				continue;
+
+			auto& transform = EntityMemoryPool::Instance().GetComponent<TransformComponent>(entityID);
+
+			// Shortest way around so a body crossing +-180 degrees does not spin back
+			float deltaAngle = std::remainder(state.CurrentAngle - state.PreviousAngle, 360.0f);
+
+			transform.RenderTranslation = state.PreviousPosition + (state.CurrentPosition - state.PreviousPosition) * alpha;
+			transform.RenderAngle = state.PreviousAngle + deltaAngle * alpha;
+		}
+	}
+
+	void Physics2DManager::ResetInterpolation()
+	{
+		while (!m_Interpolation.empty())
+			StopInterpolation(m_Interpolation.begin()->first);
+	}
+
+	void Physics2DManager::StopInterpolation(const UUID& entityID)
+	{
+		if (EntityMemoryPool::Instance().Exists(entityID) && EntityMemoryPool::Instance().HasComponent<TransformComponent>(entityID))
+			EntityMemoryPool::Instance().GetComponent<TransformComponent>(entityID).Interpolated = false;
+
+		m_Interpolation.erase(entityID);
+	}
+
+	bool Physics2DManager::SaveBodyState(Entity entity, PhysicsBodyState& outState) const
+	{
+		if (!entity.Has<RigidBody2DComponent>())
+			return false;
+
+		b2BodyId bodyId = entity.Get<RigidBody2DComponent>().RuntimeBodyId;
+		if (!b2Body_IsValid(bodyId))
+			return false;
+
+		b2Transform transform = b2Body_GetTransform(bodyId);
+		outState.Position = transform.p;
+		outState.Rotation = transform.q;
+		outState.LinearVelocity = b2Body_GetLinearVelocity(bodyId);
+		outState.AngularVelocity = b2Body_GetAngularVelocity(bodyId);
+		outState.Awake = b2Body_IsAwake(bodyId) ? 1 : 0;
+		return true;
+	}
+
+	void Physics2DManager::RestoreBodyState(Entity entity, const PhysicsBodyState& state)
+	{
+		if (!entity.Has<RigidBody2DComponent>())
+			return;
+
+		b2BodyId bodyId = entity.Get<RigidBody2DComponent>().RuntimeBodyId;
+		if (!b2Body_IsValid(bodyId))
+			return;
+
+		b2Body_SetTransform(bodyId, state.Position, state.Rotation);
+		b2Body_SetLinearVelocity(bodyId, state.LinearVelocity);
+		b2Body_SetAngularVelocity(bodyId, state.AngularVelocity);
+		b2Body_SetAwake(bodyId, state.Awake != 0);
+
+		if (entity.Has<TransformComponent>())
+		{
+			auto& transform = entity.Get<TransformComponent>();
+			transform.Translation.x = state.Position.x * m_PhysicsScale;
+			transform.Translation.y = m_ViewportHeight - (state.Position.y * m_PhysicsScale);
+			transform.angle = glm::degrees(b2Rot_GetAngle(state.Rotation));
+		}
+
+		StopInterpolation(entity.UUID());
+	}
+
+	void Physics2DManager::Shutdown()
+	{
+		if (b2World_IsValid(m_PhysicsWorldId))
+		{
+			b2DestroyWorld(m_PhysicsWorldId);
+			m_PhysicsWorldId = b2_nullWorldId;
+		}
+
+		m_MovedEntities.clear();
+		ResetInterpolation();
+		m_PendingBodies.clear();
+		m_PrefabTemplates.clear();
+		m_StepStats = PhysicsStepStats();
+
+		if (m_Scene == nullptr)
+			return;
+
+		for (auto& e : m_Scene->GetEntityManager().GetEntities())
+		{
+			if (e.Has<RigidBody2DComponent>())
+			{
+				e.Get<RigidBody2DComponent>().RuntimeBodyId = b2_nullBodyId;
+			}
+
+			if (e.Has<TilemapComponent>())
+			{
+				e.Get<TilemapComponent>().RuntimeBodyId = b2_nullBodyId;
+				e.Get<TilemapComponent>().RuntimeChunkColliders.clear();
+			}
+		}
+	}
+
+	void Physics2DManager::RegisterEntity(Entity entity)
+	{
+		if (!b2World_IsValid(m_PhysicsWorldId) || !entity.IsValid())
+			return;
+
+		if (!entity.Has<TransformComponent>() || (!entity.Has<RigidBody2DComponent>() && !entity.Has<TilemapComponent>()))
+			return;
+
+		m_PendingBodies.push_back(entity);
+	}
+
+	void Physics2DManager::FlushPendingBodies()
+	{
+		if (m_PendingBodies.empty())
+			return;
+
+		for (Entity entity : m_PendingBodies)
+		{
+			// Destroyed before its body was created
+			if (!EntityMemoryPool::Instance().Exists(entity.UUID()) || !entity.Has<TransformComponent>())
+				continue;
 
-				bodyDef.linearDamping = rb2d.LinearDrag;
-				bodyDef.angularDamping = rb2d.AngularDrag;
-				bodyDef.gravityScale = rb2d.GravityScale;
+			if (entity.Has<TilemapComponent>())
+			{
+				auto& tilemap = entity.Get<TilemapComponent>();
+				if (!b2Body_IsValid(tilemap.RuntimeBodyId) || tilemap.Revision != tilemap.RuntimeColliderRevision)
+					CreateTilemapBody(entity);
+			}
+
+			if (!entity.Has<RigidBody2DComponent>())
+				continue;
+
+			// Queued more than once (spawn and explicit register), the body already exists
+			if (b2Body_IsValid(entity.Get<RigidBody2DComponent>().RuntimeBodyId))
+				continue;
+
+			BodyTemplate scratch;
+			CreateBody(entity, GetBodyTemplate(entity, scratch));
+		}
+
+		m_PendingBodies.clear();
+	}
+
+	const Physics2DManager::BodyTemplate& Physics2DManager::GetBodyTemplate(Entity entity, BodyTemplate& scratch)
+	{
+		glm::vec2 scale = { entity.Get<TransformComponent>().Scale.x, entity.Get<TransformComponent>().Scale.y };
+
+		// Only the root of a prefab instance points back at itself, children are built every time
+		ResourceHandle prefabHandle = 0;
+		if (entity.Has<PrefabComponent>() && entity.Get<PrefabComponent>().EntityID == entity.UUID())
+			prefabHandle = entity.Get<PrefabComponent>().PrefabID;
+
+		if (prefabHandle != 0)
+		{
+			auto it = m_PrefabTemplates.find(prefabHandle);
+			if (it == m_PrefabTemplates.end() || it->second.Scale != scale)
+			{
+				// Built from the prefab itself rather than from whichever instance is flushed first
+				std::shared_ptr<Prefab> prefab = ResourceManager::GetResource<Prefab>(prefabHandle);
+				Entity prefabRoot = prefab ? prefab->GetRootEntity() : Entity();
+
+				if (prefabRoot.Has<RigidBody2DComponent>())
+					it = m_PrefabTemplates.insert_or_assign(prefabHandle, BuildBodyTemplate(prefabRoot, scale)).first;
+				else
+					it = m_PrefabTemplates.end();
+			}
+
+			// Scripts can change the body or its colliders before the flush, such instances get their own definitions
+			if (it != m_PrefabTemplates.end() && HasSameBody(entity, it->second.Source))
+				return it->second;
+		}
+
+		scratch = BuildBodyTemplate(entity, scale);
+		return scratch;
+	}
+
+	Physics2DManager::BodyTemplate Physics2DManager::BuildBodyTemplate(Entity source, glm::vec2 scale) const
+	{
+		BodyTemplate bodyTemplate;
+		bodyTemplate.Scale = scale;
+		bodyTemplate.Source = source;
+
+		bodyTemplate.BodyDef = b2DefaultBodyDef();
+		ApplyBodyProperties(source.Get<RigidBody2DComponent>(), bodyTemplate.BodyDef);
+
+		if (source.Has<BoxCollider2DComponent>())
+		{
+			auto& bc2d = source.Get<BoxCollider2DComponent>();
+
+			bodyTemplate.HasBox = true;
+			bodyTemplate.Box = MakeBoxGeometry(bc2d, bodyTemplate.Scale);
+			bodyTemplate.BoxShapeDef = MakeColliderShapeDef(bc2d);
+		}
+
+		if (source.Has<CircleCollider2DComponent>())
+		{
+			auto& cc2d = source.Get<CircleCollider2DComponent>();
+
+			bodyTemplate.HasCircle = true;
+			bodyTemplate.Circle = MakeCircleGeometry(cc2d, bodyTemplate.Scale);
+			bodyTemplate.CircleShapeDef = MakeColliderShapeDef(cc2d);
+		}
+
+		if (source.Has<CapsuleCollider2DComponent>())
+		{
+			auto& cc2d = source.Get<CapsuleCollider2DComponent>();
+
+			bodyTemplate.HasCapsule = true;
+			bodyTemplate.Capsule = MakeCapsuleGeometry(cc2d, bodyTemplate.Scale);
+			bodyTemplate.CapsuleShapeDef = MakeColliderShapeDef(cc2d);
+		}
+
+		if (source.Has<PolygonCollider2DComponent>())
+		{
+			auto& pc2d = source.Get<PolygonCollider2DComponent>();
+
+			bodyTemplate.HasPolygon = MakePolygonGeometry(pc2d, bodyTemplate.Scale, bodyTemplate.Polygon);
+			bodyTemplate.PolygonShapeDef = MakeColliderShapeDef(pc2d);
+
+			if (!bodyTemplate.HasPolygon)
+				std::cerr << "[Physics2DManager] Polygon collider of " << source.Tag() << " needs at least 3 points that are not collinear" << std::endl;
+		}
+
+		return bodyTemplate;
+	}
+
+	void Physics2DManager::CreateBody(Entity entity, const BodyTemplate& bodyTemplate)
+	{
+		auto& rb2d = entity.Get<RigidBody2DComponent>();
+		auto& transformComponent = entity.Get<TransformComponent>();
+		void* userData = MakeUserData(entity.UUID());
+
+		// Only the placement and the owner differ between instances of the same template
+		b2BodyDef bodyDef = bodyTemplate.BodyDef;
+		bodyDef.position = b2Vec2(
+			transformComponent.Translation.x / m_PhysicsScale,
+			(m_ViewportHeight - transformComponent.Translation.y) / m_PhysicsScale
+		);
+		bodyDef.rotation = b2MakeRot(glm::radians(transformComponent.angle));
+		bodyDef.userData = userData;
+		rb2d.RuntimeBodyId = b2CreateBody(m_PhysicsWorldId, &bodyDef);
+
+		if (bodyTemplate.HasBox && entity.Has<BoxCollider2DComponent>())
+		{
+			b2ShapeDef shapeDef = bodyTemplate.BoxShapeDef;
+			shapeDef.userData = userData;
+			ApplyCollisionEvents(shapeDef, GetShapeCollisionEvents(entity, entity.Get<BoxCollider2DComponent>().CollisionEvents));
+			shapeDef.enableSensorEvents = EnablesSensorEvents(shapeDef.isSensor, entity.Get<BoxCollider2DComponent>().CollisionEvents);
+			entity.Get<BoxCollider2DComponent>().RuntimeShapeId = b2CreatePolygonShape(rb2d.RuntimeBodyId, &shapeDef, &bodyTemplate.Box);
+		}
+
+		if (bodyTemplate.HasCircle && entity.Has<CircleCollider2DComponent>())
+		{
+			b2ShapeDef shapeDef = bodyTemplate.CircleShapeDef;
+			shapeDef.userData = userData;
+			ApplyCollisionEvents(shapeDef, GetShapeCollisionEvents(entity, entity.Get<CircleCollider2DComponent>().CollisionEvents));
+			shapeDef.enableSensorEvents = EnablesSensorEvents(shapeDef.isSensor, entity.Get<CircleCollider2DComponent>().CollisionEvents);
+			entity.Get<CircleCollider2DComponent>().RuntimeShapeId = b2CreateCircleShape(rb2d.RuntimeBodyId, &shapeDef, &bodyTemplate.Circle);
+		}
+
+		if (bodyTemplate.HasCapsule && entity.Has<CapsuleCollider2DComponent>())
+		{
+			b2ShapeDef shapeDef = bodyTemplate.CapsuleShapeDef;
+			shapeDef.userData = userData;
+			ApplyCollisionEvents(shapeDef, GetShapeCollisionEvents(entity, entity.Get<CapsuleCollider2DComponent>().CollisionEvents));
+			shapeDef.enableSensorEvents = EnablesSensorEvents(shapeDef.isSensor, entity.Get<CapsuleCollider2DComponent>().CollisionEvents);
+			entity.Get<CapsuleCollider2DComponent>().RuntimeShapeId = b2CreateCapsuleShape(rb2d.RuntimeBodyId, &shapeDef, &bodyTemplate.Capsule);
+		}
+
+		if (bodyTemplate.HasPolygon && entity.Has<PolygonCollider2DComponent>())
+		{
+			b2ShapeDef shapeDef = bodyTemplate.PolygonShapeDef;
+			shapeDef.userData = userData;
+			ApplyCollisionEvents(shapeDef, GetShapeCollisionEvents(entity, entity.Get<PolygonCollider2DComponent>().CollisionEvents));
+			shapeDef.enableSensorEvents = EnablesSensorEvents(shapeDef.isSensor, entity.Get<PolygonCollider2DComponent>().CollisionEvents);
+			entity.Get<PolygonCollider2DComponent>().RuntimeShapeId = b2CreatePolygonShape(rb2d.RuntimeBodyId, &shapeDef, &bodyTemplate.Polygon);
+		}
+
+		if (entity.Has<ChainCollider2DComponent>())
+			CreateChainShapes(entity, rb2d.RuntimeBodyId);
+	}
+
+	void Physics2DManager::ApplyBodyProperties(const RigidBody2DComponent& rb2d, b2BodyDef& bodyDef)
+	{
+		if (rb2d.BodyType == RigidBody2DComponent::Type::Static)
+			bodyDef.type = b2_staticBody;
+		else if (rb2d.BodyType == RigidBody2DComponent::Type::Kinematic)
+			bodyDef.type = b2_kinematicBody;
+		else if (rb2d.BodyType == RigidBody2DComponent::Type::Dynamic)
+			bodyDef.type = b2_dynamicBody;
+
+		bodyDef.motionLocks.angularZ = rb2d.FixedRotation;
+		bodyDef.linearDamping = rb2d.LinearDrag;
+		bodyDef.angularDamping = rb2d.AngularDrag;
+		bodyDef.gravityScale = rb2d.GravityScale;
+		bodyDef.isBullet = rb2d.IsBullet;
+	}
+
+	b2Polygon Physics2DManager::MakeBoxGeometry(const BoxCollider2DComponent& bc2d, glm::vec2 scale) const
+	{
+		b2Vec2 centerOffset = {
+			bc2d.Offset.x / m_PhysicsScale,
+			bc2d.Offset.y / m_PhysicsScale
+		};
+
+		return b2MakeOffsetBox(
+			(bc2d.Size.x * scale.x) / (2.0f * m_PhysicsScale),
+			(bc2d.Size.y * scale.y) / (2.0f * m_PhysicsScale),
+			centerOffset,
+			b2MakeRot(0.0f)
+		);
+	}
+
+	b2Circle Physics2DManager::MakeCircleGeometry(const CircleCollider2DComponent& cc2d, glm::vec2 scale) const
+	{
+		return b2Circle{
+			{ cc2d.Offset.x / m_PhysicsScale, cc2d.Offset.y / m_PhysicsScale },
+			(cc2d.Radius * glm::max(scale.x, scale.y)) / m_PhysicsScale
+		};
+	}
+
+	b2Capsule Physics2DManager::MakeCapsuleGeometry(const CapsuleCollider2DComponent& cc2d, glm::vec2 scale) const
+	{
+		b2Vec2 center = { cc2d.Offset.x / m_PhysicsScale, cc2d.Offset.y / m_PhysicsScale };
+		float radius = (cc2d.Radius * glm::max(scale.x, scale.y)) / m_PhysicsScale;
+		float length = (cc2d.Height * (cc2d.Horizontal ? scale.x : scale.y)) / m_PhysicsScale;
+
+		// Box2D needs the two centers apart, a capsule shorter than its caps becomes a near circle
+		float halfSegment = glm::max(length * 0.5f - radius, 0.005f);
+		b2Vec2 axis = cc2d.Horizontal ? b2Vec2{ halfSegment, 0.0f } : b2Vec2{ 0.0f, halfSegment };
+
+		return b2Capsule{ b2Sub(center, axis), b2Add(center, axis), radius };
+	}
+
+	bool Physics2DManager::MakePolygonGeometry(const PolygonCollider2DComponent& pc2d, glm::vec2 scale, b2Polygon& outPolygon) const
+	{
+		b2Vec2 points[B2_MAX_POLYGON_VERTICES];
+		int count = std::min((int)pc2d.Points.size(), B2_MAX_POLYGON_VERTICES);
+
+		for (int i = 0; i < count; i++)
+		{
+			points[i] = {
+				(pc2d.Offset.x + pc2d.Points[i].x * scale.x) / m_PhysicsScale,
+				(pc2d.Offset.y + pc2d.Points[i].y * scale.y) / m_PhysicsScale
+			};
+		}
+
+		// Empty when there are fewer than 3 points or they are collinear
+		b2Hull hull = b2ComputeHull(points, count);
+		if (hull.count == 0)
+			return false;
+
+		outPolygon = b2MakePolygon(&hull, pc2d.Radius / m_PhysicsScale);
+		return true;
+	}
+
+	void Physics2DManager::CreateChainShapes(Entity entity, b2BodyId bodyId)
+	{
+		auto& chain = entity.Get<ChainCollider2DComponent>();
+		auto& transformComponent = entity.Get<TransformComponent>();
+
+		chain.RuntimeChainId = b2_nullChainId;
+		chain.RuntimeSegmentIds.clear();
+
+		if (chain.Points.size() < 2)
+			return;
+
+		std::vector<b2Vec2> points;
+		points.reserve(chain.Points.size());
+		for (const glm::vec2& point : chain.Points)
+		{
+			points.push_back({
+				point.x * transformComponent.Scale.x / m_PhysicsScale,
+				point.y * transformComponent.Scale.y / m_PhysicsScale
+			});
+		}
+
+		b2SurfaceMaterial material = b2DefaultSurfaceMaterial();
+		material.friction = chain.Friction;
+		material.restitution = chain.Restitution;
+
+		b2Filter filter = { chain.CategoryBits, chain.MaskBits, chain.GroupIndex };
+		void* userData = MakeUserData(entity.UUID());
+
+		if (points.size() >= 4)
+		{
+			b2ChainDef chainDef = b2DefaultChainDef();
+			chainDef.points = points.data();
+			chainDef.count = (int)points.size();
+			chainDef.isLoop = chain.Loop;
+			chainDef.materials = &material;
+			chainDef.materialCount = 1;
+			chainDef.filter = filter;
+			chainDef.userData = userData;
+			chainDef.enableSensorEvents = true;
+
+			chain.RuntimeChainId = b2CreateChain(bodyId, &chainDef);
+			return;
+		}
+
+		// Box2D chains need 4 points, shorter outlines are plain segments
+		b2ShapeDef shapeDef = b2DefaultShapeDef();
+		shapeDef.material = material;
+		shapeDef.filter = filter;
+		shapeDef.userData = userData;
+		shapeDef.enableSensorEvents = true;
+		shapeDef.updateBodyMass = false;
+
+		size_t segmentCount = (chain.Loop && points.size() > 2) ? points.size() : points.size() - 1;
+		for (size_t i = 0; i < segmentCount; i++)
+		{
+			b2Segment segment = { points[i], points[(i + 1) % points.size()] };
+			chain.RuntimeSegmentIds.push_back(b2CreateSegmentShape(bodyId, &shapeDef, &segment));
+		}
+	}
+
+	void Physics2DManager::DestroyChainShapes(ChainCollider2DComponent& chain)
+	{
+		if (b2Chain_IsValid(chain.RuntimeChainId))
+			b2DestroyChain(chain.RuntimeChainId);
+
+		for (b2ShapeId shapeId : chain.RuntimeSegmentIds)
+		{
+			if (b2Shape_IsValid(shapeId))
+				b2DestroyShape(shapeId, false);
+		}
+
+		chain.RuntimeChainId = b2_nullChainId;
+		chain.RuntimeSegmentIds.clear();
+	}
+
+	void Physics2DManager::UnregisterEntity(Entity entity)
+	{
+		if (!b2World_IsValid(m_PhysicsWorldId))
+			return;
+
+		std::erase_if(m_PendingBodies, [&entity](const Entity& pending) { return pending.UUID() == entity.UUID(); });
+
+		if (entity.Has<TilemapComponent>())
+			DestroyTilemapBody(entity);
+
+		if (!entity.Has<RigidBody2DComponent>())
+			return;
+
+		auto& rb2d = entity.Get<RigidBody2DComponent>();
+		StopInterpolation(entity.UUID());
+
+		if (b2Body_IsValid(rb2d.RuntimeBodyId))
+		{
+			b2DestroyBody(rb2d.RuntimeBodyId);
+			rb2d.RuntimeBodyId = b2_nullBodyId;
+		}
+
+		if (entity.Has<BoxCollider2DComponent>())
+		{
+			entity.Get<BoxCollider2DComponent>().RuntimeShapeId = b2_nullShapeId;
+		}
+
+		if (entity.Has<CircleCollider2DComponent>())
+		{
+			entity.Get<CircleCollider2DComponent>().RuntimeShapeId = b2_nullShapeId;
+		}
+
+		if (entity.Has<CapsuleCollider2DComponent>())
+		{
+			entity.Get<CapsuleCollider2DComponent>().RuntimeShapeId = b2_nullShapeId;
+		}
+
+		if (entity.Has<PolygonCollider2DComponent>())
+		{
+			entity.Get<PolygonCollider2DComponent>().RuntimeShapeId = b2_nullShapeId;
+		}
+
+		if (entity.Has<ChainCollider2DComponent>())
+		{
+			auto& chain = entity.Get<ChainCollider2DComponent>();
+			chain.RuntimeChainId = b2_nullChainId;
+			chain.RuntimeSegmentIds.clear();
+		}
+	}
+
+	void Physics2DManager::UpdateEntityPhysics(Entity entity)
+	{
+		if (!b2World_IsValid(m_PhysicsWorldId) || !entity.IsValid())
+			return;
+
+		// Settings or transform changed, the whole tilemap body is rebuilt on the next step
+		if (entity.Has<TilemapComponent>())
+		{
+			DestroyTilemapBody(entity);
+			entity.Get<TilemapComponent>().Revision++;
+		}
+
+		if (!entity.Has<RigidBody2DComponent>() || !entity.Has<TransformComponent>())
+		{
+			UnregisterEntity(entity);
+			return;
+		}
 
-				bodyDef.userData = (void*)(uintptr_t)entity.UUID();
-				rb2d.RuntimeBodyId = b2CreateBody(m_PhysicsWorldId, &bodyDef);
+		auto& rb2d = entity.Get<RigidBody2DComponent>();
+		b2BodyId bodyId = rb2d.RuntimeBodyId;
+
+		if (!b2Body_IsValid(bodyId))
+		{
+			RegisterEntity(entity);
+			return;
+		}
+
+		// Patch the live body and shapes in place so contacts, velocities and sleep state survive the edit
+		b2BodyDef bodyDef = b2DefaultBodyDef();
+		ApplyBodyProperties(rb2d, bodyDef);
 
-				if (entity.Has<BoxCollider2DComponent>())
+		if (b2Body_GetType(bodyId) != bodyDef.type)
+			b2Body_SetType(bodyId, bodyDef.type);
+
+		b2Body_SetMotionLocks(bodyId, bodyDef.motionLocks);
+		b2Body_SetLinearDamping(bodyId, bodyDef.linearDamping);
+		b2Body_SetAngularDamping(bodyId, bodyDef.angularDamping);
+		b2Body_SetGravityScale(bodyId, bodyDef.gravityScale);
+		b2Body_SetBullet(bodyId, bodyDef.isBullet);
+
+		auto& transformComponent = entity.Get<TransformComponent>();
+		glm::vec2 scale = { transformComponent.Scale.x, transformComponent.Scale.y };
+		void* userData = MakeUserData(entity.UUID());
+
+		// Sensor state is fixed when a shape is created, flipping it needs a new shape
+		auto keepShape = [](b2ShapeId& shapeId, bool isSensor)
+			{
+				if (b2Shape_IsValid(shapeId) && b2Shape_IsSensor(shapeId) != isSensor)
 				{
-					auto& bc2d = entity.Get<BoxCollider2DComponent>();
-					b2BodyId bodyId = rb2d.RuntimeBodyId;
+					b2DestroyShape(shapeId, false);
+					shapeId = b2_nullShapeId;
+				}
+				return b2Shape_IsValid(shapeId);
+			};
 
-					float halfWidth = (bc2d.Size.x * transformComponent.Scale.x) / (2.0f * m_PhysicsScale);
-					float halfHeight = (bc2d.Size.y * transformComponent.Scale.y) / (2.0f * m_PhysicsScale);
+		auto patchShape = [](b2ShapeId shapeId, const b2ShapeDef& shapeDef)
+			{
+				b2Shape_SetDensity(shapeId, shapeDef.density, false);
+				b2Shape_SetFriction(shapeId, shapeDef.material.friction);
+				b2Shape_SetRestitution(shapeId, shapeDef.material.restitution);
+				b2Shape_SetFilter(shapeId, shapeDef.filter);
+			};
 
-					b2Vec2 centerOffset = {
-						bc2d.Offset.x / m_PhysicsScale,
-						bc2d.Offset.y / m_PhysicsScale
-					};
+		auto newShapeDef = [&](const b2ShapeDef& colliderDef, uint8_t colliderEvents)
+			{
+				b2ShapeDef shapeDef = colliderDef;
+				shapeDef.userData = userData;
+				ApplyCollisionEvents(shapeDef, GetShapeCollisionEvents(entity, colliderEvents));
+				shapeDef.enableSensorEvents = EnablesSensorEvents(shapeDef.isSensor, colliderEvents);
+				shapeDef.updateBodyMass = false;
+				return shapeDef;
+			};
 
-					b2Rot localRotation = b2MakeRot(0.0f);
+		if (entity.Has<BoxCollider2DComponent>())
+		{
+			auto& bc2d = entity.Get<BoxCollider2DComponent>();
+			b2Polygon box = MakeBoxGeometry(bc2d, scale);
+			b2ShapeDef colliderDef = MakeColliderShapeDef(bc2d);
 
-					b2Polygon boxShape = b2MakeOffsetBox(
-						(bc2d.Size.x * transformComponent.Scale.x) / (2.0f * m_PhysicsScale),
-						(bc2d.Size.y * transformComponent.Scale.y) / (2.0f * m_PhysicsScale),
-						centerOffset,
-						localRotation
-					);
+			if (keepShape(bc2d.RuntimeShapeId, bc2d.IsSensor))
+			{
+				b2Shape_SetPolygon(bc2d.RuntimeShapeId, &box);
+				patchShape(bc2d.RuntimeShapeId, colliderDef);
+			}
+			else
+			{
+				b2ShapeDef shapeDef = newShapeDef(colliderDef, bc2d.CollisionEvents);
+				bc2d.RuntimeShapeId = b2CreatePolygonShape(bodyId, &shapeDef, &box);
+			}
+		}
 
-					b2ShapeDef shapeDef = b2DefaultShapeDef();
-					shapeDef.density = bc2d.Density;
-					shapeDef.material.friction = bc2d.Friction;
-					shapeDef.material.restitution = bc2d.Restitution;
+		if (entity.Has<CircleCollider2DComponent>())
+		{
+			auto& cc2d = entity.Get<CircleCollider2DComponent>();
+			b2Circle circle = MakeCircleGeometry(cc2d, scale);
+			b2ShapeDef colliderDef = MakeColliderShapeDef(cc2d);
+
+			if (keepShape(cc2d.RuntimeShapeId, cc2d.IsSensor))
+			{
+				b2Shape_SetCircle(cc2d.RuntimeShapeId, &circle);
+				patchShape(cc2d.RuntimeShapeId, colliderDef);
+			}
+			else
+			{
+				b2ShapeDef shapeDef = newShapeDef(colliderDef, cc2d.CollisionEvents);
+				cc2d.RuntimeShapeId = b2CreateCircleShape(bodyId, &shapeDef, &circle);
+			}
+		}
 
-					shapeDef.filter.categoryBits = bc2d.CategoryBits;
-					shapeDef.filter.maskBits = bc2d.MaskBits;
-					shapeDef.filter.groupIndex = bc2d.GroupIndex;
+		if (entity.Has<CapsuleCollider2DComponent>())
+		{
+			auto& cc2d = entity.Get<CapsuleCollider2DComponent>();
+			b2Capsule capsule = MakeCapsuleGeometry(cc2d, scale);
+			b2ShapeDef colliderDef = MakeColliderShapeDef(cc2d);
+
+			if (keepShape(cc2d.RuntimeShapeId, cc2d.IsSensor))
+			{
+				b2Shape_SetCapsule(cc2d.RuntimeShapeId, &capsule);
+				patchShape(cc2d.RuntimeShapeId, colliderDef);
+			}
+			else
+			{
+				b2ShapeDef shapeDef = newShapeDef(colliderDef, cc2d.CollisionEvents);
+				cc2d.RuntimeShapeId = b2CreateCapsuleShape(bodyId, &shapeDef, &capsule);
+			}
+		}
 
-					shapeDef.enableContactEvents = true; 
-					shapeDef.enableHitEvents = true;
+		if (entity.Has<PolygonCollider2DComponent>())
+		{
+			auto& pc2d = entity.Get<PolygonCollider2DComponent>();
+			b2ShapeDef colliderDef = MakeColliderShapeDef(pc2d);
 
-					bc2d.RuntimeShapeId = b2CreatePolygonShape(bodyId, &shapeDef, &boxShape);
+			// Keeps the last valid shape while the points are being edited
+			b2Polygon polygon;
+			if (MakePolygonGeometry(pc2d, scale, polygon))
+			{
+				if (keepShape(pc2d.RuntimeShapeId, pc2d.IsSensor))
+				{
+					b2Shape_SetPolygon(pc2d.RuntimeShapeId, &polygon);
+					patchShape(pc2d.RuntimeShapeId, colliderDef);
 				}
-
-				if (entity.Has<CircleCollider2DComponent>())
+				else
 				{
-					auto& cc2d = entity.Get<CircleCollider2DComponent>();
-					b2BodyId bodyId = rb2d.RuntimeBodyId;
+					b2ShapeDef shapeDef = newShapeDef(colliderDef, pc2d.CollisionEvents);
+					pc2d.RuntimeShapeId = b2CreatePolygonShape(bodyId, &shapeDef, &polygon);
+				}
+			}
+		}
 
-					float scale = glm::max(transformComponent.Scale.x, transformComponent.Scale.y);
+		if (entity.Has<ChainCollider2DComponent>())
+		{
+			auto& chain = entity.Get<ChainCollider2DComponent>();
+			DestroyChainShapes(chain);
+			CreateChainShapes(entity, bodyId);
+		}
 
-					b2Circle circle =
-					{
-						{ cc2d.Offset.x / m_PhysicsScale, cc2d.Offset.y / m_PhysicsScale },
-						(cc2d.Radius * scale) / m_PhysicsScale
-					};
+		UpdateCollisionEvents(entity);
+		b2Body_ApplyMassFromShapes(bodyId);
+	}
 
-					b2ShapeDef shapeDef = b2DefaultShapeDef();
+	void Physics2DManager::CreateTilemapBody(Entity entity)
+	{
+		DestroyTilemapBody(entity);
 
-					shapeDef.density = cc2d.Density;
-					shapeDef.material.friction = cc2d.Friction;
-					shapeDef.material.restitution = cc2d.Restitution;
+		auto& tilemap = entity.Get<TilemapComponent>();
+		auto& transformComponent = entity.Get<TransformComponent>();
+		tilemap.RuntimeColliderRevision = tilemap.Revision;
 
-					shapeDef.filter.categoryBits = cc2d.CategoryBits;
-					shapeDef.filter.maskBits = cc2d.MaskBits;
-					shapeDef.filter.groupIndex = cc2d.GroupIndex;
+		if (!tilemap.GenerateColliders || tilemap.Chunks.empty())
+			return;
 
-					shapeDef.enableContactEvents = true;
-					shapeDef.enableHitEvents = true;
+		auto tileset = ResourceManager::GetResource<Tileset>(tilemap.TilesetHandle);
+		if (!tileset || tileset->GetSolidTiles().empty())
+			return;
 
-					cc2d.RuntimeShapeId = b2CreateCircleShape(bodyId, &shapeDef, &circle);
-				}
-			}
-		}
+		b2BodyDef bodyDef = b2DefaultBodyDef();
+		bodyDef.type = b2_staticBody;
+		bodyDef.position = b2Vec2(
+			transformComponent.Translation.x / m_PhysicsScale,
+			(m_ViewportHeight - transformComponent.Translation.y) / m_PhysicsScale
+		);
+		bodyDef.rotation = b2MakeRot(glm::radians(transformComponent.angle));
+		bodyDef.userData = MakeUserData(entity.UUID());
+		tilemap.RuntimeBodyId = b2CreateBody(m_PhysicsWorldId, &bodyDef);
 
-		DebugManager::Instance().SetDebugDraw(m_PhysicsWorldId, m_PhysicsScale, m_ViewportHeight, m_ViewportWidth);
+		for (const auto& [key, chunk] : tilemap.Chunks)
+			CreateTilemapChunkChains(entity, *tileset, key);
 	}
 
-	void Physics2DManager::Update(TimeStep ts)
+	void Physics2DManager::UpdateTilemapBody(Entity entity)
 	{
-		if (!b2World_IsValid(m_PhysicsWorldId))
+		auto& tilemap = entity.Get<TilemapComponent>();
+		if (!b2Body_IsValid(tilemap.RuntimeBodyId))
+		{
+			CreateTilemapBody(entity);
 			return;
+		}
 
-		if (m_Scene == nullptr)
+		auto tileset = ResourceManager::GetResource<Tileset>(tilemap.TilesetHandle);
+		if (!tileset)
+		{
+			CreateTilemapBody(entity);
 			return;
+		}
 
-		b2World_Step(m_PhysicsWorldId, static_cast<float>(ts), m_SubStepCount);
+		tilemap.RuntimeColliderRevision = tilemap.Revision;
 
-		for (auto& entity : m_Scene->GetEntityManager().GetEntities())
-		{
-			if (entity.Has<RigidBody2DComponent>() && entity.Has<TransformComponent>())
+		// Painted, new and emptied chunks. Outlines along a chunk's border depend on its neighbours, so they are redone too
+		std::unordered_set<uint64_t> dirtyChunks;
+		auto markDirty = [&dirtyChunks](uint64_t key)
 			{
-				auto& rb2d = entity.Get<RigidBody2DComponent>();
-				auto& transform = entity.Get<TransformComponent>();
-				b2BodyId bodyId = rb2d.RuntimeBodyId;
-
-				if (b2Body_IsValid(bodyId))
+				int32_t chunkX = TilemapComponent::ChunkKeyX(key);
+				int32_t chunkY = TilemapComponent::ChunkKeyY(key);
+				for (int32_t y = chunkY - 1; y <= chunkY + 1; y++)
 				{
-					b2Vec2 position = b2Body_GetPosition(bodyId);
-					b2Rot rotation = b2Body_GetRotation(bodyId);
-
-					float angle = atan2f(rotation.s, rotation.c);
-
-					transform.Translation.x = position.x * m_PhysicsScale;
-					transform.Translation.y = m_ViewportHeight - (position.y * m_PhysicsScale);
-					transform.angle = glm::degrees(angle);
+					for (int32_t x = chunkX - 1; x <= chunkX + 1; x++)
+						dirtyChunks.insert(TilemapComponent::ChunkKey(x, y));
 				}
-			}
+			};
+
+		for (const auto& [key, chunk] : tilemap.Chunks)
+		{
+			auto it = tilemap.RuntimeChunkColliders.find(key);
+			if (it == tilemap.RuntimeChunkColliders.end() || it->second.Revision != chunk.Revision)
+				markDirty(key);
 		}
 
-		ProcessContactEvents();
-	}
-	
-	void Physics2DManager::Shutdown()
-	{
-		if (b2World_IsValid(m_PhysicsWorldId))
+		for (const auto& [key, collider] : tilemap.RuntimeChunkColliders)
 		{
-			b2DestroyWorld(m_PhysicsWorldId);
-			m_PhysicsWorldId = b2_nullWorldId;
+			if (!tilemap.Chunks.contains(key))
+				markDirty(key);
 		}
 
-		if (m_Scene == nullptr)
-			return;
+		for (uint64_t key : dirtyChunks)
+			CreateTilemapChunkChains(entity, *tileset, key);
+	}
 
-		for (auto& e : m_Scene->GetEntityManager().GetEntities())
+	void Physics2DManager::CreateTilemapChunkChains(Entity entity, const Tileset& tileset, uint64_t chunkKey)
+	{
+		auto& tilemap = entity.Get<TilemapComponent>();
+		auto& transformComponent = entity.Get<TransformComponent>();
+
+		auto colliderIt = tilemap.RuntimeChunkColliders.find(chunkKey);
+		if (colliderIt != tilemap.RuntimeChunkColliders.end())
 		{
-			if (e.Has<RigidBody2DComponent>())
+			for (b2ChainId chainId : colliderIt->second.Chains)
 			{
-				e.Get<RigidBody2DComponent>().RuntimeBodyId = b2_nullBodyId;
+				if (b2Chain_IsValid(chainId))
+					b2DestroyChain(chainId);
 			}
 		}
-	}
 
-	void Physics2DManager::RegisterEntity(Entity entity)
-	{
-		if (!b2World_IsValid(m_PhysicsWorldId))
+		auto chunkIt = tilemap.Chunks.find(chunkKey);
+		if (chunkIt == tilemap.Chunks.end())
+		{
+			if (colliderIt != tilemap.RuntimeChunkColliders.end())
+				tilemap.RuntimeChunkColliders.erase(colliderIt);
 			return;
+		}
 
-		if (!entity.Has<RigidBody2DComponent>() || !entity.Has<TransformComponent>())
-			return;
+		auto& collider = tilemap.RuntimeChunkColliders[chunkKey];
+		collider.Revision = chunkIt->second.Revision;
+		collider.Chains.clear();
 
-		auto& rb2d = entity.Get<RigidBody2DComponent>();
-		auto& transformComponent = entity.Get<TransformComponent>();
+		// Solid mask of the chunk with a one tile ring of its neighbours' tiles
+		int32_t originX = TilemapComponent::ChunkKeyX(chunkKey) * TilemapChunk::Size;
+		int32_t originY = TilemapComponent::ChunkKeyY(chunkKey) * TilemapChunk::Size;
+		int32_t gridSize = TilemapChunk::Size + 2;
+		std::vector<uint8_t> solid((size_t)gridSize * gridSize, 0);
 
-		if (b2Body_IsValid(rb2d.RuntimeBodyId))
+		for (int32_t y = 0; y < gridSize; y++)
 		{
-			b2DestroyBody(rb2d.RuntimeBodyId);
-			rb2d.RuntimeBodyId = b2_nullBodyId;
+			for (int32_t x = 0; x < gridSize; x++)
+			{
+				uint16_t tile = tilemap.GetTile(originX + x - 1, originY + y - 1);
+				if (tile != 0 && tileset.IsTileSolid(tile - 1))
+					solid[(size_t)y * gridSize + x] = 1;
+			}
 		}
 
-		b2BodyDef bodyDef = b2DefaultBodyDef();
+		std::vector<TileOutline> outlines = TraceSolidOutlines(solid, gridSize, gridSize);
+		if (outlines.empty())
+			return;
 
-		if (rb2d.BodyType == RigidBody2DComponent::Type::Static)
-			bodyDef.type = b2_staticBody;
-		else if (rb2d.BodyType == RigidBody2DComponent::Type::Kinematic)
-			bodyDef.type = b2_kinematicBody;
-		else if (rb2d.BodyType == RigidBody2DComponent::Type::Dynamic)
-			bodyDef.type = b2_dynamicBody;
+		float tileWidth = tileset.GetTileSize().x * transformComponent.Scale.x / m_PhysicsScale;
+		float tileHeight = tileset.GetTileSize().y * transformComponent.Scale.y / m_PhysicsScale;
 
-		bodyDef.position = b2Vec2(
-			transformComponent.Translation.x / m_PhysicsScale,
-			(m_ViewportHeight - transformComponent.Translation.y) / m_PhysicsScale
-		);
-		bodyDef.rotation = b2MakeRot(glm::radians(transformComponent.angle));
+		b2SurfaceMaterial material = b2DefaultSurfaceMaterial();
+		material.friction = tilemap.Friction;
+		material.restitution = tilemap.Restitution;
 
-		if (rb2d.FixedRotation)
+		std::vector<b2Vec2> points;
+		for (const auto& outline : outlines)
 		{
-			bodyDef.motionLocks.angularZ = true;
-		}
+			// Grid x maps to tile column, grid -y maps to tile row (both offset by the ring)
+			points.clear();
+			for (const auto& vertex : outline.Points)
+			{
+				float tileX = (float)(vertex.x - 1 + originX);
+				float tileY = (float)(-vertex.y - 1 + originY);
+				points.push_back({ tileX * tileWidth, -tileY * tileHeight });
+			}
 
-		bodyDef.linearDamping = rb2d.LinearDrag;
-		bodyDef.angularDamping = rb2d.AngularDrag;
-		bodyDef.gravityScale = rb2d.GravityScale;
+			// Open chains use their first and last points as ghost vertices only
+			b2ChainDef chainDef = b2DefaultChainDef();
+			chainDef.points = points.data();
+			chainDef.count = (int)points.size();
+			chainDef.isLoop = outline.IsLoop;
+			chainDef.materials = &material;
+			chainDef.materialCount = 1;
+			chainDef.filter.categoryBits = tilemap.CategoryBits;
+			chainDef.filter.maskBits = tilemap.MaskBits;
+			chainDef.userData = MakeUserData(entity.UUID());
+
+			collider.Chains.push_back(b2CreateChain(tilemap.RuntimeBodyId, &chainDef));
+		}
+	}
 
-		bodyDef.userData = (void*)(uintptr_t)entity.UUID();
-		rb2d.RuntimeBodyId = b2CreateBody(m_PhysicsWorldId, &bodyDef);
+	void Physics2DManager::DestroyTilemapBody(Entity entity)
+	{
+		auto& tilemap = entity.Get<TilemapComponent>();
 
-		if (entity.Has<BoxCollider2DComponent>())
-		{
-			auto& bc2d = entity.Get<BoxCollider2DComponent>();
-			b2BodyId bodyId = rb2d.RuntimeBodyId;
+		if (b2Body_IsValid(tilemap.RuntimeBodyId))
+			b2DestroyBody(tilemap.RuntimeBodyId);
 
-			b2Vec2 centerOffset = {
-				bc2d.Offset.x / m_PhysicsScale,
-				bc2d.Offset.y / m_PhysicsScale
-			};
+		tilemap.RuntimeBodyId = b2_nullBodyId;
+		tilemap.RuntimeChunkColliders.clear();
+	}
 
-			b2Rot localRotation = b2MakeRot(0.0f);
+	void* Physics2DManager::MakeUserData(const EntityID& entityID)
+	{
+		if (!EntityMemoryPool::Instance().Exists(entityID))
+			return nullptr;
 
-			b2Polygon boxShape = b2MakeOffsetBox(
-				(bc2d.Size.x * transformComponent.Scale.x) / (2.0f * m_PhysicsScale),
-				(bc2d.Size.y * transformComponent.Scale.y) / (2.0f * m_PhysicsScale),
-				centerOffset,
-				localRotation
-			);
+		return (void*)(uintptr_t)EntityMemoryPool::Instance().GetHandle(entityID);
+	}
 
-			b2ShapeDef shapeDef = b2DefaultShapeDef();
-			shapeDef.density = bc2d.Density;
-			shapeDef.material.friction = bc2d.Friction;
-			shapeDef.material.restitution = bc2d.Restitution;
+	void* Physics2DManager::EnqueueTask(b2TaskCallback* task, int itemCount, int minRange, void* taskContext, void* userContext)
+	{
+		Physics2DManager* manager = static_cast<Physics2DManager*>(userContext);
+		JobSystem& jobSystem = GEngine.GetJobSystem();
 
-			shapeDef.filter.categoryBits = bc2d.CategoryBits;
-			shapeDef.filter.maskBits = bc2d.MaskBits;
-			shapeDef.filter.groupIndex = bc2d.GroupIndex;
+		// Single-item tasks still go to the pool: the solver enqueues one per worker and they sync with each other,
+		// running them inline would leave the first one solving every stage alone
+		int rangeCount = std::clamp(itemCount / std::max(minRange, 1), 1, (int)jobSystem.GetWorkerCount());
+		if (manager->m_TaskCount == s_MaxTasks || !jobSystem.IsRunning())
+		{
+			// Returning nullptr tells Box2D the task already ran and finishTask must not be called
+			task(0, itemCount, JobSystem::GetCurrentWorkerIndex(), taskContext);
+			return nullptr;
+		}
 
-			shapeDef.enableContactEvents = true;
-			shapeDef.enableHitEvents = true;
+		JobCounter& counter = manager->m_TaskCounters[manager->m_TaskCount++];
+		int rangeSize = (itemCount + rangeCount - 1) / rangeCount;
 
-			bc2d.RuntimeShapeId = b2CreatePolygonShape(bodyId, &shapeDef, &boxShape);
+		for (int begin = 0; begin < itemCount; begin += rangeSize)
+		{
+			int end = std::min(begin + rangeSize, itemCount);
+			jobSystem.Submit([task, begin, end, taskContext]()
+				{
+					task(begin, end, JobSystem::GetCurrentWorkerIndex(), taskContext);
+				}, &counter);
 		}
 
-		if (entity.Has<CircleCollider2DComponent>())
-		{
-			auto& cc2d = entity.Get<CircleCollider2DComponent>();
-			b2BodyId bodyId = rb2d.RuntimeBodyId;
+		return &counter;
+	}
 
-			float scale = glm::max(transformComponent.Scale.x, transformComponent.Scale.y);
+	void Physics2DManager::FinishTask(void* userTask, void* userContext)
+	{
+		GEngine.GetJobSystem().Wait(*static_cast<JobCounter*>(userTask));
+	}
 
-			b2Circle circle =
-			{
-				{ cc2d.Offset.x / m_PhysicsScale, cc2d.Offset.y / m_PhysicsScale },
-				(cc2d.Radius * scale) / m_PhysicsScale
-			};
+	PhysicsBenchmarkResult Physics2DManager::RunStepBenchmark(uint32_t bodyCount, uint32_t stepCount, int subStepCount)
+	{
+		PhysicsBenchmarkResult result;
+		result.BodyCount = bodyCount;
+		result.StepCount = stepCount;
 
-			b2ShapeDef shapeDef = b2DefaultShapeDef();
+		// Only owns the task counters of the world
+		auto taskContext = std::make_unique<Physics2DManager>();
 
-			shapeDef.density = cc2d.Density;
-			shapeDef.material.friction = cc2d.Friction;
-			shapeDef.material.restitution = cc2d.Restitution;
+		b2WorldDef worldDef = b2DefaultWorldDef();
+		worldDef.workerCount = std::min((int)GEngine.GetJobSystem().GetWorkerCount(), B2_MAX_WORKERS);
+		worldDef.enqueueTask = EnqueueTask;
+		worldDef.finishTask = FinishTask;
+		worldDef.userTaskContext = taskContext.get();
+		b2WorldId worldId = b2CreateWorld(&worldDef);
+		result.WorkerCount = worldDef.workerCount;
+
+		if (!b2World_IsValid(worldId))
+			return result;
+
+		// Boxes start in a grid above the ground and pile up, so the contact count grows during the run
+		uint32_t columnCount = std::max((uint32_t)std::sqrt((float)bodyCount), 1u);
+		float spacing = 1.2f;
+
+		b2ShapeDef shapeDef = b2DefaultShapeDef();
+		b2BodyDef groundDef = b2DefaultBodyDef();
+		b2BodyId groundId = b2CreateBody(worldId, &groundDef);
+		b2Polygon ground = b2MakeOffsetBox(columnCount * spacing + 10.0f, 1.0f, { 0.0f, -1.0f }, b2MakeRot(0.0f));
+		b2CreatePolygonShape(groundId, &shapeDef, &ground);
 
-			shapeDef.filter.categoryBits = cc2d.CategoryBits;
-			shapeDef.filter.maskBits = cc2d.MaskBits;
-			shapeDef.filter.groupIndex = cc2d.GroupIndex;
+		b2BodyDef bodyDef = b2DefaultBodyDef();
+		bodyDef.type = b2_dynamicBody;
+		b2Polygon box = b2MakeBox(0.5f, 0.5f);
 
-			shapeDef.enableContactEvents = true;
-			shapeDef.enableHitEvents = true;
+		for (uint32_t i = 0; i < bodyCount; i++)
+		{
+			bodyDef.position = {
+				((float)(i % columnCount) - columnCount * 0.5f) * spacing,
+				1.0f + (float)(i / columnCount) * spacing
+			};
 
-			cc2d.RuntimeShapeId = b2CreateCircleShape(bodyId, &shapeDef, &circle);
+			b2BodyId bodyId = b2CreateBody(worldId, &bodyDef);
+			b2CreatePolygonShape(bodyId, &shapeDef, &box);
 		}
-	}
 
-	void Physics2DManager::UnregisterEntity(Entity entity)
-	{
-		if (!b2World_IsValid(m_PhysicsWorldId))
-			return;
+		double totalStepTime = 0.0;
+		double totalSolveTime = 0.0;
 
-		if (!entity.Has<RigidBody2DComponent>())
-			return;
+		for (uint32_t step = 0; step < stepCount; step++)
+		{
+			taskContext->m_TaskCount = 0;
 
-		auto& rb2d = entity.Get<RigidBody2DComponent>();
+			auto start = std::chrono::steady_clock::now();
+			b2World_Step(worldId, 1.0f / 60.0f, std::max(subStepCount, 1));
+			float stepTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
 
-		if (b2Body_IsValid(rb2d.RuntimeBodyId))
-		{
-			b2DestroyBody(rb2d.RuntimeBodyId);
-			rb2d.RuntimeBodyId = b2_nullBodyId;
+			totalStepTime += stepTime;
+			totalSolveTime += b2World_GetProfile(worldId).solve;
+			result.MaxStepTime = std::max(result.MaxStepTime, stepTime);
 		}
 
-		if (entity.Has<BoxCollider2DComponent>())
-		{
-			entity.Get<BoxCollider2DComponent>().RuntimeShapeId = b2_nullShapeId;
-		}
+		b2DestroyWorld(worldId);
 
-		if (entity.Has<CircleCollider2DComponent>())
+		if (stepCount > 0)
 		{
-			entity.Get<CircleCollider2DComponent>().RuntimeShapeId = b2_nullShapeId;
+			result.AverageStepTime = (float)(totalStepTime / stepCount);
+			result.AverageSolveTime = (float)(totalSolveTime / stepCount);
 		}
-	}
 
-	void Physics2DManager::UpdateEntityPhysics(Entity entity)
-	{
-		UnregisterEntity(entity);
-		RegisterEntity(entity);
+		return result;
 	}
 
 	void Physics2DManager::SetGravity(b2Vec2 gravity)
@@ -347,8 +1401,14 @@ namespace Luden
 	void Physics2DManager::ProcessContactEvents()
 	{
 		b2ContactEvents events = b2World_GetContactEvents(m_PhysicsWorldId);
-		
-		// OnCollisionBegin logic
+
+		m_BeginDispatch.clear();
+		m_EndDispatch.clear();
+		m_HitDispatch.clear();
+		m_TriggerBeginDispatch.clear();
+		m_TriggerEndDispatch.clear();
+
+		// Collect first so scripts can destroy entities or bodies from their callbacks
 		for (int i = 0; i < events.beginCount; i++)
 		{
 			const b2ContactBeginTouchEvent& beginEvent = events.beginEvents[i];
@@ -359,128 +1419,62 @@ namespace Luden
 			if (!entityA.IsValid() || !entityB.IsValid())
 				continue;
 
+			bool notifyA = WantsCollisionEvent(entityA, CollisionEvent::Begin);
+			bool notifyB = WantsCollisionEvent(entityB, CollisionEvent::Begin);
+			if (!notifyA && !notifyB)
+				continue;
+
 			b2ContactData data = b2Contact_GetData(beginEvent.contactId);
 
-			CollisionContact contactForA;
-			contactForA.otherEntity = entityB;
-			contactForA.isTouching = true;
-
-			if (data.manifold.pointCount > 0)
-			{
-				contactForA.point = glm::vec2(
-					data.manifold.points[0].anchorA.x * m_PhysicsScale,
-					m_ViewportHeight - (data.manifold.points[0].anchorA.y * m_PhysicsScale)
-				);
-				contactForA.normal = glm::vec2(
-					data.manifold.normal.x,
-					-data.manifold.normal.y  // flip Y 
-				);
-				contactForA.normalImpulse = data.manifold.points[0].normalImpulse;
-				contactForA.tangentImpulse = data.manifold.points[0].tangentImpulse;
-			}
-			if(entityA.Has<NativeScriptComponent>())
+			if (notifyA)
 			{
-				auto& nsc = entityA.Get<NativeScriptComponent>();
-				if (nsc.Instance)
+				CollisionContact& contact = m_BeginDispatch.emplace_back(entityA).Contact;
+				contact.otherEntity = entityB;
+				contact.isTouching = true;
+
+				if (data.manifold.pointCount > 0)
 				{
-					nsc.Instance->OnCollisionBegin(contactForA);
+					contact.point = ToWorldPoint(data.manifold.points[0].anchorA);
+					contact.normal = glm::vec2(data.manifold.normal.x, -data.manifold.normal.y);
+					contact.normalImpulse = data.manifold.points[0].normalImpulse;
+					contact.tangentImpulse = data.manifold.points[0].tangentImpulse;
 				}
 			}
 
-			CollisionContact contactForB;
-			contactForB.otherEntity = entityA;
-			contactForB.isTouching = true;
-
-			if (data.manifold.pointCount > 0)
-			{
-				contactForB.point = glm::vec2(
-					data.manifold.points[0].anchorB.x * m_PhysicsScale,
-					m_ViewportHeight - (data.manifold.points[0].anchorB.y * m_PhysicsScale)
-				);
-				contactForB.normal = glm::vec2(
-					-data.manifold.normal.x,  // Flip for opposite direction
-					data.manifold.normal.y
-				);
-				contactForB.normalImpulse = data.manifold.points[0].normalImpulse;
-				contactForB.tangentImpulse = data.manifold.points[0].tangentImpulse;
-			}
-			if (entityB.Has<NativeScriptComponent>())
+			if (notifyB)
 			{
-				auto& nsc = entityB.Get<NativeScriptComponent>();
-				if (nsc.Instance)
+				CollisionContact& contact = m_BeginDispatch.emplace_back(entityB).Contact;
+				contact.otherEntity = entityA;
+				contact.isTouching = true;
+
+				if (data.manifold.pointCount > 0)
 				{
-					nsc.Instance->OnCollisionBegin(contactForB);
+					contact.point = ToWorldPoint(data.manifold.points[0].anchorB);
+					contact.normal = glm::vec2(-data.manifold.normal.x, data.manifold.normal.y);
+					contact.normalImpulse = data.manifold.points[0].normalImpulse;
+					contact.tangentImpulse = data.manifold.points[0].tangentImpulse;
 				}
 			}
 		}
 
-		// OnCollisionEnd logic
-		for (int i = 0; i < events.beginCount; i++)
+		// The contact is gone by now, only the pair is known
+		for (int i = 0; i < events.endCount; i++)
 		{
-			const b2ContactBeginTouchEvent& beginEvent = events.beginEvents[i];
+			const b2ContactEndTouchEvent& endEvent = events.endEvents[i];
 
-			Entity entityA = m_Scene->FindEntityByShapeId(beginEvent.shapeIdA);
-			Entity entityB = m_Scene->FindEntityByShapeId(beginEvent.shapeIdB);
+			Entity entityA = m_Scene->FindEntityByShapeId(endEvent.shapeIdA);
+			Entity entityB = m_Scene->FindEntityByShapeId(endEvent.shapeIdB);
 
 			if (!entityA.IsValid() || !entityB.IsValid())
 				continue;
 
-			b2ContactData data = b2Contact_GetData(beginEvent.contactId);
-
-			CollisionContact contactForA;
-			contactForA.otherEntity = entityB;
-			contactForA.isTouching = true;
-
-			if (data.manifold.pointCount > 0)
-			{
-				contactForA.point = glm::vec2(
-					data.manifold.points[0].anchorA.x * m_PhysicsScale,
-					m_ViewportHeight - (data.manifold.points[0].anchorA.y * m_PhysicsScale)
-				);
-				contactForA.normal = glm::vec2(
-					data.manifold.normal.x,
-					-data.manifold.normal.y  // flip Y 
-				);
-				contactForA.normalImpulse = data.manifold.points[0].normalImpulse;
-				contactForA.tangentImpulse = data.manifold.points[0].tangentImpulse;
-			}
-			if (entityA.Has<NativeScriptComponent>())
-			{
-				auto& nsc = entityA.Get<NativeScriptComponent>();
-				if (nsc.Instance)
-				{
-					nsc.Instance->OnCollisionBegin(contactForA);
-				}
-			}
+			if (WantsCollisionEvent(entityA, CollisionEvent::End))
+				m_EndDispatch.emplace_back(entityA).Contact.otherEntity = entityB;
 
-			CollisionContact contactForB;
-			contactForB.otherEntity = entityA;
-			contactForB.isTouching = true;
-
-			if (data.manifold.pointCount > 0)
-			{
-				contactForB.point = glm::vec2(
-					data.manifold.points[0].anchorB.x * m_PhysicsScale,
-					m_ViewportHeight - (data.manifold.points[0].anchorB.y * m_PhysicsScale)
-				);
-				contactForB.normal = glm::vec2(
-					-data.manifold.normal.x,  // Flip for opposite direction
-					data.manifold.normal.y
-				);
-				contactForB.normalImpulse = data.manifold.points[0].normalImpulse;
-				contactForB.tangentImpulse = data.manifold.points[0].tangentImpulse;
-			}
-			if (entityB.Has<NativeScriptComponent>())
-			{
-				auto& nsc = entityB.Get<NativeScriptComponent>();
-				if (nsc.Instance)
-				{
-					nsc.Instance->OnCollisionBegin(contactForB);
-				}
-			}
+			if (WantsCollisionEvent(entityB, CollisionEvent::End))
+				m_EndDispatch.emplace_back(entityB).Contact.otherEntity = entityA;
 		}
 
-		// OnCollisionHit
 		for (int i = 0; i < events.hitCount; i++)
 		{
 			const b2ContactHitEvent& hitEvent = events.hitEvents[i];
@@ -491,43 +1485,190 @@ namespace Luden
 			if (!entityA.IsValid() || !entityB.IsValid())
 				continue;
 
-			CollisionContact contactForA;
-			contactForA.otherEntity = entityB;
-			contactForA.point = glm::vec2(
-				hitEvent.point.x * m_PhysicsScale,
-				m_ViewportHeight - (hitEvent.point.y * m_PhysicsScale)
-			);
-			contactForA.normal = glm::vec2(
-				hitEvent.normal.x,
-				-hitEvent.normal.y
-			);
-			contactForA.approachSpeed = hitEvent.approachSpeed;
-			contactForA.isTouching = true;
-
-			if (entityA.Has<NativeScriptComponent>())
-			{
-				auto& nsc = entityA.Get<NativeScriptComponent>();
-				if (nsc.Instance)
-				{
-					nsc.Instance->OnCollisionHit(contactForA);
-				}
+			if (WantsCollisionEvent(entityA, CollisionEvent::Hit))
+			{
+				CollisionContact& contact = m_HitDispatch.emplace_back(entityA).Contact;
+				contact.otherEntity = entityB;
+				contact.point = ToWorldPoint(hitEvent.point);
+				contact.normal = glm::vec2(hitEvent.normal.x, -hitEvent.normal.y);
+				contact.approachSpeed = hitEvent.approachSpeed;
+				contact.isTouching = true;
 			}
 
-			CollisionContact contactForB;
-			contactForB.otherEntity = entityA;
-			contactForB.point = contactForA.point;
-			contactForB.normal = glm::vec2(-hitEvent.normal.x, hitEvent.normal.y);
-			contactForB.approachSpeed = hitEvent.approachSpeed;
-			contactForB.isTouching = true;
+			if (WantsCollisionEvent(entityB, CollisionEvent::Hit))
+			{
+				CollisionContact& contact = m_HitDispatch.emplace_back(entityB).Contact;
+				contact.otherEntity = entityA;
+				contact.point = ToWorldPoint(hitEvent.point);
+				contact.normal = glm::vec2(-hitEvent.normal.x, hitEvent.normal.y);
+				contact.approachSpeed = hitEvent.approachSpeed;
+				contact.isTouching = true;
+			}
+		}
+
+		// Sensors do not make contacts, their overlaps come through a separate event list
+		b2SensorEvents sensorEvents = b2World_GetSensorEvents(m_PhysicsWorldId);
 
-			if (entityB.Has<NativeScriptComponent>())
+		for (int i = 0; i < sensorEvents.beginCount; i++)
+		{
+			const b2SensorBeginTouchEvent& beginEvent = sensorEvents.beginEvents[i];
+
+			Entity sensorEntity = m_Scene->FindEntityByShapeId(beginEvent.sensorShapeId);
+			Entity visitorEntity = m_Scene->FindEntityByShapeId(beginEvent.visitorShapeId);
+
+			if (!sensorEntity.IsValid() || !visitorEntity.IsValid())
+				continue;
+
+			if (WantsCollisionEvent(sensorEntity, CollisionEvent::TriggerBegin))
 			{
-				auto& nsc = entityB.Get<NativeScriptComponent>();
-				if (nsc.Instance)
-				{
-					nsc.Instance->OnCollisionHit(contactForB);
-				}
+				CollisionContact& contact = m_TriggerBeginDispatch.emplace_back(sensorEntity).Contact;
+				contact.otherEntity = visitorEntity;
+				contact.isTouching = true;
+			}
+
+			if (WantsCollisionEvent(visitorEntity, CollisionEvent::TriggerBegin))
+			{
+				CollisionContact& contact = m_TriggerBeginDispatch.emplace_back(visitorEntity).Contact;
+				contact.otherEntity = sensorEntity;
+				contact.isTouching = true;
 			}
 		}
+
+		for (int i = 0; i < sensorEvents.endCount; i++)
+		{
+			const b2SensorEndTouchEvent& endEvent = sensorEvents.endEvents[i];
+
+			Entity sensorEntity = m_Scene->FindEntityByShapeId(endEvent.sensorShapeId);
+			Entity visitorEntity = m_Scene->FindEntityByShapeId(endEvent.visitorShapeId);
+
+			if (!sensorEntity.IsValid() || !visitorEntity.IsValid())
+				continue;
+
+			if (WantsCollisionEvent(sensorEntity, CollisionEvent::TriggerEnd))
+				m_TriggerEndDispatch.emplace_back(sensorEntity).Contact.otherEntity = visitorEntity;
+
+			if (WantsCollisionEvent(visitorEntity, CollisionEvent::TriggerEnd))
+				m_TriggerEndDispatch.emplace_back(visitorEntity).Contact.otherEntity = sensorEntity;
+		}
+
+		for (const CollisionDispatch& dispatch : m_BeginDispatch)
+		{
+			if (ScriptableEntity* script = GetLiveScript(dispatch.Target))
+				script->OnCollisionBegin(dispatch.Contact);
+		}
+
+		for (const CollisionDispatch& dispatch : m_EndDispatch)
+		{
+			if (ScriptableEntity* script = GetLiveScript(dispatch.Target))
+				script->OnCollisionEnd(dispatch.Contact);
+		}
+
+		for (const CollisionDispatch& dispatch : m_HitDispatch)
+		{
+			if (ScriptableEntity* script = GetLiveScript(dispatch.Target))
+				script->OnCollisionHit(dispatch.Contact);
+		}
+
+		for (const CollisionDispatch& dispatch : m_TriggerBeginDispatch)
+		{
+			if (ScriptableEntity* script = GetLiveScript(dispatch.Target))
+				script->OnTriggerBegin(dispatch.Contact);
+		}
+
+		for (const CollisionDispatch& dispatch : m_TriggerEndDispatch)
+		{
+			if (ScriptableEntity* script = GetLiveScript(dispatch.Target))
+				script->OnTriggerEnd(dispatch.Contact);
+		}
+	}
+
+	bool Physics2DManager::WantsCollisionEvent(Entity entity, CollisionEvent event)
+	{
+		if (!entity.Has<NativeScriptComponent>())
+			return false;
+
+		auto& nsc = entity.Get<NativeScriptComponent>();
+		return nsc.Instance != nullptr && HasCollisionEvent(nsc.CollisionEvents, event);
+	}
+
+	ScriptableEntity* Physics2DManager::GetLiveScript(Entity entity)
+	{
+		if (!EntityMemoryPool::Instance().Exists(entity.UUID()) || !entity.Has<NativeScriptComponent>())
+			return nullptr;
+
+		return entity.Get<NativeScriptComponent>().Instance;
+	}
+
+	uint8_t Physics2DManager::GetShapeCollisionEvents(Entity entity, uint8_t colliderEvents)
+	{
+		uint8_t scriptEvents = (uint8_t)CollisionEvent::None;
+		if (entity.Has<NativeScriptComponent>() && entity.Get<NativeScriptComponent>().Instance)
+			scriptEvents = entity.Get<NativeScriptComponent>().CollisionEvents;
+
+		return colliderEvents & scriptEvents;
+	}
+
+	void Physics2DManager::ApplyCollisionEvents(b2ShapeDef& shapeDef, uint8_t events)
+	{
+		// Box2D reports a pair when either shape asks for it, so a silent wall still reaches the bullet's script
+		shapeDef.enableContactEvents = HasCollisionEvent(events, CollisionEvent::Begin) || HasCollisionEvent(events, CollisionEvent::End);
+		shapeDef.enableHitEvents = HasCollisionEvent(events, CollisionEvent::Hit);
+	}
+
+	bool Physics2DManager::EnablesSensorEvents(bool isSensor, uint8_t colliderEvents)
+	{
+		// Any solid shape can be seen by sensors, a trigger zone often has no script and the visitor's script handles it
+		if (!isSensor)
+			return true;
+
+		return HasCollisionEvent(colliderEvents, CollisionEvent::TriggerBegin) || HasCollisionEvent(colliderEvents, CollisionEvent::TriggerEnd);
+	}
+
+	void Physics2DManager::UpdateCollisionEvents(Entity entity)
+	{
+		if (!b2World_IsValid(m_PhysicsWorldId) || !entity.IsValid())
+			return;
+
+		auto applyToShape = [&](b2ShapeId shapeId, uint8_t colliderEvents)
+			{
+				if (!b2Shape_IsValid(shapeId))
+					return;
+
+				b2ShapeDef shapeDef = b2DefaultShapeDef();
+				ApplyCollisionEvents(shapeDef, GetShapeCollisionEvents(entity, colliderEvents));
+
+				b2Shape_EnableContactEvents(shapeId, shapeDef.enableContactEvents);
+				b2Shape_EnableHitEvents(shapeId, shapeDef.enableHitEvents);
+				b2Shape_EnableSensorEvents(shapeId, EnablesSensorEvents(b2Shape_IsSensor(shapeId), colliderEvents));
+			};
+
+		if (entity.Has<BoxCollider2DComponent>())
+		{
+			auto& bc2d = entity.Get<BoxCollider2DComponent>();
+			applyToShape(bc2d.RuntimeShapeId, bc2d.CollisionEvents);
+		}
+
+		if (entity.Has<CircleCollider2DComponent>())
+		{
+			auto& cc2d = entity.Get<CircleCollider2DComponent>();
+			applyToShape(cc2d.RuntimeShapeId, cc2d.CollisionEvents);
+		}
+
+		if (entity.Has<CapsuleCollider2DComponent>())
+		{
+			auto& cc2d = entity.Get<CapsuleCollider2DComponent>();
+			applyToShape(cc2d.RuntimeShapeId, cc2d.CollisionEvents);
+		}
+
+		if (entity.Has<PolygonCollider2DComponent>())
+		{
+			auto& pc2d = entity.Get<PolygonCollider2DComponent>();
+			applyToShape(pc2d.RuntimeShapeId, pc2d.CollisionEvents);
+		}
+	}
+
+	glm::vec2 Physics2DManager::ToWorldPoint(b2Vec2 point) const
+	{
+		return glm::vec2(point.x * m_PhysicsScale, m_ViewportHeight - (point.y * m_PhysicsScale));
 	}
 }
\ No newline at end of file
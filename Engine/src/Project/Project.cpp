@@ -29,7 +29,9 @@ namespace Luden
 		if (s_ActiveProject)
 		{
 			s_ResourceManager = std::make_shared<RuntimeResourceManager>();
-			std::static_pointer_cast<RuntimeResourceManager>(s_ResourceManager)->SetResourcePack(resourcePack);
+			std::shared_ptr<RuntimeResourceManager> runtimeResourceManager = std::static_pointer_cast<RuntimeResourceManager>(s_ResourceManager);
+			runtimeResourceManager->SetResourcePack(resourcePack);
+			runtimeResourceManager->SetMemoryBudget(s_ActiveProject->GetConfig().ResourceMemoryBudget);
 		}
 	}
 }
@@ -23,6 +23,10 @@ namespace Luden
 		jProject["ResourceRegistry"] = config.ResourceRegistryPath;
 		jProject["StartScene"] = config.StartScene.string();
 		jProject["StartSceneHandle"] = static_cast<uint64_t>(config.StartSceneHandle);
+		jProject["ResourceMemoryBudget"] = config.ResourceMemoryBudget;
+		jProject["PackDecodedTextures"] = config.PackDecodedTextures;
+		jProject["GenerateTextureMipmaps"] = config.GenerateTextureMipmaps;
+		jProject["PremultiplyTextureAlpha"] = config.PremultiplyTextureAlpha;
 
 		std::ofstream out(path);
 		if (!out.is_open())
@@ -64,6 +68,18 @@ namespace Luden
 		if (jProject.contains("StartSceneHandle"))
 			config.StartSceneHandle = jProject["StartSceneHandle"].get<std::uint64_t>();
 
+		if (jProject.contains("ResourceMemoryBudget"))
+			config.ResourceMemoryBudget = jProject["ResourceMemoryBudget"].get<std::uint64_t>();
+
+		if (jProject.contains("PackDecodedTextures"))
+			config.PackDecodedTextures = jProject["PackDecodedTextures"].get<bool>();
+
+		if (jProject.contains("GenerateTextureMipmaps"))
+			config.GenerateTextureMipmaps = jProject["GenerateTextureMipmaps"].get<bool>();
+
+		if (jProject.contains("PremultiplyTextureAlpha"))
+			config.PremultiplyTextureAlpha = jProject["PremultiplyTextureAlpha"].get<bool>();
+
 		return true;
 	}
 
@@ -73,6 +89,7 @@ namespace Luden
 		json jRuntime;
 		jRuntime["Name"] = config.Name;
 		jRuntime["StartSceneHandle"] = static_cast<uint64_t>(config.StartSceneHandle);
+		jRuntime["ResourceMemoryBudget"] = config.ResourceMemoryBudget;
 
 		std::ofstream out(path);
 		if (!out.is_open())
@@ -98,6 +115,9 @@ namespace Luden
 		if (jRuntime.contains("StartSceneHandle"))
 			config.StartSceneHandle = jRuntime["StartSceneHandle"].get<std::uint64_t>();
 
+		if (jRuntime.contains("ResourceMemoryBudget"))
+			config.ResourceMemoryBudget = jRuntime["ResourceMemoryBudget"].get<std::uint64_t>();
+
 		config.ProjectFileName = path.filename().string();
 		config.ProjectDirectory = path.parent_path().string();
 
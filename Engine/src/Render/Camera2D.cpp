@@ -86,8 +86,8 @@ namespace Luden
 			if (m_AttachedEntity != nullptr && m_AttachedEntity->IsValid() && 
 				m_AttachedEntity->Has<Camera2DComponent>() && m_AttachedEntity->Has<TransformComponent>())
 			{
-				glm::vec3 position = m_AttachedEntity->Get<TransformComponent>().Translation;
-				m_Position = glm::vec2(position.x, position.y);
+				const auto& transform = m_AttachedEntity->Get<TransformComponent>();
+				m_Position = transform.Interpolated ? transform.RenderTranslation : glm::vec2(transform.Translation.x, transform.Translation.y);
 				m_View.setCenter(sf::Vector2f(m_Position.x, m_Position.y));
 			}
 			break;
@@ -0,0 +1,358 @@
+#include "Render/ParticleSystem.h"
+#include "Core/EngineContext.h"
+#include "ECS/Components/Components.h"
+#include "Graphics/ParticleEmitter.h"
+#include "Graphics/Sprite.h"
+#include "Graphics/Texture.h"
+#include "Resource/ResourceManager.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Luden
+{
+	static constexpr float s_DegToRad = 3.14159265f / 180.0f;
+
+	// xorshift32, returns [0, 1)
+	static float RandomFloat(uint32_t& state)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return (float)(state >> 8) * (1.0f / 16777216.0f);
+	}
+
+	static float RandomRange(uint32_t& state, float min, float max)
+	{
+		return min + (max - min) * RandomFloat(state);
+	}
+
+	void ParticleSystem::ParticleBuffer::SetCapacity(uint32_t capacity)
+	{
+		if (PositionX.size() == capacity)
+			return;
+
+		PositionX.resize(capacity);
+		PositionY.resize(capacity);
+		VelocityX.resize(capacity);
+		VelocityY.resize(capacity);
+		Age.resize(capacity);
+		InvLifetime.resize(capacity);
+		Count = std::min(Count, capacity);
+	}
+
+	void ParticleSystem::ParticleBuffer::Kill(uint32_t index)
+	{
+		uint32_t last = --Count;
+		PositionX[index] = PositionX[last];
+		PositionY[index] = PositionY[last];
+		VelocityX[index] = VelocityX[last];
+		VelocityY[index] = VelocityY[last];
+		Age[index] = Age[last];
+		InvLifetime[index] = InvLifetime[last];
+	}
+
+	void ParticleSystem::BeginFrame()
+	{
+		m_Frame++;
+	}
+
+	void ParticleSystem::Update(UUID entityID, const ParticleEmitterComponent& component, const sf::Transform& transform, float deltaTime)
+	{
+		EmitterInstance& instance = m_Instances[entityID];
+		instance.LastFrame = m_Frame;
+
+		sf::Vector2f origin = transform.transformPoint({ 0.0f, 0.0f });
+
+		if (instance.EmitterHandle != component.EmitterHandle)
+		{
+			ResetInstance(instance);
+			instance.EmitterHandle = component.EmitterHandle;
+			instance.RandomState = (uint32_t)(uint64_t)entityID | 1;
+			instance.LastOrigin = origin;
+		}
+
+		if (component.EmitterHandle == 0)
+			return;
+
+		auto emitter = ResourceManager::GetResource<ParticleEmitter>(component.EmitterHandle);
+		if (!emitter)
+			return;
+
+		ParticleBuffer& particles = instance.Particles;
+		particles.SetCapacity(emitter->MaxParticles);
+
+		float dt = deltaTime * component.SimulationSpeed;
+
+		GEngine.GetJobSystem().ParallelFor(particles.Count, s_ParallelThreshold, [&](uint32_t begin, uint32_t end)
+			{
+				Integrate(particles, *emitter, dt, begin, end);
+			});
+
+		for (uint32_t i = 0; i < particles.Count;)
+		{
+			if (particles.Age[i] >= 1.0f)
+				particles.Kill(i);
+			else
+				i++;
+		}
+
+		uint32_t spawnCount = instance.PendingParticles;
+		instance.PendingParticles = 0;
+
+		if (component.Playing && !instance.Finished)
+		{
+			if (!instance.Started)
+			{
+				instance.Started = true;
+				spawnCount += emitter->BurstCount;
+			}
+
+			instance.Time += dt;
+			instance.EmissionAccumulator += emitter->EmissionRate * dt;
+
+			if (emitter->Duration > 0.0f && instance.Time >= emitter->Duration)
+			{
+				if (emitter->Looping)
+				{
+					instance.Time = std::fmod(instance.Time, emitter->Duration);
+					spawnCount += emitter->BurstCount;
+				}
+				else
+				{
+					instance.Finished = true;
+				}
+			}
+
+			uint32_t emitted = (uint32_t)instance.EmissionAccumulator;
+			instance.EmissionAccumulator -= (float)emitted;
+			spawnCount += emitted;
+		}
+		else if (!component.Playing)
+		{
+			// Playing again restarts the emitter, bursts included
+			instance.Started = false;
+			instance.Finished = false;
+			instance.Time = 0.0f;
+			instance.EmissionAccumulator = 0.0f;
+		}
+
+		spawnCount = std::min(spawnCount, (uint32_t)particles.PositionX.size() - particles.Count);
+		if (spawnCount > 0)
+			Spawn(instance, *emitter, transform, spawnCount);
+
+		instance.LastOrigin = origin;
+
+		sf::FloatRect textureRect;
+		bool premultipliedAlpha = false;
+		if (emitter->SpriteHandle != 0)
+		{
+			auto sprite = ResourceManager::GetResourceOrPlaceholder<Sprite>(emitter->SpriteHandle);
+			auto texture = sprite ? ResourceManager::GetResourceOrPlaceholder<Texture>(sprite->GetTextureHandle()) : nullptr;
+			if (texture)
+			{
+				if (sprite->UsesFullTexture())
+					textureRect = { { 0.0f, 0.0f }, { (float)texture->GetTexture().getSize().x, (float)texture->GetTexture().getSize().y } };
+				else
+					textureRect = sf::FloatRect(sprite->GetTextureRect());
+
+				premultipliedAlpha = texture->HasPremultipliedAlpha();
+			}
+		}
+
+		instance.Vertices.resize((size_t)particles.Count * 6);
+
+		GEngine.GetJobSystem().ParallelFor(particles.Count, s_ParallelThreshold, [&](uint32_t begin, uint32_t end)
+			{
+				WriteVertices(instance, *emitter, textureRect, premultipliedAlpha, begin, end);
+			});
+	}
+
+	void ParticleSystem::EndFrame()
+	{
+		// Forget emitters that were not updated this frame (destroyed entities, removed components)
+		for (auto it = m_Instances.begin(); it != m_Instances.end();)
+		{
+			if (it->second.LastFrame != m_Frame)
+				it = m_Instances.erase(it);
+			else
+				++it;
+		}
+	}
+
+	void ParticleSystem::Render(UUID entityID, const sf::Transform& transform, sf::RenderTarget& target)
+	{
+		auto it = m_Instances.find(entityID);
+		if (it == m_Instances.end() || it->second.Vertices.empty())
+			return;
+
+		auto emitter = ResourceManager::GetResource<ParticleEmitter>(it->second.EmitterHandle);
+		if (!emitter)
+			return;
+
+		sf::RenderStates states;
+		if (!emitter->WorldSpace)
+			states.transform = transform;
+
+		if (emitter->SpriteHandle != 0)
+		{
+			auto sprite = ResourceManager::GetResourceOrPlaceholder<Sprite>(emitter->SpriteHandle);
+			auto texture = sprite ? ResourceManager::GetResourceOrPlaceholder<Texture>(sprite->GetTextureHandle()) : nullptr;
+			if (texture)
+			{
+				states.texture = &texture->GetTexture();
+				states.blendMode = texture->GetBlendMode();
+			}
+		}
+
+		target.draw(it->second.Vertices.data(), it->second.Vertices.size(), sf::PrimitiveType::Triangles, states);
+	}
+
+	void ParticleSystem::Emit(UUID entityID, uint32_t count)
+	{
+		m_Instances[entityID].PendingParticles += count;
+	}
+
+	void ParticleSystem::Reset(UUID entityID)
+	{
+		auto it = m_Instances.find(entityID);
+		if (it != m_Instances.end())
+			ResetInstance(it->second);
+	}
+
+	void ParticleSystem::Clear()
+	{
+		m_Instances.clear();
+	}
+
+	uint32_t ParticleSystem::GetLiveParticleCount() const
+	{
+		uint32_t count = 0;
+		for (const auto& [entityID, instance] : m_Instances)
+			count += instance.Particles.Count;
+
+		return count;
+	}
+
+	void ParticleSystem::ResetInstance(EmitterInstance& instance)
+	{
+		instance.Particles.Count = 0;
+		instance.Vertices.clear();
+		instance.Time = 0.0f;
+		instance.EmissionAccumulator = 0.0f;
+		instance.Started = false;
+		instance.Finished = false;
+	}
+
+	void ParticleSystem::Spawn(EmitterInstance& instance, const ParticleEmitter& emitter, const sf::Transform& transform, uint32_t count)
+	{
+		ParticleBuffer& particles = instance.Particles;
+
+		// Local space particles are drawn with the entity transform, so they spawn at the origin unrotated
+		const float* matrix = transform.getMatrix();
+		float rotation = emitter.WorldSpace ? std::atan2(matrix[1], matrix[0]) : 0.0f;
+		sf::Vector2f origin = emitter.WorldSpace ? transform.transformPoint({ 0.0f, 0.0f }) : sf::Vector2f(0.0f, 0.0f);
+		sf::Vector2f lastOrigin = emitter.WorldSpace ? instance.LastOrigin : origin;
+
+		for (uint32_t n = 0; n < count; n++)
+		{
+			uint32_t i = particles.Count++;
+
+			// Spread spawns along the path the emitter moved this frame so fast emitters leave a continuous trail
+			float t = (float)(n + 1) / (float)count;
+			float angle = rotation + (emitter.Direction + RandomRange(instance.RandomState, -0.5f, 0.5f) * emitter.Spread) * s_DegToRad;
+			float speed = RandomRange(instance.RandomState, emitter.SpeedMin, emitter.SpeedMax);
+			float lifetime = std::max(RandomRange(instance.RandomState, emitter.LifetimeMin, emitter.LifetimeMax), 0.001f);
+
+			particles.PositionX[i] = lastOrigin.x + (origin.x - lastOrigin.x) * t;
+			particles.PositionY[i] = lastOrigin.y + (origin.y - lastOrigin.y) * t;
+			particles.VelocityX[i] = std::cos(angle) * speed;
+			particles.VelocityY[i] = std::sin(angle) * speed;
+			particles.Age[i] = 0.0f;
+			particles.InvLifetime[i] = 1.0f / lifetime;
+		}
+	}
+
+	void ParticleSystem::Integrate(ParticleBuffer& particles, const ParticleEmitter& emitter, float deltaTime, uint32_t begin, uint32_t end)
+	{
+		float* positionX = particles.PositionX.data();
+		float* positionY = particles.PositionY.data();
+		float* velocityX = particles.VelocityX.data();
+		float* velocityY = particles.VelocityY.data();
+		float* age = particles.Age.data();
+		const float* invLifetime = particles.InvLifetime.data();
+
+		const float gravityX = emitter.Gravity.x * deltaTime;
+		const float gravityY = emitter.Gravity.y * deltaTime;
+		const float damping = 1.0f / (1.0f + emitter.Drag * deltaTime);
+
+		// One stream per loop and no branches, so each loop compiles to packed SSE/AVX instructions
+		for (uint32_t i = begin; i < end; i++)
+		{
+			velocityX[i] = (velocityX[i] + gravityX) * damping;
+			velocityY[i] = (velocityY[i] + gravityY) * damping;
+		}
+
+		for (uint32_t i = begin; i < end; i++)
+		{
+			positionX[i] += velocityX[i] * deltaTime;
+			positionY[i] += velocityY[i] * deltaTime;
+		}
+
+		for (uint32_t i = begin; i < end; i++)
+		{
+			age[i] += invLifetime[i] * deltaTime;
+		}
+	}
+
+	void ParticleSystem::WriteVertices(EmitterInstance& instance, const ParticleEmitter& emitter, const sf::FloatRect& textureRect, bool premultipliedAlpha, uint32_t begin, uint32_t end)
+	{
+		const ParticleBuffer& particles = instance.Particles;
+		sf::Vertex* vertices = instance.Vertices.data();
+
+		const float startR = emitter.StartColor.r, deltaR = (float)emitter.EndColor.r - startR;
+		const float startG = emitter.StartColor.g, deltaG = (float)emitter.EndColor.g - startG;
+		const float startB = emitter.StartColor.b, deltaB = (float)emitter.EndColor.b - startB;
+		const float startA = emitter.StartColor.a, deltaA = (float)emitter.EndColor.a - startA;
+		const float startSize = emitter.StartSize, deltaSize = emitter.EndSize - emitter.StartSize;
+
+		const float u0 = textureRect.position.x;
+		const float v0 = textureRect.position.y;
+		const float u1 = u0 + textureRect.size.x;
+		const float v1 = v0 + textureRect.size.y;
+
+		for (uint32_t i = begin; i < end; i++)
+		{
+			float t = std::min(particles.Age[i], 1.0f);
+			float halfSize = (startSize + deltaSize * t) * 0.5f;
+
+			sf::Color color(
+				(uint8_t)(startR + deltaR * t),
+				(uint8_t)(startG + deltaG * t),
+				(uint8_t)(startB + deltaB * t),
+				(uint8_t)(startA + deltaA * t)
+			);
+
+			// The fade has to reach RGB too when the texture blends premultiplied
+			if (premultipliedAlpha)
+			{
+				color.r = (uint8_t)(color.r * color.a / 255);
+				color.g = (uint8_t)(color.g * color.a / 255);
+				color.b = (uint8_t)(color.b * color.a / 255);
+			}
+
+			float left = particles.PositionX[i] - halfSize;
+			float top = particles.PositionY[i] - halfSize;
+			float right = particles.PositionX[i] + halfSize;
+			float bottom = particles.PositionY[i] + halfSize;
+
+			sf::Vertex* quad = vertices + (size_t)i * 6;
+			quad[0] = { { left, top }, color, { u0, v0 } };
+			quad[1] = { { right, top }, color, { u1, v0 } };
+			quad[2] = { { left, bottom }, color, { u0, v1 } };
+			quad[3] = { { left, bottom }, color, { u0, v1 } };
+			quad[4] = { { right, top }, color, { u1, v0 } };
+			quad[5] = { { right, bottom }, color, { u1, v1 } };
+		}
+	}
+}
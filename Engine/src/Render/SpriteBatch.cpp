@@ -0,0 +1,75 @@
+#include "Render/SpriteBatch.h"
+
+#include <cmath>
+
+namespace Luden
+{
+	SpriteBatch::SpriteBatch()
+		: m_Vertices(sf::PrimitiveType::Triangles)
+	{
+	}
+
+	void SpriteBatch::Begin(sf::RenderTarget& target)
+	{
+		m_Target = &target;
+		m_Texture = nullptr;
+		m_Vertices.clear();
+		m_DrawCallCount = 0;
+		m_QuadCount = 0;
+	}
+
+	void SpriteBatch::Draw(const sf::Texture& texture, const sf::IntRect& textureRect, const sf::Vector2f& origin, const sf::Color& color, const sf::Transform& transform, const sf::BlendMode& blendMode)
+	{
+		if (!m_Target)
+			return;
+
+		if (m_Texture != &texture || m_BlendMode != blendMode)
+		{
+			Flush();
+			m_Texture = &texture;
+			m_BlendMode = blendMode;
+		}
+
+		sf::Vector2f size = { (float)std::abs(textureRect.size.x), (float)std::abs(textureRect.size.y) };
+
+		sf::Vector2f topLeft = transform.transformPoint(-origin);
+		sf::Vector2f topRight = transform.transformPoint({ size.x - origin.x, -origin.y });
+		sf::Vector2f bottomLeft = transform.transformPoint({ -origin.x, size.y - origin.y });
+		sf::Vector2f bottomRight = transform.transformPoint(size - origin);
+
+		float left = (float)textureRect.position.x;
+		float top = (float)textureRect.position.y;
+		float right = left + (float)textureRect.size.x;
+		float bottom = top + (float)textureRect.size.y;
+
+		m_Vertices.append({ topLeft, color, { left, top } });
+		m_Vertices.append({ topRight, color, { right, top } });
+		m_Vertices.append({ bottomLeft, color, { left, bottom } });
+		m_Vertices.append({ bottomLeft, color, { left, bottom } });
+		m_Vertices.append({ topRight, color, { right, top } });
+		m_Vertices.append({ bottomRight, color, { right, bottom } });
+
+		m_QuadCount++;
+	}
+
+	void SpriteBatch::Flush()
+	{
+		if (!m_Target || m_Vertices.getVertexCount() == 0)
+			return;
+
+		sf::RenderStates states;
+		states.texture = m_Texture;
+		states.blendMode = m_BlendMode;
+		m_Target->draw(m_Vertices, states);
+		m_Vertices.clear();
+
+		m_DrawCallCount++;
+	}
+
+	void SpriteBatch::End()
+	{
+		Flush();
+		m_Target = nullptr;
+		m_Texture = nullptr;
+	}
+}
@@ -0,0 +1,162 @@
+#include "Render/TilemapRenderer.h"
+#include "ECS/Components/Components.h"
+#include "Graphics/Texture.h"
+#include "Graphics/Tileset.h"
+#include "Resource/ResourceManager.h"
+
+#include <SFML/Graphics/View.hpp>
+
+namespace Luden
+{
+	void TilemapRenderer::BeginFrame()
+	{
+		m_Frame++;
+		m_DrawCallCount = 0;
+		m_RebuiltChunkCount = 0;
+	}
+
+	void TilemapRenderer::Render(UUID entityID, const TilemapComponent& tilemap, const sf::Transform& transform, sf::RenderTarget& target)
+	{
+		if (tilemap.TilesetHandle == 0 || tilemap.Chunks.empty())
+			return;
+
+		auto tileset = ResourceManager::GetResourceOrPlaceholder<Tileset>(tilemap.TilesetHandle);
+		if (!tileset)
+			return;
+
+		auto texture = ResourceManager::GetResourceOrPlaceholder<Texture>(tileset->GetTextureHandle());
+		if (!texture)
+			return;
+
+		TilemapCache& cache = m_Caches[entityID];
+		cache.LastFrame = m_Frame;
+
+		// Drop chunks that were erased since the last frame
+		for (auto it = cache.Chunks.begin(); it != cache.Chunks.end();)
+		{
+			if (tilemap.Chunks.find(it->first) == tilemap.Chunks.end())
+				it = cache.Chunks.erase(it);
+			else
+				++it;
+		}
+
+		// World space bounds of what the view can see (also correct for rotated views)
+		sf::FloatRect viewBounds = target.getView().getInverseTransform().transformRect({ { -1.0f, -1.0f }, { 2.0f, 2.0f } });
+
+		sf::Vector2f chunkSize = {
+			(float)(tileset->GetTileSize().x * TilemapChunk::Size),
+			(float)(tileset->GetTileSize().y * TilemapChunk::Size)
+		};
+
+		sf::RenderStates states;
+		states.transform = transform;
+		states.texture = &texture->GetTexture();
+		states.blendMode = texture->GetBlendMode();
+
+		for (const auto& [key, chunk] : tilemap.Chunks)
+		{
+			int32_t chunkX = TilemapComponent::ChunkKeyX(key);
+			int32_t chunkY = TilemapComponent::ChunkKeyY(key);
+
+			sf::FloatRect localBounds = { { chunkX * chunkSize.x, chunkY * chunkSize.y }, chunkSize };
+			if (!transform.transformRect(localBounds).findIntersection(viewBounds))
+				continue;
+
+			ChunkCache& chunkCache = cache.Chunks[key];
+			if (!chunkCache.Valid || chunkCache.Revision != chunk.Revision || chunkCache.TilesetHandle != tilemap.TilesetHandle || chunkCache.Tint != tilemap.Tint)
+			{
+				BuildChunk(chunkCache, chunkX, chunkY, tilemap, *tileset);
+				chunkCache.Revision = chunk.Revision;
+				chunkCache.TilesetHandle = tilemap.TilesetHandle;
+				chunkCache.Tint = tilemap.Tint;
+				chunkCache.Valid = true;
+			}
+
+			if (sf::VertexBuffer::isAvailable())
+			{
+				if (chunkCache.Buffer.getVertexCount() == 0)
+					continue;
+
+				target.draw(chunkCache.Buffer, states);
+			}
+			else
+			{
+				if (chunkCache.Vertices.empty())
+					continue;
+
+				target.draw(chunkCache.Vertices.data(), chunkCache.Vertices.size(), sf::PrimitiveType::Triangles, states);
+			}
+
+			m_DrawCallCount++;
+		}
+	}
+
+	void TilemapRenderer::EndFrame()
+	{
+		// Forget tilemaps that were not drawn this frame (destroyed entities, removed components)
+		for (auto it = m_Caches.begin(); it != m_Caches.end();)
+		{
+			if (it->second.LastFrame != m_Frame)
+				it = m_Caches.erase(it);
+			else
+				++it;
+		}
+	}
+
+	void TilemapRenderer::Clear()
+	{
+		m_Caches.clear();
+	}
+
+	void TilemapRenderer::BuildChunk(ChunkCache& cache, int32_t chunkX, int32_t chunkY, const TilemapComponent& tilemap, const Tileset& tileset)
+	{
+		const TilemapChunk& chunk = tilemap.Chunks.at(TilemapComponent::ChunkKey(chunkX, chunkY));
+
+		sf::Vector2f tileSize = { (float)tileset.GetTileSize().x, (float)tileset.GetTileSize().y };
+		sf::Vector2f origin = { chunkX * TilemapChunk::Size * tileSize.x, chunkY * TilemapChunk::Size * tileSize.y };
+
+		m_ScratchVertices.clear();
+		m_ScratchVertices.reserve(chunk.TileCount * 6);
+
+		for (int32_t y = 0; y < TilemapChunk::Size; y++)
+		{
+			for (int32_t x = 0; x < TilemapChunk::Size; x++)
+			{
+				uint16_t tile = chunk.Tiles[y * TilemapChunk::Size + x];
+				if (tile == 0)
+					continue;
+
+				sf::IntRect rect = tileset.GetTileRect(tile - 1);
+				float left = (float)rect.position.x;
+				float top = (float)rect.position.y;
+				float right = left + (float)rect.size.x;
+				float bottom = top + (float)rect.size.y;
+
+				sf::Vector2f topLeft = { origin.x + x * tileSize.x, origin.y + y * tileSize.y };
+				sf::Vector2f bottomRight = topLeft + tileSize;
+
+				m_ScratchVertices.push_back({ topLeft, tilemap.Tint, { left, top } });
+				m_ScratchVertices.push_back({ { bottomRight.x, topLeft.y }, tilemap.Tint, { right, top } });
+				m_ScratchVertices.push_back({ { topLeft.x, bottomRight.y }, tilemap.Tint, { left, bottom } });
+				m_ScratchVertices.push_back({ { topLeft.x, bottomRight.y }, tilemap.Tint, { left, bottom } });
+				m_ScratchVertices.push_back({ { bottomRight.x, topLeft.y }, tilemap.Tint, { right, top } });
+				m_ScratchVertices.push_back({ bottomRight, tilemap.Tint, { right, bottom } });
+			}
+		}
+
+		if (sf::VertexBuffer::isAvailable())
+		{
+			if (cache.Buffer.getVertexCount() != m_ScratchVertices.size() && !cache.Buffer.create(m_ScratchVertices.size()))
+				return;
+
+			if (!m_ScratchVertices.empty())
+				(void)cache.Buffer.update(m_ScratchVertices.data());
+		}
+		else
+		{
+			cache.Vertices = m_ScratchVertices;
+		}
+
+		m_RebuiltChunkCount++;
+	}
+}
@@ -2,6 +2,8 @@
 #include "Resource/ResourceManager.h"
 #include "Audio/Sound.h"
 #include "Audio/Music.h"
+#include "Graphics/ParticleEmitter.h"
+#include "Graphics/Tileset.h"
 
 namespace Luden
 {
@@ -17,6 +19,8 @@ namespace Luden
 		s_Serializers[ResourceType::NativeScript] = std::make_unique<NativeScriptResourceSerializer>();
 		s_Serializers[ResourceType::Sprite] = std::make_unique<SpriteSerializer>();
 		s_Serializers[ResourceType::Prefab] = std::make_unique<PrefabSerializer>();
+		s_Serializers[ResourceType::Tileset] = std::make_unique<TilesetSerializer>();
+		s_Serializers[ResourceType::ParticleEmitter] = std::make_unique<ParticleEmitterSerializer>();
 	}
 
 	void ResourceImporter::Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource)
@@ -40,7 +44,7 @@ namespace Luden
 		return s_Serializers[metadata.Type]->TryLoadData(metadata, resource);
 	}
 
-	bool ResourceImporter::SerializeToResourcePack(ResourceHandle resourceHandle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo)
+	bool ResourceImporter::SerializeToResourcePack(ResourceHandle resourceHandle, StreamWriter& stream, ResourceSerializationInfo& outInfo)
 	{
 		outInfo.Size = 0;
 
@@ -57,16 +61,53 @@ namespace Luden
 		return s_Serializers[type]->SerializeToResourcePack(resourceHandle, stream, outInfo);
 	}
 
-	std::shared_ptr<Resource> ResourceImporter::DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo)
+	bool ResourceImporter::SerializeFileToResourcePack(ResourceType type, const std::filesystem::path& path, StreamWriter& stream, ResourceSerializationInfo& outInfo)
 	{
-		ResourceType resourceType = (ResourceType)resourceInfo.Type;
-		if (s_Serializers.find(resourceType) == s_Serializers.end())
+		outInfo.Size = 0;
+
+		// Called from the pack builder's workers, only look the serializer up
+		auto it = s_Serializers.find(type);
+		if (it == s_Serializers.end())
+			return false;
+
+		return it->second->SerializeFileToResourcePack(path, stream, outInfo);
+	}
+
+	std::shared_ptr<Resource> ResourceImporter::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo)
+	{
+		// Called from loader threads, only look the serializer up
+		auto it = s_Serializers.find((ResourceType)resourceInfo.Type);
+		if (it == s_Serializers.end())
 			return nullptr;
 
-		return s_Serializers[resourceType]->DeserializeFromResourcePack(stream, resourceInfo);
+		return it->second->DeserializeFromResourcePack(stream, resourceInfo);
+	}
+
+	bool ResourceImporter::CanDeserializeAsync(ResourceType type)
+	{
+		auto it = s_Serializers.find(type);
+		return it != s_Serializers.end() && it->second->CanDeserializeAsync();
+	}
+
+	bool ResourceImporter::FinalizeResource(const std::shared_ptr<Resource>& resource)
+	{
+		auto it = s_Serializers.find(resource->GetResourceType());
+		if (it == s_Serializers.end())
+			return false;
+
+		return it->second->FinalizeResource(resource);
 	}
 
-	std::shared_ptr<Scene> ResourceImporter::DeserializeSceneFromResourcePack(FileStreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo)
+	bool ResourceImporter::FinalizeResourceStep(const std::shared_ptr<Resource>& resource, uint64_t& budgetBytes)
+	{
+		auto it = s_Serializers.find(resource->GetResourceType());
+		if (it == s_Serializers.end())
+			return true;
+
+		return it->second->FinalizeResourceStep(resource, budgetBytes);
+	}
+
+	std::shared_ptr<Scene> ResourceImporter::DeserializeSceneFromResourcePack(StreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo)
 	{
 		ResourceType resourceType = ResourceType::Scene;
 		if (s_Serializers.find(resourceType) == s_Serializers.end())
@@ -76,6 +117,26 @@ namespace Luden
 		return sceneResourceSerializer->DeserializeSceneFromResourcePack(stream, sceneInfo);
 	}
 
+	bool ResourceImporter::SerializeSpriteToResourcePack(const Sprite& sprite, StreamWriter& stream, ResourceSerializationInfo& outInfo)
+	{
+		ResourceType resourceType = ResourceType::Sprite;
+		if (s_Serializers.find(resourceType) == s_Serializers.end())
+			return false;
+
+		SpriteSerializer* spriteSerializer = (SpriteSerializer*)s_Serializers[resourceType].get();
+		return spriteSerializer->SerializeToResourcePack(sprite, stream, outInfo);
+	}
+
+	bool ResourceImporter::SerializeTextureImageToResourcePack(const sf::Image& image, StreamWriter& stream, ResourceSerializationInfo& outInfo)
+	{
+		ResourceType resourceType = ResourceType::Texture;
+		if (s_Serializers.find(resourceType) == s_Serializers.end())
+			return false;
+
+		TextureSerializer* textureSerializer = (TextureSerializer*)s_Serializers[resourceType].get();
+		return textureSerializer->SerializeToResourcePack(image, stream, outInfo);
+	}
+
 	std::shared_ptr<Resource> ResourceImporter::CreateResource(ResourceType type, const std::string& name)
 	{
 		std::shared_ptr<Resource> resource;
@@ -91,6 +152,8 @@ namespace Luden
 		case ResourceType::Animation:    resource = std::make_shared<Animation>(); break;
 		case ResourceType::NativeScript: resource = std::make_shared<NativeScript>(); break;
 		case ResourceType::Prefab:       resource = std::make_shared<Prefab>(); break;
+		case ResourceType::Tileset:      resource = std::make_shared<Tileset>(); break;
+		case ResourceType::ParticleEmitter: resource = std::make_shared<ParticleEmitter>(); break;
 		default:                         return nullptr;
 		}
 
@@ -0,0 +1,122 @@
+#include "Resource/ResourceLoader.h"
+
+#include <algorithm>
+
+namespace Luden
+{
+	void ResourceLoadRequest::Finish(std::shared_ptr<Resource> resource)
+	{
+		Result = std::move(resource);
+		State.store(Result ? ResourceLoadState::Ready : ResourceLoadState::Failed, std::memory_order_release);
+	}
+
+	ResourceFuture ResourceFuture::MakeFinished(ResourceHandle handle, std::shared_ptr<Resource> resource)
+	{
+		auto request = std::make_shared<ResourceLoadRequest>();
+		request->Handle = handle;
+		request->Finish(std::move(resource));
+		return ResourceFuture(request);
+	}
+
+	ResourceLoader::~ResourceLoader()
+	{
+		Shutdown();
+	}
+
+	void ResourceLoader::Init(DecodeFunction decode, uint32_t threadCount)
+	{
+		Shutdown();
+
+		m_Decode = std::move(decode);
+		m_Running = true;
+		for (uint32_t i = 0; i < std::max(threadCount, 1u); i++)
+			m_Threads.emplace_back(&ResourceLoader::WorkerLoop, this);
+	}
+
+	void ResourceLoader::Shutdown()
+	{
+		if (m_Threads.empty())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Running = false;
+		}
+		m_WakeCondition.notify_all();
+
+		for (auto& thread : m_Threads)
+		{
+			if (thread.joinable())
+				thread.join();
+		}
+		m_Threads.clear();
+
+		// Nobody will decode what is left, the futures fail instead of staying pending forever
+		for (auto& [handle, request] : m_InFlight)
+		{
+			if (request->State.load(std::memory_order_acquire) == ResourceLoadState::Pending)
+				request->Finish(nullptr);
+		}
+
+		m_InFlight.clear();
+		m_Queue.clear();
+		m_Decoded.clear();
+	}
+
+	ResourceFuture ResourceLoader::Load(ResourceHandle handle)
+	{
+		auto it = m_InFlight.find(handle);
+		if (it != m_InFlight.end())
+			return ResourceFuture(it->second);
+
+		auto request = std::make_shared<ResourceLoadRequest>();
+		request->Handle = handle;
+		m_InFlight[handle] = request;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Queue.push_back(request);
+		}
+		m_WakeCondition.notify_one();
+
+		return ResourceFuture(request);
+	}
+
+	void ResourceLoader::TakeDecoded(std::vector<std::shared_ptr<ResourceLoadRequest>>& outDecoded)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		outDecoded.insert(outDecoded.end(), m_Decoded.begin(), m_Decoded.end());
+		m_Decoded.clear();
+	}
+
+	void ResourceLoader::Finish(const std::shared_ptr<ResourceLoadRequest>& request, std::shared_ptr<Resource> resource)
+	{
+		auto it = m_InFlight.find(request->Handle);
+		if (it != m_InFlight.end() && it->second == request)
+			m_InFlight.erase(it);
+
+		request->Finish(std::move(resource));
+	}
+
+	void ResourceLoader::WorkerLoop()
+	{
+		while (true)
+		{
+			std::shared_ptr<ResourceLoadRequest> request;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_WakeCondition.wait(lock, [this]() { return !m_Running || !m_Queue.empty(); });
+				if (!m_Running)
+					return;
+
+				request = std::move(m_Queue.front());
+				m_Queue.pop_front();
+			}
+
+			request->Result = m_Decode(request->Handle);
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Decoded.push_back(std::move(request));
+		}
+	}
+}
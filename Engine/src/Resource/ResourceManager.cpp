@@ -1,5 +1,25 @@
 #include "Resource/ResourceManager.h"
+#include "Graphics/Texture.h"
 
 namespace Luden {
 
+	std::shared_ptr<Resource> ResourceManager::GetPlaceholderResource(ResourceType type)
+	{
+		if (type == ResourceType::Texture)
+		{
+			// A single translucent grey texel, the sampler stretches it over any sprite rect
+			static std::shared_ptr<Texture> s_PlaceholderTexture;
+			if (!s_PlaceholderTexture)
+			{
+				auto texture = std::make_shared<Texture>();
+				if (!texture->GetTexture().loadFromImage(sf::Image({ 1, 1 }, sf::Color(128, 128, 128, 96))))
+					return nullptr;
+
+				s_PlaceholderTexture = texture;
+			}
+			return s_PlaceholderTexture;
+		}
+
+		return nullptr;
+	}
 }
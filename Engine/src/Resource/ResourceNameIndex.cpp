@@ -0,0 +1,69 @@
+#include "Resource/ResourceNameIndex.h"
+#include "Utilities/StringUtils.h"
+
+#include <cctype>
+
+namespace Luden
+{
+	size_t ResourceNameIndex::NameHash::operator()(std::string_view name) const
+	{
+		// FNV-1a over the lowered characters
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : name)
+		{
+			hash ^= (uint64_t)std::tolower((unsigned char)c);
+			hash *= 1099511628211ull;
+		}
+		return (size_t)hash;
+	}
+
+	bool ResourceNameIndex::NameEqual::operator()(std::string_view a, std::string_view b) const
+	{
+		return Utils::String::EqualsIgnoreCase(a, b);
+	}
+
+	void ResourceNameIndex::Add(ResourceType type, std::string_view name, ResourceHandle resourceHandle)
+	{
+		if ((uint32_t)type >= ResourceTypeCount || name.empty())
+			return;
+
+		auto& handles = m_Handles[(uint32_t)type];
+		if (!handles.contains(name))
+			handles.emplace(std::string(name), resourceHandle);
+	}
+
+	bool ResourceNameIndex::Remove(ResourceType type, std::string_view name, ResourceHandle resourceHandle)
+	{
+		if ((uint32_t)type >= ResourceTypeCount || name.empty())
+			return false;
+
+		auto& handles = m_Handles[(uint32_t)type];
+		auto it = handles.find(name);
+		if (it == handles.end() || it->second != resourceHandle)
+			return false;
+
+		handles.erase(it);
+		return true;
+	}
+
+	void ResourceNameIndex::Clear()
+	{
+		for (auto& handles : m_Handles)
+			handles.clear();
+	}
+
+	ResourceHandle ResourceNameIndex::Find(ResourceType type, std::string_view name) const
+	{
+		if ((uint32_t)type >= ResourceTypeCount)
+			return 0;
+
+		const auto& handles = m_Handles[(uint32_t)type];
+		auto it = handles.find(name);
+		return it != handles.end() ? it->second : ResourceHandle(0);
+	}
+
+	std::string ResourceNameIndex::GetResourceName(const std::filesystem::path& filePath)
+	{
+		return Utils::RemoveExtension(filePath.filename().string());
+	}
+}
@@ -1,4 +1,5 @@
 #include "Resource/ResourceRegistry.h"
+#include "Utilities/StringUtils.h"
 
 namespace Luden
 {
@@ -11,7 +12,19 @@ namespace Luden
 	void ResourceRegistry::Set(const ResourceHandle& resourceHandle, const ResourceMetadata& metadata)
 	{
 		//TODO: Assert metadata.handle = resourceHandle AND resourceHandle != 0
-		m_ResourceRegistry[resourceHandle] = metadata;
+		auto it = m_ResourceRegistry.find(resourceHandle);
+		if (it != m_ResourceRegistry.end())
+		{
+			ResourceMetadata previous = it->second;
+			it->second = metadata;
+			RemoveName(previous);
+		}
+		else
+		{
+			m_ResourceRegistry[resourceHandle] = metadata;
+		}
+
+		m_NameIndex.Add(metadata.Type, ResourceNameIndex::GetResourceName(metadata.FilePath), resourceHandle);
 	}
 
 	bool ResourceRegistry::Contains(const ResourceHandle& resourceHandle) const
@@ -23,12 +36,37 @@ namespace Luden
 	size_t ResourceRegistry::Remove(const ResourceHandle& resourceHandle)
 	{
 		//TODO Log
-		return m_ResourceRegistry.erase(resourceHandle);
+		auto it = m_ResourceRegistry.find(resourceHandle);
+		if (it == m_ResourceRegistry.end())
+			return 0;
+
+		ResourceMetadata metadata = it->second;
+		m_ResourceRegistry.erase(it);
+		RemoveName(metadata);
+		return 1;
 	}
 
 	void ResourceRegistry::Clear()
 	{
 		//TODO Log
 		m_ResourceRegistry.clear();
+		m_NameIndex.Clear();
+	}
+
+	void ResourceRegistry::RemoveName(const ResourceMetadata& metadata)
+	{
+		std::string name = ResourceNameIndex::GetResourceName(metadata.FilePath);
+		if (!m_NameIndex.Remove(metadata.Type, name, metadata.Handle))
+			return;
+
+		// Another resource of the same type and name takes the name over. Only happens with clashing names
+		for (const auto& [handle, other] : m_ResourceRegistry)
+		{
+			if (other.Type == metadata.Type && Utils::String::EqualsIgnoreCase(ResourceNameIndex::GetResourceName(other.FilePath), name))
+			{
+				m_NameIndex.Add(other.Type, name, handle);
+				return;
+			}
+		}
 	}
 }
\ No newline at end of file
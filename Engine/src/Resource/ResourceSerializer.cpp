@@ -3,7 +3,9 @@
 #include "Audio/Sound.h"
 #include "Graphics/Animation.h"
 #include "Graphics/Font.h"
+#include "Graphics/ParticleEmitter.h"
 #include "Graphics/Texture.h"
+#include "Graphics/Tileset.h"
 #include "IO/FileSystem.h"
 #include "Project/Project.h"
 #include "Resource/ResourceManager.h"
@@ -13,6 +15,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include <algorithm>
 #include <iostream>
 #include "Audio/Music.h"
 
@@ -57,7 +60,7 @@ namespace Luden
 		return true;
 	}
 
-	bool NativeScriptResourceSerializer::SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	bool NativeScriptResourceSerializer::SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
 	{
 		outInfo.Offset = stream.GetStreamPosition();
 
@@ -74,7 +77,7 @@ namespace Luden
 		return true;
 	}
 
-	std::shared_ptr<Resource> NativeScriptResourceSerializer::DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
+	std::shared_ptr<Resource> NativeScriptResourceSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
 	{
 		return std::shared_ptr<Resource>();
 	}
@@ -156,20 +159,25 @@ namespace Luden
 		return true;
 	}
 
-	bool SpriteSerializer::SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	bool SpriteSerializer::SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
 	{
-		outInfo.Offset = stream.GetStreamPosition();
-
 		auto sprite = ResourceManager::GetResource<Sprite>(handle);
 		if (!sprite)
 			return false;
 
+		return SerializeToResourcePack(*sprite, stream, outInfo);
+	}
+
+	bool SpriteSerializer::SerializeToResourcePack(const Sprite& sprite, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	{
+		outInfo.Offset = stream.GetStreamPosition();
+
 		nlohmann::json j;
 
-		j["Name"] = sprite->GetName();
-		j["TextureHandle"] = static_cast<uint64_t>(sprite->GetTextureHandle());
+		j["Name"] = sprite.GetName();
+		j["TextureHandle"] = static_cast<uint64_t>(sprite.GetTextureHandle());
 
-		const auto& rect = sprite->GetTextureRect();
+		const auto& rect = sprite.GetTextureRect();
 		j["TextureRect"] = {
 			{"x", rect.position.x},
 			{"y", rect.position.y},
@@ -178,11 +186,11 @@ namespace Luden
 		};
 
 		j["Pivot"] = {
-			{"x", sprite->GetPivot().x},
-			{"y", sprite->GetPivot().y}
+			{"x", sprite.GetPivot().x},
+			{"y", sprite.GetPivot().y}
 		};
 
-		j["Handle"] = static_cast<uint64_t>(sprite->Handle);
+		j["Handle"] = static_cast<uint64_t>(sprite.Handle);
 
 		std::string jsonStr = j.dump();
 		stream.WriteString(jsonStr);
@@ -191,7 +199,7 @@ namespace Luden
 		return true;
 	}
 
-	std::shared_ptr<Resource> SpriteSerializer::DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
+	std::shared_ptr<Resource> SpriteSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
 	{
 		stream.SetStreamPosition(resourceInfo.PackedOffset);
 
@@ -234,6 +242,30 @@ namespace Luden
 	// TextureSerializer
 	//////////////////////////////////////////////////////////////////////////////////
 
+	static uint16_t GetTexturePackFlags()
+	{
+		const auto& config = Project::GetActiveProject()->GetConfig();
+
+		uint16_t flags = (uint16_t)TexturePackFlag::None;
+		if (config.GenerateTextureMipmaps)
+			flags |= (uint16_t)TexturePackFlag::GenerateMipmap;
+		if (config.PremultiplyTextureAlpha)
+			flags |= (uint16_t)TexturePackFlag::PremultipliedAlpha;
+
+		return flags;
+	}
+
+	static void PremultiplyAlpha(std::vector<uint8_t>& pixels)
+	{
+		for (size_t i = 0; i + 3 < pixels.size(); i += 4)
+		{
+			uint32_t alpha = pixels[i + 3];
+			pixels[i + 0] = (uint8_t)((pixels[i + 0] * alpha + 127) / 255);
+			pixels[i + 1] = (uint8_t)((pixels[i + 1] * alpha + 127) / 255);
+			pixels[i + 2] = (uint8_t)((pixels[i + 2] * alpha + 127) / 255);
+		}
+	}
+
 	bool TextureSerializer::TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const
 	{
 		auto path = Project::GetEditorResourceManager()->GetFileSystemPath(metadata);
@@ -250,34 +282,168 @@ namespace Luden
 		return true;
 	}
 
-	bool TextureSerializer::SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	bool TextureSerializer::SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
 	{
+		return SerializeFileToResourcePack(Project::GetEditorResourceManager()->GetFileSystemPath(handle), stream, outInfo);
+	}
+
+	bool TextureSerializer::SerializeFileToResourcePack(const std::filesystem::path& path, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	{
+		if (Project::GetActiveProject()->GetConfig().PackDecodedTextures)
+		{
+			sf::Image image;
+			if (!image.loadFromFile(path))
+				return false;
+
+			return SerializeToResourcePack(image, stream, outInfo);
+		}
+
 		outInfo.Offset = stream.GetStreamPosition();
 
-		auto path = Project::GetEditorResourceManager()->GetFileSystemPath(handle);
+		ResourcePackFile::TextureHeader header;
+		header.Format = (uint16_t)TexturePackFormat::Encoded;
+		header.Flags = GetTexturePackFlags();
+		stream.WriteRaw(header);
+
 		Buffer textureData = FileSystem::ReadBytes(path);
 		stream.WriteBuffer(textureData);
+		textureData.Release();
 
 		outInfo.Size = stream.GetStreamPosition() - outInfo.Offset;
 		return true;
 	}
 
-	std::shared_ptr<Resource> TextureSerializer::DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
+	bool TextureSerializer::SerializeToResourcePack(const sf::Image& image, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	{
+		sf::Vector2u size = image.getSize();
+		if (size.x == 0 || size.y == 0)
+			return false;
+
+		outInfo.Offset = stream.GetStreamPosition();
+
+		ResourcePackFile::TextureHeader header;
+		header.Flags = GetTexturePackFlags();
+		if (Project::GetActiveProject()->GetConfig().PackDecodedTextures)
+		{
+			header.Width = size.x;
+			header.Height = size.y;
+			header.Format = (uint16_t)TexturePackFormat::RGBA8;
+			stream.WriteRaw(header);
+
+			// Decoded pixels are stored premultiplied so the runtime uploads them as they are
+			if (header.Flags & (uint16_t)TexturePackFlag::PremultipliedAlpha)
+			{
+				std::vector<uint8_t> pixels(image.getPixelsPtr(), image.getPixelsPtr() + (uint64_t)size.x * size.y * 4);
+				PremultiplyAlpha(pixels);
+				stream.WriteBuffer(Buffer(pixels.data(), pixels.size()));
+			}
+			else
+			{
+				stream.WriteBuffer(Buffer(image.getPixelsPtr(), (uint64_t)size.x * size.y * 4));
+			}
+		}
+		else
+		{
+			auto encoded = image.saveToMemory("png");
+			if (!encoded)
+				return false;
+
+			header.Format = (uint16_t)TexturePackFormat::Encoded;
+			stream.WriteRaw(header);
+			stream.WriteBuffer(Buffer(encoded->data(), encoded->size()));
+		}
+
+		outInfo.Size = stream.GetStreamPosition() - outInfo.Offset;
+		return true;
+	}
+
+	std::shared_ptr<Resource> TextureSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
 	{
 		stream.SetStreamPosition(resourceInfo.PackedOffset);
 
-		Buffer textureData;
-		stream.ReadBuffer(textureData);
+		ResourcePackFile::TextureHeader header;
+		stream.ReadRaw(header);
 
-		auto texture = std::make_shared<Texture>();
-		sf::Texture sfTexture;
-		if (!sfTexture.loadFromMemory(textureData.Data, textureData.GetSize()))
+		BufferView textureData;
+		if (!stream.ReadBufferView(textureData))
 			return nullptr;
 
-		texture->SetTexture(sfTexture);
+		auto texture = std::make_shared<Texture>();
+		texture->SetGenerateMipmap(header.Flags & (uint16_t)TexturePackFlag::GenerateMipmap);
+		texture->SetPremultipliedAlpha(header.Flags & (uint16_t)TexturePackFlag::PremultipliedAlpha);
+
+		switch ((TexturePackFormat)header.Format)
+		{
+			case TexturePackFormat::RGBA8:
+			{
+				if (header.Width == 0 || header.Height == 0 || textureData.GetSize() != (uint64_t)header.Width * header.Height * 4)
+				{
+					std::cerr << "[TextureSerializer] Texture " << resourceInfo.Handle << " has " << textureData.GetSize() << " bytes of pixels for " << header.Width << "x" << header.Height << std::endl;
+					return nullptr;
+				}
+
+				// Uncompressed entries are uploaded straight from the mapped pack, which stays mapped while the resource
+				// manager holds it. Compressed ones were decompressed into a buffer that does not outlive the load
+				if (resourceInfo.Flags & (uint16_t)ResourcePackFlag::CompressedLZ4)
+				{
+					const uint8_t* pixels = (const uint8_t*)textureData.Data;
+					texture->SetPendingPixels({ header.Width, header.Height }, std::vector<uint8_t>(pixels, pixels + textureData.GetSize()));
+				}
+				else
+				{
+					texture->SetPendingPixels({ header.Width, header.Height }, textureData);
+				}
+				break;
+			}
+			case TexturePackFormat::Encoded:
+			{
+				sf::Image image;
+				if (!image.loadFromMemory(textureData.Data, textureData.GetSize()))
+					return nullptr;
+
+				// Source files are never premultiplied, that happens here off the main thread
+				if (texture->HasPremultipliedAlpha())
+				{
+					sf::Vector2u size = image.getSize();
+					std::vector<uint8_t> pixels(image.getPixelsPtr(), image.getPixelsPtr() + (uint64_t)size.x * size.y * 4);
+					PremultiplyAlpha(pixels);
+					texture->SetPendingPixels(size, std::move(pixels));
+				}
+				else
+				{
+					texture->SetPendingImage(std::move(image));
+				}
+				break;
+			}
+			default:
+				std::cerr << "[TextureSerializer] Texture " << resourceInfo.Handle << " has unknown format " << header.Format << std::endl;
+				return nullptr;
+		}
+
 		return texture;
 	}
 
+	bool TextureSerializer::FinalizeResource(const std::shared_ptr<Resource>& resource) const
+	{
+		auto texture = std::static_pointer_cast<Texture>(resource);
+		if (!texture->UploadPendingImage())
+			return false;
+
+		if (texture->GeneratesMipmap() && !texture->GetTexture().generateMipmap())
+			std::cerr << "[TextureSerializer] Could not generate mipmaps for texture " << texture->Handle << std::endl;
+
+		return true;
+	}
+
+	bool TextureSerializer::FinalizeResourceStep(const std::shared_ptr<Resource>& resource, uint64_t& budgetBytes) const
+	{
+		auto texture = std::static_pointer_cast<Texture>(resource);
+		if (texture->HasPendingRows() && budgetBytes > 0)
+			budgetBytes -= std::min(budgetBytes, texture->UploadPendingRows(budgetBytes));
+
+		return !texture->HasPendingRows();
+	}
+
 	//////////////////////////////////////////////////////////////////////////////////
 	// FontSerializer
 	//////////////////////////////////////////////////////////////////////////////////
@@ -295,25 +461,31 @@ namespace Luden
 		return true;
 	}
 
-	bool FontSerializer::SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	bool FontSerializer::SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	{
+		return SerializeFileToResourcePack(Project::GetEditorResourceManager()->GetFileSystemPath(handle), stream, outInfo);
+	}
+
+	bool FontSerializer::SerializeFileToResourcePack(const std::filesystem::path& path, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
 	{
 		outInfo.Offset = stream.GetStreamPosition();
 
-		std::shared_ptr<Font> font = ResourceManager::GetResource<Font>(handle);
-		auto path = Project::GetEditorResourceManager()->GetFileSystemPath(handle);
 		Buffer fontData = FileSystem::ReadBytes(path);
 		stream.WriteBuffer(fontData);
+		fontData.Release();
 
 		outInfo.Size = stream.GetStreamPosition() - outInfo.Offset;
 		return true;
 	}
 
-	std::shared_ptr<Resource> FontSerializer::DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
+	std::shared_ptr<Resource> FontSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
 	{
 		stream.SetStreamPosition(resourceInfo.PackedOffset);
 
-		Buffer fontData;
-		stream.ReadBuffer(fontData);
+		// sf::Font reads the file data lazily, the view stays valid as long as the resource pack is mapped
+		BufferView fontData;
+		if (!stream.ReadBufferView(fontData))
+			return nullptr;
 
 		auto font = std::make_shared <Font>();
 		sf::Font sfFont;
@@ -345,39 +517,36 @@ namespace Luden
 		return true;
 	}
 
-	bool SoundResourceSerializer::SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	bool SoundResourceSerializer::SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
 	{
-		/*
-		outInfo.Offset = stream.GetStreamPosition();
-
-		std::shared_ptr<SoundBuffer> sounfBuffer = ResourceManager::GetResource<SoundBuffer>(handle);
-		auto path = Project::GetEditorResourceManager()->GetFileSystemPath(handle);
-		auto relativePath = std::filesystem::relative(path, Project::GetActiveResourceDirectory());
+		return SerializeFileToResourcePack(Project::GetEditorResourceManager()->GetFileSystemPath(handle), stream, outInfo);
+	}
 
-		std::string filePath;
-		if (relativePath.empty())
-			filePath = path.string();
-		else
-			filePath = relativePath.string();
+	bool SoundResourceSerializer::SerializeFileToResourcePack(const std::filesystem::path& path, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	{
+		outInfo.Offset = stream.GetStreamPosition();
 
-		stream.WriteString(filePath);
+		Buffer soundData = FileSystem::ReadBytes(path);
+		stream.WriteBuffer(soundData);
+		soundData.Release();
 
 		outInfo.Size = stream.GetStreamPosition() - outInfo.Offset;
-
-		return true;
-		*/
 		return true;
 	}
 
-	std::shared_ptr<Resource> SoundResourceSerializer::DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
+	std::shared_ptr<Resource> SoundResourceSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
 	{
 		stream.SetStreamPosition(resourceInfo.PackedOffset);
-		std::shared_ptr<Sound> audioFile = std::shared_ptr<Sound>();
 
-		std::string pathString= audioFile->GetFilePath().string();
-		stream.ReadString(pathString);
+		BufferView soundData;
+		if (!stream.ReadBufferView(soundData))
+			return nullptr;
 
-		return audioFile;
+		auto sound = std::make_shared<Sound>();
+		if (!sound->GetSoundBuffer().loadFromMemory(soundData.Data, soundData.GetSize()))
+			return nullptr;
+
+		return sound;
 	}
 
 	//////////////////////////////////////////////////////////////////////////////////
@@ -399,39 +568,37 @@ namespace Luden
 		return true;
 	}
 
-	bool MusicResourceSerializer::SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	bool MusicResourceSerializer::SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
 	{
-		/*
-		outInfo.Offset = stream.GetStreamPosition();
-
-		std::shared_ptr<SoundBuffer> sounfBuffer = ResourceManager::GetResource<SoundBuffer>(handle);
-		auto path = Project::GetEditorResourceManager()->GetFileSystemPath(handle);
-		auto relativePath = std::filesystem::relative(path, Project::GetActiveResourceDirectory());
+		return SerializeFileToResourcePack(Project::GetEditorResourceManager()->GetFileSystemPath(handle), stream, outInfo);
+	}
 
-		std::string filePath;
-		if (relativePath.empty())
-			filePath = path.string();
-		else
-			filePath = relativePath.string();
+	bool MusicResourceSerializer::SerializeFileToResourcePack(const std::filesystem::path& path, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	{
+		outInfo.Offset = stream.GetStreamPosition();
 
-		stream.WriteString(filePath);
+		Buffer musicData = FileSystem::ReadBytes(path);
+		stream.WriteBuffer(musicData);
+		musicData.Release();
 
 		outInfo.Size = stream.GetStreamPosition() - outInfo.Offset;
-
-		return true;
-		*/
 		return true;
 	}
 
-	std::shared_ptr<Resource> MusicResourceSerializer::DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
+	std::shared_ptr<Resource> MusicResourceSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
 	{
 		stream.SetStreamPosition(resourceInfo.PackedOffset);
-		std::shared_ptr<Music> audioFile = std::shared_ptr<Music>();
 
-		std::string pathString= audioFile->GetFilePath().string();
-		stream.ReadString(pathString);
+		// Music is streamed while it plays, straight from the mapped resource pack
+		BufferView musicData;
+		if (!stream.ReadBufferView(musicData))
+			return nullptr;
+
+		auto music = std::make_shared<Music>();
+		if (!music->GetMusic().openFromMemory(musicData.Data, musicData.GetSize()))
+			return nullptr;
 
-		return audioFile;
+		return music;
 	}
 
 	//////////////////////////////////////////////////////////////////////////////////
@@ -500,7 +667,7 @@ namespace Luden
 		return true;
 	}
 
-	bool PrefabSerializer::SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	bool PrefabSerializer::SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
 	{
 		outInfo.Offset = stream.GetStreamPosition();
 
@@ -529,7 +696,7 @@ namespace Luden
 		return true;
 	}
 
-	std::shared_ptr<Resource> PrefabSerializer::DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
+	std::shared_ptr<Resource> PrefabSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
 	{
 		stream.SetStreamPosition(resourceInfo.PackedOffset);
 
@@ -592,9 +759,9 @@ namespace Luden
 		return true;
 	}
 
-	bool SceneResourceSerializer::SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	bool SceneResourceSerializer::SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
 	{
-		std::shared_ptr<Scene> scene = std::shared_ptr<Scene>();
+		std::shared_ptr<Scene> scene = std::make_shared<Scene>();
 		const auto& metadata = Project::GetEditorResourceManager()->GetMetadata(handle);
 		SceneSerializer serializer(scene);
 		if (serializer.Deserialize(Project::GetActiveResourceDirectory() / metadata.FilePath))
@@ -604,12 +771,12 @@ namespace Luden
 		return false;
 	}
 
-	std::shared_ptr<Luden::Resource> SceneResourceSerializer::DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
+	std::shared_ptr<Luden::Resource> SceneResourceSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
 	{
 		return nullptr;
 	}
 
-	std::shared_ptr<Scene> SceneResourceSerializer::DeserializeSceneFromResourcePack(FileStreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo) const
+	std::shared_ptr<Scene> SceneResourceSerializer::DeserializeSceneFromResourcePack(StreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo) const
 	{
 		std::shared_ptr<Scene> scene = std::make_shared<Scene>();
 		SceneSerializer serializer(scene);
@@ -698,7 +865,7 @@ namespace Luden
 		return true;
 	}
 
-	bool AnimationResourceSerializer::SerializeToResourcePack(ResourceHandle handle, FileStreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	bool AnimationResourceSerializer::SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
 	{
 		outInfo.Offset = stream.GetStreamPosition();
 
@@ -733,7 +900,7 @@ namespace Luden
 		return true;
 	}
 
-	std::shared_ptr<Resource> AnimationResourceSerializer::DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
+	std::shared_ptr<Resource> AnimationResourceSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
 	{
 		stream.SetStreamPosition(resourceInfo.PackedOffset);
 
@@ -771,4 +938,238 @@ namespace Luden
 		return anim;
 	}
 
+	//////////////////////////////////////////////////////////////////////////////////
+	// TilesetSerializer
+	//////////////////////////////////////////////////////////////////////////////////
+
+	static nlohmann::json TilesetToJSON(const Tileset& tileset)
+	{
+		nlohmann::json j;
+		j["Name"] = tileset.GetName();
+		j["TextureHandle"] = static_cast<uint64_t>(tileset.GetTextureHandle());
+		j["TileSize"] = { tileset.GetTileSize().x, tileset.GetTileSize().y };
+		j["Columns"] = tileset.GetColumns();
+		j["TileCount"] = tileset.GetTileCount();
+		j["Margin"] = tileset.GetMargin();
+		j["Spacing"] = tileset.GetSpacing();
+
+		std::vector<uint32_t> solidTiles(tileset.GetSolidTiles().begin(), tileset.GetSolidTiles().end());
+		std::sort(solidTiles.begin(), solidTiles.end());
+		j["SolidTiles"] = solidTiles;
+
+		j["Handle"] = static_cast<uint64_t>(tileset.Handle);
+		return j;
+	}
+
+	static std::shared_ptr<Tileset> TilesetFromJSON(const nlohmann::json& j)
+	{
+		auto tileset = std::make_shared<Tileset>();
+
+		if (j.contains("Name"))
+			tileset->SetName(j["Name"].get<std::string>());
+
+		tileset->SetTextureHandle(j.value("TextureHandle", (uint64_t)0));
+
+		if (j.contains("TileSize"))
+			tileset->SetTileSize({ j["TileSize"][0].get<uint32_t>(), j["TileSize"][1].get<uint32_t>() });
+
+		tileset->SetColumns(j.value("Columns", 1u));
+		tileset->SetTileCount(j.value("TileCount", 0u));
+		tileset->SetMargin(j.value("Margin", 0u));
+		tileset->SetSpacing(j.value("Spacing", 0u));
+
+		if (j.contains("SolidTiles"))
+		{
+			for (const auto& tileIndex : j["SolidTiles"])
+				tileset->SetTileSolid(tileIndex.get<uint32_t>(), true);
+		}
+
+		tileset->Handle = j.value("Handle", (uint64_t)0);
+		return tileset;
+	}
+
+	void TilesetSerializer::Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const
+	{
+		auto tileset = std::static_pointer_cast<Tileset>(resource);
+
+		std::ofstream out(Project::GetEditorResourceManager()->GetFileSystemPath(metadata));
+		if (out.is_open())
+		{
+			out << TilesetToJSON(*tileset).dump(4);
+		}
+	}
+
+	bool TilesetSerializer::TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const
+	{
+		auto path = Project::GetEditorResourceManager()->GetFileSystemPath(metadata);
+
+		std::ifstream in(path);
+		if (!in.is_open())
+			return false;
+
+		nlohmann::json j;
+		in >> j;
+
+		resource = TilesetFromJSON(j);
+		return true;
+	}
+
+	bool TilesetSerializer::SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	{
+		outInfo.Offset = stream.GetStreamPosition();
+
+		auto tileset = ResourceManager::GetResource<Tileset>(handle);
+		if (!tileset)
+			return false;
+
+		std::string jsonStr = TilesetToJSON(*tileset).dump();
+		stream.WriteString(jsonStr);
+
+		outInfo.Size = stream.GetStreamPosition() - outInfo.Offset;
+		return true;
+	}
+
+	std::shared_ptr<Resource> TilesetSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
+	{
+		stream.SetStreamPosition(resourceInfo.PackedOffset);
+
+		std::string jsonStr;
+		stream.ReadString(jsonStr);
+
+		return TilesetFromJSON(nlohmann::json::parse(jsonStr));
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+	// ParticleEmitterSerializer
+	//////////////////////////////////////////////////////////////////////////////////
+
+	static nlohmann::json ParticleEmitterToJSON(const ParticleEmitter& emitter)
+	{
+		nlohmann::json j;
+		j["Name"] = emitter.GetName();
+		j["SpriteHandle"] = static_cast<uint64_t>(emitter.SpriteHandle);
+		j["MaxParticles"] = emitter.MaxParticles;
+		j["EmissionRate"] = emitter.EmissionRate;
+		j["BurstCount"] = emitter.BurstCount;
+		j["Duration"] = emitter.Duration;
+		j["Looping"] = emitter.Looping;
+		j["WorldSpace"] = emitter.WorldSpace;
+		j["Lifetime"] = { emitter.LifetimeMin, emitter.LifetimeMax };
+		j["Speed"] = { emitter.SpeedMin, emitter.SpeedMax };
+		j["Direction"] = emitter.Direction;
+		j["Spread"] = emitter.Spread;
+		j["Gravity"] = { emitter.Gravity.x, emitter.Gravity.y };
+		j["Drag"] = emitter.Drag;
+		j["StartColor"] = { emitter.StartColor.r, emitter.StartColor.g, emitter.StartColor.b, emitter.StartColor.a };
+		j["EndColor"] = { emitter.EndColor.r, emitter.EndColor.g, emitter.EndColor.b, emitter.EndColor.a };
+		j["StartSize"] = emitter.StartSize;
+		j["EndSize"] = emitter.EndSize;
+		j["Handle"] = static_cast<uint64_t>(emitter.Handle);
+		return j;
+	}
+
+	static std::shared_ptr<ParticleEmitter> ParticleEmitterFromJSON(const nlohmann::json& j)
+	{
+		auto emitter = std::make_shared<ParticleEmitter>();
+
+		if (j.contains("Name"))
+			emitter->SetName(j["Name"].get<std::string>());
+
+		emitter->SpriteHandle = j.value("SpriteHandle", (uint64_t)0);
+		emitter->MaxParticles = j.value("MaxParticles", emitter->MaxParticles);
+		emitter->EmissionRate = j.value("EmissionRate", emitter->EmissionRate);
+		emitter->BurstCount = j.value("BurstCount", emitter->BurstCount);
+		emitter->Duration = j.value("Duration", emitter->Duration);
+		emitter->Looping = j.value("Looping", emitter->Looping);
+		emitter->WorldSpace = j.value("WorldSpace", emitter->WorldSpace);
+
+		if (j.contains("Lifetime"))
+		{
+			emitter->LifetimeMin = j["Lifetime"][0].get<float>();
+			emitter->LifetimeMax = j["Lifetime"][1].get<float>();
+		}
+
+		if (j.contains("Speed"))
+		{
+			emitter->SpeedMin = j["Speed"][0].get<float>();
+			emitter->SpeedMax = j["Speed"][1].get<float>();
+		}
+
+		emitter->Direction = j.value("Direction", emitter->Direction);
+		emitter->Spread = j.value("Spread", emitter->Spread);
+
+		if (j.contains("Gravity"))
+			emitter->Gravity = { j["Gravity"][0].get<float>(), j["Gravity"][1].get<float>() };
+
+		emitter->Drag = j.value("Drag", emitter->Drag);
+
+		if (j.contains("StartColor"))
+		{
+			const auto& jColor = j["StartColor"];
+			emitter->StartColor = sf::Color(jColor[0].get<uint8_t>(), jColor[1].get<uint8_t>(), jColor[2].get<uint8_t>(), jColor[3].get<uint8_t>());
+		}
+
+		if (j.contains("EndColor"))
+		{
+			const auto& jColor = j["EndColor"];
+			emitter->EndColor = sf::Color(jColor[0].get<uint8_t>(), jColor[1].get<uint8_t>(), jColor[2].get<uint8_t>(), jColor[3].get<uint8_t>());
+		}
+
+		emitter->StartSize = j.value("StartSize", emitter->StartSize);
+		emitter->EndSize = j.value("EndSize", emitter->EndSize);
+
+		emitter->Handle = j.value("Handle", (uint64_t)0);
+		return emitter;
+	}
+
+	void ParticleEmitterSerializer::Serialize(const ResourceMetadata& metadata, const std::shared_ptr<Resource>& resource) const
+	{
+		auto emitter = std::static_pointer_cast<ParticleEmitter>(resource);
+
+		std::ofstream out(Project::GetEditorResourceManager()->GetFileSystemPath(metadata));
+		if (out.is_open())
+		{
+			out << ParticleEmitterToJSON(*emitter).dump(4);
+		}
+	}
+
+	bool ParticleEmitterSerializer::TryLoadData(const ResourceMetadata& metadata, std::shared_ptr<Resource>& resource) const
+	{
+		auto path = Project::GetEditorResourceManager()->GetFileSystemPath(metadata);
+
+		std::ifstream in(path);
+		if (!in.is_open())
+			return false;
+
+		nlohmann::json j;
+		in >> j;
+
+		resource = ParticleEmitterFromJSON(j);
+		return true;
+	}
+
+	bool ParticleEmitterSerializer::SerializeToResourcePack(ResourceHandle handle, StreamWriter& stream, ResourceSerializationInfo& outInfo) const
+	{
+		outInfo.Offset = stream.GetStreamPosition();
+
+		auto emitter = ResourceManager::GetResource<ParticleEmitter>(handle);
+		if (!emitter)
+			return false;
+
+		std::string jsonStr = ParticleEmitterToJSON(*emitter).dump();
+		stream.WriteString(jsonStr);
+
+		outInfo.Size = stream.GetStreamPosition() - outInfo.Offset;
+		return true;
+	}
+
+	std::shared_ptr<Resource> ParticleEmitterSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::ResourceInfo& resourceInfo) const
+	{
+		stream.SetStreamPosition(resourceInfo.PackedOffset);
+
+		std::string jsonStr;
+		stream.ReadString(jsonStr);
+
+		return ParticleEmitterFromJSON(nlohmann::json::parse(jsonStr));
+	}
 }
\ No newline at end of file
@@ -7,6 +7,9 @@
 
 namespace Luden {
 
+	// Main thread finalize work per Update, large textures upload over several frames
+	static constexpr uint64_t FinalizeBudgetPerUpdate = 8ull << 20;
+
 	RuntimeResourceManager::RuntimeResourceManager()
 	{
 		ResourceImporter::Init();
@@ -14,6 +17,14 @@ namespace Luden {
 
 	RuntimeResourceManager::~RuntimeResourceManager()
 	{
+		Shutdown();
+	}
+
+	void RuntimeResourceManager::Shutdown()
+	{
+		// Fails every request still in flight, decoded ones waiting to be finalized included
+		m_Loader.Shutdown();
+		m_DecodedRequests.clear();
 	}
 
 	ResourceType RuntimeResourceManager::GetResourceType(ResourceHandle resourceHandle)
@@ -27,25 +38,96 @@ namespace Luden {
 
 	std::shared_ptr<Resource> RuntimeResourceManager::GetResource(ResourceHandle resourceHandle)
 	{
-		std::shared_ptr<Resource> resource = nullptr;
-		if (IsResourceLoaded(resourceHandle))
+		auto it = m_LoadedResources.find(resourceHandle);
+		if (it != m_LoadedResources.end())
+		{
+			m_CacheStats.Hits++;
+			TouchResource(resourceHandle);
+			return it->second;
+		}
+
+		m_CacheStats.Misses++;
+		std::shared_ptr<Resource> resource = m_ResourcePack->LoadResource(resourceHandle);
+		if (resource)
+			AddLoadedResource(resourceHandle, resource);
+
+		return resource;
+	}
+
+	ResourceFuture RuntimeResourceManager::GetResourceAsync(ResourceHandle resourceHandle)
+	{
+		auto it = m_LoadedResources.find(resourceHandle);
+		if (it != m_LoadedResources.end())
 		{
-			resource = m_LoadedResources[resourceHandle];
+			m_CacheStats.Hits++;
+			TouchResource(resourceHandle);
+			return ResourceFuture::MakeFinished(resourceHandle, it->second);
 		}
-		else
+
+		if (!m_Loader.IsRunning() || !ResourceImporter::CanDeserializeAsync(m_ResourcePack->GetResourceType(resourceHandle)))
+			return ResourceFuture::MakeFinished(resourceHandle, GetResource(resourceHandle));
+
+		m_CacheStats.Misses++;
+		return m_Loader.Load(resourceHandle);
+	}
+
+	void RuntimeResourceManager::PrefetchScene(ResourceHandle sceneHandle)
+	{
+		if (!m_ResourcePack)
+			return;
+
+		for (ResourceHandle resourceHandle : m_ResourcePack->GetSceneDependencies(sceneHandle))
 		{
-			resource = m_ResourcePack->LoadResource(m_ActiveScene, resourceHandle);
+			if (!IsResourceLoaded(resourceHandle))
+				GetResourceAsync(resourceHandle);
+		}
+	}
+
+	void RuntimeResourceManager::Update()
+	{
+		m_Loader.TakeDecoded(m_DecodedRequests);
+
+		// Requests that run out of budget stay for the next Update, in the order they were decoded
+		uint64_t finalizeBudget = FinalizeBudgetPerUpdate;
+		size_t unfinishedCount = 0;
+		for (size_t i = 0; i < m_DecodedRequests.size(); i++)
+		{
+			std::shared_ptr<ResourceLoadRequest> request = m_DecodedRequests[i];
+
+			// Loaded synchronously while it was in flight, keep the instance everyone already uses
+			auto it = m_LoadedResources.find(request->Handle);
+			if (it != m_LoadedResources.end())
+			{
+				m_Loader.Finish(request, it->second);
+				continue;
+			}
+
+			std::shared_ptr<Resource> resource = request->Result;
+			if (resource && !ResourceImporter::FinalizeResourceStep(resource, finalizeBudget))
+			{
+				m_DecodedRequests[unfinishedCount++] = request;
+				continue;
+			}
+
+			if (resource && !ResourceImporter::FinalizeResource(resource))
+				resource = nullptr;
+
 			if (resource)
-				m_LoadedResources[resourceHandle] = resource;
+				AddLoadedResource(request->Handle, resource);
+
+			m_Loader.Finish(request, resource);
 		}
-		return resource;
+
+		m_DecodedRequests.resize(unfinishedCount);
+
+		TrimToBudget();
 	}
 
 	bool RuntimeResourceManager::ReloadData(ResourceHandle resourceHandle)
 	{
-		std::shared_ptr<Resource> resource = m_ResourcePack->LoadResource(m_ActiveScene, resourceHandle);
+		std::shared_ptr<Resource> resource = m_ResourcePack->LoadResource(resourceHandle);
 		if (resource)
-			m_LoadedResources[resourceHandle] = resource;
+			AddLoadedResource(resourceHandle, resource);
 
 		if (resource == nullptr)
 			return false;
@@ -91,9 +173,7 @@ namespace Luden {
 
 	void RuntimeResourceManager::RemoveResource(ResourceHandle handle)
 	{
-		if (m_LoadedResources.contains(handle))
-			m_LoadedResources.erase(handle);
-
+		ReleaseResource(handle);
 	}
 
 	std::unordered_set<ResourceHandle> RuntimeResourceManager::GetAllResourcesWithType(ResourceType type)
@@ -106,15 +186,152 @@ namespace Luden {
 	std::shared_ptr<Scene> RuntimeResourceManager::LoadScene(ResourceHandle handle)
 	{
 		std::shared_ptr<Scene> scene = m_ResourcePack->LoadScene(handle);
-		if (scene)
-			m_ActiveScene = handle;
+		if (!scene)
+			return nullptr;
 
+		// The previous scene's resources can be evicted from now on, unless the new scene uses them too
+		if (handle != m_ActiveScene)
+		{
+			PinSceneDependencies(handle);
+			if (m_ActiveScene)
+				UnpinSceneDependencies(m_ActiveScene);
+		}
+
+		m_ActiveScene = handle;
 		return scene;
 	}
 
+	void RuntimeResourceManager::PinResource(ResourceHandle resourceHandle)
+	{
+		m_PinCounts[resourceHandle]++;
+		m_CacheStats.PinnedCount = (uint32_t)m_PinCounts.size();
+	}
+
+	void RuntimeResourceManager::UnpinResource(ResourceHandle resourceHandle)
+	{
+		auto it = m_PinCounts.find(resourceHandle);
+		if (it == m_PinCounts.end())
+			return;
+
+		if (--it->second == 0)
+			m_PinCounts.erase(it);
+
+		m_CacheStats.PinnedCount = (uint32_t)m_PinCounts.size();
+	}
+
+	void RuntimeResourceManager::PinSceneDependencies(ResourceHandle sceneHandle)
+	{
+		if (!m_ResourcePack)
+			return;
+
+		for (ResourceHandle resourceHandle : m_ResourcePack->GetSceneDependencies(sceneHandle))
+			PinResource(resourceHandle);
+	}
+
+	void RuntimeResourceManager::UnpinSceneDependencies(ResourceHandle sceneHandle)
+	{
+		if (!m_ResourcePack)
+			return;
+
+		for (ResourceHandle resourceHandle : m_ResourcePack->GetSceneDependencies(sceneHandle))
+			UnpinResource(resourceHandle);
+	}
+
+	void RuntimeResourceManager::AddLoadedResource(ResourceHandle resourceHandle, const std::shared_ptr<Resource>& resource)
+	{
+		ReleaseResource(resourceHandle);
+
+		// Types that do not know their size are counted with their size in the pack
+		uint64_t size = resource->GetMemorySize();
+		if (size == 0 && m_ResourcePack)
+		{
+			const ResourcePackFile::ResourceInfo* resourceInfo = m_ResourcePack->FindResourceInfo(resourceHandle);
+			if (resourceInfo)
+				size = resourceInfo->UnpackedSize;
+		}
+
+		m_LruList.push_front(resourceHandle);
+
+		CacheEntry& entry = m_CacheEntries[resourceHandle];
+		entry.Size = size;
+		entry.Type = resource->GetResourceType();
+		entry.LruPosition = m_LruList.begin();
+
+		m_LoadedResources[resourceHandle] = resource;
+
+		m_CacheStats.ResidentBytes += size;
+		m_CacheStats.ResidentBytesByType[(uint32_t)entry.Type % ResourceTypeCount] += size;
+		m_CacheStats.ResidentCount = (uint32_t)m_CacheEntries.size();
+	}
+
+	void RuntimeResourceManager::ReleaseResource(ResourceHandle resourceHandle)
+	{
+		m_LoadedResources.erase(resourceHandle);
+
+		auto it = m_CacheEntries.find(resourceHandle);
+		if (it == m_CacheEntries.end())
+			return;
+
+		const CacheEntry& entry = it->second;
+		m_CacheStats.ResidentBytes -= entry.Size;
+		m_CacheStats.ResidentBytesByType[(uint32_t)entry.Type % ResourceTypeCount] -= entry.Size;
+
+		m_LruList.erase(entry.LruPosition);
+		m_CacheEntries.erase(it);
+		m_CacheStats.ResidentCount = (uint32_t)m_CacheEntries.size();
+	}
+
+	void RuntimeResourceManager::TouchResource(ResourceHandle resourceHandle)
+	{
+		auto it = m_CacheEntries.find(resourceHandle);
+		if (it != m_CacheEntries.end())
+			m_LruList.splice(m_LruList.begin(), m_LruList, it->second.LruPosition);
+	}
+
+	void RuntimeResourceManager::TrimToBudget()
+	{
+		uint64_t budget = m_CacheStats.BudgetBytes;
+		if (budget == 0 || m_CacheStats.ResidentBytes <= budget)
+			return;
+
+		// Least recently used first. Pinned resources and the ones still held outside the manager stay
+		std::vector<ResourceHandle> evicted;
+		uint64_t residentBytes = m_CacheStats.ResidentBytes;
+		for (auto it = m_LruList.rbegin(); it != m_LruList.rend() && residentBytes > budget; ++it)
+		{
+			ResourceHandle resourceHandle = *it;
+			if (m_PinCounts.contains(resourceHandle))
+				continue;
+
+			auto resourceIt = m_LoadedResources.find(resourceHandle);
+			if (resourceIt != m_LoadedResources.end() && resourceIt->second.use_count() > 1)
+				continue;
+
+			residentBytes -= m_CacheEntries[resourceHandle].Size;
+			evicted.push_back(resourceHandle);
+		}
+
+		for (ResourceHandle resourceHandle : evicted)
+			ReleaseResource(resourceHandle);
+
+		m_CacheStats.Evictions += evicted.size();
+	}
+
 	void RuntimeResourceManager::SetResourcePack(std::shared_ptr<ResourcePack> resourcePack)
 	{
+		// Decoded textures can still point into the old pack's mapping, shutting the loader down fails them
+		m_Loader.Shutdown();
+		m_DecodedRequests.clear();
+
 		m_ResourcePack = resourcePack;
+
+		if (!m_ResourcePack)
+			return;
+
+		m_Loader.Init([resourcePack](ResourceHandle resourceHandle)
+			{
+				return resourcePack->DecodeResource(resourceHandle);
+			});
 	}
 
 }
@@ -25,6 +25,9 @@ namespace Luden {
         sourceScene->CopyComponentIfExists<RigidBody2DComponent>(newEntity, entity);
         sourceScene->CopyComponentIfExists<BoxCollider2DComponent>(newEntity, entity);
         sourceScene->CopyComponentIfExists<CircleCollider2DComponent>(newEntity, entity);
+        sourceScene->CopyComponentIfExists<CapsuleCollider2DComponent>(newEntity, entity);
+        sourceScene->CopyComponentIfExists<PolygonCollider2DComponent>(newEntity, entity);
+        sourceScene->CopyComponentIfExists<ChainCollider2DComponent>(newEntity, entity);
         sourceScene->CopyComponentIfExists<NativeScriptComponent>(newEntity, entity);
         sourceScene->CopyComponentIfExists<SpriteAnimatorComponent>(newEntity, entity);
         sourceScene->CopyComponentIfExists<TextComponent>(newEntity, entity);
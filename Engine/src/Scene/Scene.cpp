@@ -8,8 +8,10 @@
 #include "Graphics/AnimationManager.h"
 #include "Graphics/Sprite.h"
 #include "Physics2D/Physics2DManager.h"
+#include "IO/MemoryStream.h"
 
 #include <iostream>
+#include <cmath>
 
 #include <glm/glm.hpp>
 #include <SFML/Graphics.hpp>
@@ -31,20 +33,25 @@ namespace Luden {
 		InputManager::Instance().ClearAllInput();
 	}
 
-	void Scene::OnUpdateRuntime(TimeStep ts, std::shared_ptr<sf::RenderTexture> renderTexture) {
-		SetViewportSize(renderTexture->getSize().x, renderTexture->getSize().y);
+	void Scene::OnUpdateRuntime(TimeStep ts, sf::RenderTarget& target) {
+		sf::Vector2u resolution = ResolveRenderResolution(target);
+		SetViewportSize(resolution.x, resolution.y);
 
 		Entity cameraEntity = GetMainCameraEntity();
 
 		if (!cameraEntity.IsValid())
 			return;
 
+		// A paused scene draws the simulated pose, so inspector edits and single steps show up right away
+		if (m_Paused)
+			m_PhysicsManager.ResetInterpolation();
+
 		Camera2D& camera = cameraEntity.Get<Camera2DComponent>();
 		camera.SetAttachedEntity(&cameraEntity);
 		camera.SetViewportSize({ (float)m_ViewportWidth, (float)m_ViewportHeight });
 		camera.Update(ts);
 
-		OnRenderRuntime(renderTexture, camera);
+		OnRenderRuntime(target, camera);
 
 		GEngine.SetDeltaTime(static_cast<float>(ts));
 		GEngine.SetGameTime(GEngine.GetGameTime() + static_cast<float>(ts) * GEngine.GetTimeScale());
@@ -65,7 +72,23 @@ namespace Luden {
 			}
 		}
 
-		m_PhysicsManager.Update(ts);
+		m_FixedAccumulator += static_cast<float>(ts);
+
+		int fixedSteps = 0;
+		while (m_FixedAccumulator >= m_FixedTimeStep && fixedSteps < m_MaxFixedSteps)
+		{
+			OnFixedUpdate(m_FixedTimeStep);
+			m_FixedAccumulator -= m_FixedTimeStep;
+			fixedSteps++;
+		}
+
+		// Drop the backlog after a hitch instead of catching up over the next frames
+		if (m_FixedAccumulator >= m_FixedTimeStep)
+			m_FixedAccumulator = std::fmod(m_FixedAccumulator, m_FixedTimeStep);
+
+		m_PhysicsManager.InterpolateTransforms(GetInterpolationAlpha());
+
+		UpdateParticles(ts);
 		InputManager::Instance().Update(ts, m_EntityManager);
 		DebugManager::Instance().Update(ts);
 		AnimationManager::Instance().Update(ts);
@@ -73,25 +96,264 @@ namespace Luden {
 		m_EntityManager.Update(ts);
 	}
 
-	void Scene::OnUpdateEditor(TimeStep ts, std::shared_ptr<sf::RenderTexture> renderTexture, Camera2D& editorCamera)
+	void Scene::OnUpdateEditor(TimeStep ts, sf::RenderTarget& target, Camera2D& editorCamera)
 	{
-		SetViewportSize(renderTexture->getSize().x, renderTexture->getSize().y);
+		sf::Vector2u resolution = ResolveRenderResolution(target);
+		SetViewportSize(resolution.x, resolution.y);
 
 		editorCamera.SetViewportSize({ (float)m_ViewportWidth, (float)m_ViewportHeight });
 		editorCamera.Update(ts);
 
-		OnRenderEditor(renderTexture, editorCamera);
+		OnRenderEditor(target, editorCamera);
 		AnimationManager::Instance().Update(ts);
 		m_PhysicsManager.Update(ts);
+		UpdateParticles(ts);
 
 		m_EntityManager.Update(ts);
 	}
 
-	void Scene::OnRenderRuntime(std::shared_ptr<sf::RenderTexture> target, Camera2D& runtimeCamera)
+	void Scene::OnFixedUpdate(TimeStep ts)
+	{
+		for (auto& entity : GetEntityManager().GetEntities())
+		{
+			if (entity.Has<NativeScriptComponent>())
+			{
+				auto& nsc = entity.Get<NativeScriptComponent>();
+
+				if (nsc.Instance)
+				{
+					nsc.Instance->OnFixedUpdate(ts);
+				}
+			}
+		}
+
+		m_PhysicsManager.Update(ts);
+
+		m_FixedTick++;
+		if (m_SnapshotHistory.GetCapacity() > 0)
+			SaveSnapshot(m_SnapshotHistory.Acquire(m_FixedTick));
+	}
+
+	void Scene::StepFixed()
+	{
+		OnFixedUpdate(m_FixedTimeStep);
+	}
+
+	namespace
+	{
+		enum SnapshotRecordFlags : uint8_t
+		{
+			SnapshotTransform = 1 << 0,
+			SnapshotBody = 1 << 1,
+			SnapshotHealth = 1 << 2,
+			SnapshotScript = 1 << 3
+		};
+
+		struct TransformState
+		{
+			glm::vec3 Translation;
+			glm::vec3 Scale;
+			float Angle;
+		};
+
+		struct HealthState
+		{
+			int Max;
+			int Current;
+		};
+	}
+
+	void Scene::SaveSnapshot(SceneSnapshot& snapshot)
+	{
+		// Fixed size records written straight into the reused snapshot memory, scripts append their own state
+		MemoryStreamWriter writer(snapshot.Data);
+
+		uint32_t recordCount = 0;
+		writer.WriteRaw<uint32_t>(recordCount);
+
+		for (auto& entity : m_EntityManager.GetEntities())
+		{
+			PhysicsBodyState bodyState;
+			bool hasBody = m_PhysicsManager.SaveBodyState(entity, bodyState);
+			bool hasHealth = entity.Has<HealthComponent>();
+
+			ScriptableEntity* script = nullptr;
+			if (entity.Has<NativeScriptComponent>())
+				script = entity.Get<NativeScriptComponent>().Instance;
+
+			if (!hasBody && !hasHealth && !script)
+				continue;
+
+			uint8_t flags = 0;
+			if (entity.Has<TransformComponent>())
+				flags |= SnapshotTransform;
+			if (hasBody)
+				flags |= SnapshotBody;
+			if (hasHealth)
+				flags |= SnapshotHealth;
+			if (script)
+				flags |= SnapshotScript;
+
+			writer.WriteRaw<EntityHandle>(EntityMemoryPool::Instance().GetHandle(entity.UUID()));
+			writer.WriteRaw<uint8_t>(flags);
+
+			if (flags & SnapshotTransform)
+			{
+				const auto& transform = entity.Get<TransformComponent>();
+				writer.WriteRaw<TransformState>({ transform.Translation, transform.Scale, transform.angle });
+			}
+
+			if (hasBody)
+				writer.WriteRaw<PhysicsBodyState>(bodyState);
+
+			if (hasHealth)
+			{
+				const auto& health = entity.Get<HealthComponent>();
+				writer.WriteRaw<HealthState>({ health.max, health.current });
+			}
+
+			if (script)
+			{
+				// Size first so a restore can skip the state of an entity that no longer exists
+				uint64_t sizePosition = writer.GetStreamPosition();
+				writer.WriteRaw<uint32_t>(0);
+
+				script->OnSaveState(writer);
+
+				uint64_t endPosition = writer.GetStreamPosition();
+				writer.SetStreamPosition(sizePosition);
+				writer.WriteRaw<uint32_t>((uint32_t)(endPosition - sizePosition - sizeof(uint32_t)));
+				writer.SetStreamPosition(endPosition);
+			}
+
+			recordCount++;
+		}
+
+		uint64_t endPosition = writer.GetStreamPosition();
+		writer.SetStreamPosition(0);
+		writer.WriteRaw<uint32_t>(recordCount);
+		writer.SetStreamPosition(endPosition);
+	}
+
+	bool Scene::RestoreSnapshot(const SceneSnapshot& snapshot)
+	{
+		MemoryStreamReader reader(Buffer(snapshot.Data.data(), snapshot.Data.size()));
+
+		uint32_t recordCount = 0;
+		reader.ReadRaw<uint32_t>(recordCount);
+
+		for (uint32_t i = 0; i < recordCount && reader; i++)
+		{
+			EntityHandle handle = 0;
+			uint8_t flags = 0;
+			reader.ReadRaw<EntityHandle>(handle);
+			reader.ReadRaw<uint8_t>(flags);
+
+			EntityID entityID = EntityMemoryPool::Instance().ResolveHandle(handle);
+			Entity entity = entityID != 0 ? Entity(entityID, this) : Entity();
+
+			if (flags & SnapshotTransform)
+			{
+				TransformState state;
+				reader.ReadRaw<TransformState>(state);
+
+				if (entity.IsValid() && entity.Has<TransformComponent>())
+				{
+					auto& transform = entity.Get<TransformComponent>();
+					transform.Translation = state.Translation;
+					transform.Scale = state.Scale;
+					transform.angle = state.Angle;
+				}
+			}
+
+			if (flags & SnapshotBody)
+			{
+				PhysicsBodyState state;
+				reader.ReadRaw<PhysicsBodyState>(state);
+
+				if (entity.IsValid())
+					m_PhysicsManager.RestoreBodyState(entity, state);
+			}
+
+			if (flags & SnapshotHealth)
+			{
+				HealthState state;
+				reader.ReadRaw<HealthState>(state);
+
+				if (entity.IsValid() && entity.Has<HealthComponent>())
+				{
+					auto& health = entity.Get<HealthComponent>();
+					health.max = state.Max;
+					health.current = state.Current;
+				}
+			}
+
+			if (flags & SnapshotScript)
+			{
+				uint32_t size = 0;
+				reader.ReadRaw<uint32_t>(size);
+				uint64_t endPosition = reader.GetStreamPosition() + size;
+
+				if (entity.IsValid() && entity.Has<NativeScriptComponent>() && entity.Get<NativeScriptComponent>().Instance)
+				{
+					entity.Get<NativeScriptComponent>().Instance->OnLoadState(reader);
+
+					if (reader.GetStreamPosition() != endPosition)
+						std::cerr << "[Scene] Script of entity " << (uint64_t)entityID << " did not read back the state it saved" << std::endl;
+				}
+
+				reader.SetStreamPosition(endPosition);
+			}
+		}
+
+		if (!reader)
+		{
+			std::cerr << "[Scene] Snapshot of tick " << snapshot.Tick << " is truncated" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Scene::RollbackToTick(uint64_t tick)
+	{
+		const SceneSnapshot* snapshot = m_SnapshotHistory.Find(tick);
+		if (!snapshot)
+		{
+			std::cerr << "[Scene] No snapshot kept for tick " << tick << std::endl;
+			return false;
+		}
+
+		if (!RestoreSnapshot(*snapshot))
+			return false;
+
+		m_FixedTick = tick;
+		m_SnapshotHistory.DiscardAfter(tick);
+		return true;
+	}
+
+	void Scene::UpdateParticles(TimeStep ts)
+	{
+		m_ParticleSystem.BeginFrame();
+
+		for (auto& e : m_EntityManager.GetEntities())
+		{
+			if (e.Has<ParticleEmitterComponent>() && e.Has<TransformComponent>())
+				m_ParticleSystem.Update(e.UUID(), e.Get<ParticleEmitterComponent>(), GetWorldTransform(e), ts);
+		}
+
+		m_ParticleSystem.EndFrame();
+	}
+
+	void Scene::OnRenderRuntime(sf::RenderTarget& target, Camera2D& runtimeCamera)
 	{
-		target->clear(sf::Color(32, 32, 32));
+		ClearTarget(target);
 
-		target->setView(runtimeCamera.GetView());
+		sf::View view = runtimeCamera.GetView();
+		view.setViewport(m_PresentViewport);
+		target.setView(view);
+		m_SpriteBatch.Begin(target);
+		m_TilemapRenderer.BeginFrame();
 
 		for (auto& e : m_EntityManager.GetEntities())
 		{
@@ -100,6 +362,12 @@ namespace Luden {
 
 			auto& transform = e.Get<TransformComponent>();
 
+			if (e.Has<TilemapComponent>())
+			{
+				m_SpriteBatch.Flush();
+				m_TilemapRenderer.Render(e.UUID(), e.Get<TilemapComponent>(), GetWorldTransform(e), target);
+			}
+
 			if (e.Has<SpriteAnimatorComponent>())
 			{
 				RenderAnimatedEntity(e, transform, target);
@@ -109,21 +377,34 @@ namespace Luden {
 				RenderStaticSprite(e, transform, target);
 			}
 
+			if (e.Has<ParticleEmitterComponent>())
+			{
+				m_SpriteBatch.Flush();
+				m_ParticleSystem.Render(e.UUID(), GetWorldTransform(e), target);
+			}
+
 			if (e.Has<TextComponent>())  
 			{
 				RenderText(e, transform, target);
 			}
 		}
 
-		DebugManager::Instance().Render(target);
+		m_SpriteBatch.End();
+		m_TilemapRenderer.EndFrame();
+
 		DebugManager::Instance().DebugDrawPhysics2D(m_PhysicsManager.GetPhysicsWorldId());
+		DebugManager::Instance().Render(target);
 	}
 
-	void Scene::OnRenderEditor(std::shared_ptr<sf::RenderTexture> target, Camera2D& editorCamera)
+	void Scene::OnRenderEditor(sf::RenderTarget& target, Camera2D& editorCamera)
 	{
-		target->clear(sf::Color(32, 32, 32));
+		ClearTarget(target);
 
-		target->setView(editorCamera.GetView());
+		sf::View view = editorCamera.GetView();
+		view.setViewport(m_PresentViewport);
+		target.setView(view);
+		m_SpriteBatch.Begin(target);
+		m_TilemapRenderer.BeginFrame();
 
 		for (auto& e : m_EntityManager.GetEntities())
 		{
@@ -132,6 +413,12 @@ namespace Luden {
 
 			auto& transform = e.Get<TransformComponent>();
 
+			if (e.Has<TilemapComponent>())
+			{
+				m_SpriteBatch.Flush();
+				m_TilemapRenderer.Render(e.UUID(), e.Get<TilemapComponent>(), GetWorldTransform(e), target);
+			}
+
 			if (e.Has<SpriteAnimatorComponent>())
 			{
 				RenderAnimatedEntity(e, transform, target);
@@ -141,57 +428,101 @@ namespace Luden {
 				RenderStaticSprite(e, transform, target);
 			}
 
+			if (e.Has<ParticleEmitterComponent>())
+			{
+				m_SpriteBatch.Flush();
+				m_ParticleSystem.Render(e.UUID(), GetWorldTransform(e), target);
+			}
+
 			if (e.Has<TextComponent>())
 			{
 				RenderText(e, transform, target);
 			}
 		}
 
+		m_SpriteBatch.End();
+		m_TilemapRenderer.EndFrame();
+
 		DebugManager::Instance().DebugDrawPhysics2D(m_PhysicsManager.GetPhysicsWorldId());
 		DebugManager::Instance().Render(target);
 	}
 
-	void Scene::RenderStaticSprite(Entity& e, TransformComponent& transform, std::shared_ptr<sf::RenderTexture> target)
+	void Scene::ClearTarget(sf::RenderTarget& target)
 	{
-		auto& spriteComp = e.Get<SpriteRendererComponent>();
-		if (spriteComp.spriteHandle == 0)
+		const sf::Color clearColor(32, 32, 32);
+
+		if (m_PresentViewport == sf::FloatRect({ 0.0f, 0.0f }, { 1.0f, 1.0f }))
+		{
+			target.clear(clearColor);
 			return;
+		}
 
-		auto sprite = ResourceManager::GetResource<Sprite>(spriteComp.spriteHandle);
-		if (!sprite) return;
+		// Letterboxed, the bars stay black and only the presented area gets the scene background
+		target.clear(sf::Color::Black);
 
-		auto texture = ResourceManager::GetResource<Texture>(sprite->GetTextureHandle());
-		if (!texture) return;
+		sf::View unitView(sf::FloatRect({ 0.0f, 0.0f }, { 1.0f, 1.0f }));
+		unitView.setViewport(m_PresentViewport);
+		target.setView(unitView);
+
+		sf::RectangleShape background({ 1.0f, 1.0f });
+		background.setFillColor(clearColor);
+		target.draw(background);
+	}
 
-		sf::Sprite sfSprite(texture->GetTexture());
+	sf::Vector2u Scene::ResolveRenderResolution(const sf::RenderTarget& target) const
+	{
+		if (m_RenderResolution.x > 0 && m_RenderResolution.y > 0)
+			return m_RenderResolution;
 
-		if (!sprite->UsesFullTexture())
+		return target.getSize();
+	}
+
+	// Premultiplied textures blend with One, the tint's alpha has to be carried into its RGB
+	static sf::Color GetTint(const Texture& texture, sf::Color tint)
+	{
+		if (texture.HasPremultipliedAlpha())
 		{
-			sfSprite.setTextureRect(sprite->GetTextureRect());
+			tint.r = (uint8_t)(tint.r * tint.a / 255);
+			tint.g = (uint8_t)(tint.g * tint.a / 255);
+			tint.b = (uint8_t)(tint.b * tint.a / 255);
 		}
 
-		sf::FloatRect bounds = sfSprite.getLocalBounds();
-		sfSprite.setOrigin(
-			{ bounds.size.x * sprite->GetPivot().x,
-			bounds.size.y * sprite->GetPivot().y }
-		);
+		return tint;
+	}
 
-		sfSprite.setColor(spriteComp.tint);
+	void Scene::RenderStaticSprite(Entity& e, TransformComponent& transform, sf::RenderTarget& target)
+	{
+		auto& spriteComp = e.Get<SpriteRendererComponent>();
+		if (spriteComp.spriteHandle == 0)
+			return;
 
-		sf::RenderStates states;
-		states.transform = GetWorldTransform(e); 
+		auto sprite = ResourceManager::GetResourceOrPlaceholder<Sprite>(spriteComp.spriteHandle);
+		if (!sprite) return;
 
-		target->draw(sfSprite, states);
+		auto texture = ResourceManager::GetResourceOrPlaceholder<Texture>(sprite->GetTextureHandle());
+		if (!texture) return;
+
+		const sf::Texture& sfTexture = texture->GetTexture();
+		sf::IntRect textureRect = sprite->UsesFullTexture()
+			? sf::IntRect({ 0, 0 }, { (int)sfTexture.getSize().x, (int)sfTexture.getSize().y })
+			: sprite->GetTextureRect();
+
+		sf::Vector2f origin = {
+			std::abs((float)textureRect.size.x) * sprite->GetPivot().x,
+			std::abs((float)textureRect.size.y) * sprite->GetPivot().y
+		};
+
+		m_SpriteBatch.Draw(sfTexture, textureRect, origin, GetTint(*texture, spriteComp.tint), GetWorldTransform(e), texture->GetBlendMode());
 	}
 
-	void Scene::RenderText(Entity& e, TransformComponent& transform, std::shared_ptr<sf::RenderTexture> target)
+	void Scene::RenderText(Entity& e, TransformComponent& transform, sf::RenderTarget& target)
 	{
 		auto& textComp = e.Get<TextComponent>();
 
 		if (textComp.fontHandle == 0 || textComp.text.empty())
 			return;
 
-		auto font = ResourceManager::GetResource<Font>(textComp.fontHandle);
+		auto font = ResourceManager::GetResourceOrPlaceholder<Font>(textComp.fontHandle);
 		if (!font)
 			return;
 
@@ -248,17 +579,19 @@ namespace Luden {
 		sf::RenderStates states;
 		states.transform = GetWorldTransform(e);
 
-		target->draw(sfText, states);
+		// Text uses the font texture, keep draw order with the batched sprites
+		m_SpriteBatch.Flush();
+		target.draw(sfText, states);
 	}
 
-	void Scene::RenderAnimatedEntity(Entity& e, TransformComponent& transform, std::shared_ptr<sf::RenderTexture> target)
+	void Scene::RenderAnimatedEntity(Entity& e, TransformComponent& transform, sf::RenderTarget& target)
 	{
 		auto& animator = e.Get<SpriteAnimatorComponent>();
 
 		if (animator.animationHandles.empty()) return;
 		if (animator.currentAnimationIndex >= animator.animationHandles.size()) return;
 
-		auto animation = ResourceManager::GetResource<Animation>(animator.animationHandles[animator.currentAnimationIndex]); 
+		auto animation = ResourceManager::GetResourceOrPlaceholder<Animation>(animator.animationHandles[animator.currentAnimationIndex]);
 
 		if (!animation || animation->GetFrameCount() == 0) return;
 
@@ -267,36 +600,31 @@ namespace Luden {
 
 		const auto& frame = animation->GetFrame(animator.currentFrame);
 
-		auto sprite = ResourceManager::GetResource<Sprite>(frame.spriteHandle); 
+		auto sprite = ResourceManager::GetResourceOrPlaceholder<Sprite>(frame.spriteHandle);
 		if (!sprite) return;
 
-		auto texture = ResourceManager::GetResource<Texture>(sprite->GetTextureHandle());  
+		auto texture = ResourceManager::GetResourceOrPlaceholder<Texture>(sprite->GetTextureHandle());
 		if (!texture) return;
 
-		sf::Sprite sfSprite(texture->GetTexture());
+		const sf::Texture& sfTexture = texture->GetTexture();
+		sf::IntRect textureRect = sprite->UsesFullTexture()
+			? sf::IntRect({ 0, 0 }, { (int)sfTexture.getSize().x, (int)sfTexture.getSize().y })
+			: sprite->GetTextureRect();
 
-		if (!sprite->UsesFullTexture())
-		{
-			sfSprite.setTextureRect(sprite->GetTextureRect());
-		}
-
-		sf::FloatRect bounds = sfSprite.getLocalBounds();
-		sfSprite.setOrigin(
-			{ bounds.size.x * sprite->GetPivot().x + frame.offset.x,
-			bounds.size.y * sprite->GetPivot().y + frame.offset.y}
-		);
-
-		sfSprite.setColor(animator.tint);
-
-		sf::RenderStates states;
-		states.transform = GetWorldTransform(e);
+		sf::Vector2f origin = {
+			std::abs((float)textureRect.size.x) * sprite->GetPivot().x + frame.offset.x,
+			std::abs((float)textureRect.size.y) * sprite->GetPivot().y + frame.offset.y
+		};
 
-		target->draw(sfSprite, states);
+		m_SpriteBatch.Draw(sfTexture, textureRect, origin, GetTint(*texture, animator.tint), GetWorldTransform(e), texture->GetBlendMode());
 	}
 
 	void Scene::OnRuntimeStart()
 	{
 		m_IsPlaying = true;
+		m_FixedAccumulator = 0.0f;
+		m_FixedTick = 0;
+		m_SnapshotHistory.Clear();
 
 		GEngine.SetActiveScene(this);
 
@@ -316,8 +644,15 @@ namespace Luden {
 				auto& nsc = entity.Get<NativeScriptComponent>();
 
 				nsc.CreateInstance(entity);
+
+				// Bodies were created before the script existed
+				m_PhysicsManager.UpdateCollisionEvents(entity);
 			}
 		}
+
+		// Baseline so a rollback can go back to the start of the run
+		if (m_SnapshotHistory.GetCapacity() > 0)
+			SaveSnapshot(m_SnapshotHistory.Acquire(m_FixedTick));
 	}
 
 	void Scene::OnRuntimeStop()
@@ -649,6 +984,10 @@ namespace Luden {
 		{
 			CopyComponentIfExists<TransformComponent>(dest, source);
 			CopyComponentIfExists<RelationshipComponent>(dest, source);
+
+			// The copy has no body yet, nothing blends its render pose
+			if (dest.Has<TransformComponent>())
+				dest.Get<TransformComponent>().Interpolated = false;
 		}
 
 		CopyComponentIfExists<DamageComponent>(dest, source);
@@ -661,10 +1000,15 @@ namespace Luden {
 		CopyComponentIfExists<RigidBody2DComponent>(dest, source);
 		CopyComponentIfExists<BoxCollider2DComponent>(dest, source);
 		CopyComponentIfExists<CircleCollider2DComponent>(dest, source);
+		CopyComponentIfExists<CapsuleCollider2DComponent>(dest, source);
+		CopyComponentIfExists<PolygonCollider2DComponent>(dest, source);
+		CopyComponentIfExists<ChainCollider2DComponent>(dest, source);
 		CopyComponentIfExists<NativeScriptComponent>(dest, source);
 		CopyComponentIfExists<SpriteAnimatorComponent>(dest, source);
 		CopyComponentIfExists<TextComponent>(dest, source);
 		CopyComponentIfExists<SpriteRendererComponent>(dest, source);
+		CopyComponentIfExists<TilemapComponent>(dest, source);
+		CopyComponentIfExists<ParticleEmitterComponent>(dest, source);
 		CopyComponentIfExists<InvincibilityComponent>(dest, source);
 		CopyComponentIfExists<LifespanComponent>(dest, source);
 		CopyComponentIfExists<PatrolComponent>(dest, source);
@@ -788,44 +1132,32 @@ namespace Luden {
 
 	Entity Scene::FindEntityByBodyId(b2BodyId bodyId)
 	{
-		for (const auto& entity : m_EntityManager.GetEntities())
-		{
-			if (entity.Has<RigidBody2DComponent>())
-			{
-				auto& rb = entity.Get<RigidBody2DComponent>();
-				if (B2_ID_EQUALS(rb.RuntimeBodyId, bodyId))
-				{
-					return entity;
-				}
-			}
-		}
+		if (!b2Body_IsValid(bodyId))
+			return {};
 
-		return {};
+		return FindEntityByUserData(b2Body_GetUserData(bodyId));
 	}
 
 	Entity Scene::FindEntityByShapeId(b2ShapeId shapeId)
 	{
-		for (const auto& entity : m_EntityManager.GetEntities())
-		{
-			if (entity.Has<CircleCollider2DComponent>())
-			{
-				auto& collider = entity.Get<CircleCollider2DComponent>();
-				if (B2_ID_EQUALS(collider.RuntimeShapeId, shapeId))
-				{
-					return entity;
-				}
-			}
-			else if (entity.Has<BoxCollider2DComponent>())
-			{
-				auto& collider = entity.Get<BoxCollider2DComponent>();
-				if (B2_ID_EQUALS(collider.RuntimeShapeId, shapeId))
-				{
-					return entity;
-				}
-			}
-		}
+		if (!b2Shape_IsValid(shapeId))
+			return {};
 
-		return {};
+		// Tilemap chain segments carry the handle on their body as well
+		void* userData = b2Shape_GetUserData(shapeId);
+		if (userData == nullptr)
+			userData = b2Body_GetUserData(b2Shape_GetBody(shapeId));
+
+		return FindEntityByUserData(userData);
+	}
+
+	Entity Scene::FindEntityByUserData(void* userData)
+	{
+		EntityID entityID = EntityMemoryPool::Instance().ResolveHandle((EntityHandle)(uintptr_t)userData);
+		if (entityID == 0)
+			return {};
+
+		return Entity(entityID, this);
 	}
 
 	// Viewport
@@ -878,10 +1210,17 @@ namespace Luden {
 
 			sf::Transform localTransform;
 
-			localTransform.translate({ tc.Translation.x, tc.Translation.y });
-
-			sf::Angle angle = sf::degrees(tc.angle);
-			localTransform.rotate(angle);
+			// Bodies moved by physics are drawn at their pose blended between the last two steps
+			if (tc.Interpolated)
+			{
+				localTransform.translate({ tc.RenderTranslation.x, tc.RenderTranslation.y });
+				localTransform.rotate(sf::degrees(tc.RenderAngle));
+			}
+			else
+			{
+				localTransform.translate({ tc.Translation.x, tc.Translation.y });
+				localTransform.rotate(sf::degrees(tc.angle));
+			}
 
 			localTransform.scale({ tc.Scale.x, tc.Scale.y });
 
@@ -920,6 +1259,12 @@ namespace Luden {
 
 			if (entity.Has<NativeScriptComponent>())
 				resources.insert(entity.Get<NativeScriptComponent>().ScriptHandle);
+
+			if (entity.Has<TilemapComponent>())
+				resources.insert(entity.Get<TilemapComponent>().TilesetHandle);
+
+			if (entity.Has<ParticleEmitterComponent>())
+				resources.insert(entity.Get<ParticleEmitterComponent>().EmitterHandle);
 		}
 
 		return resources;
@@ -935,6 +1280,17 @@ namespace Luden {
 		m_PhysicsManager.SetGravity(gravity);
 	}
 
+	void Scene::SetFixedTickRate(float ticksPerSecond)
+	{
+		if (ticksPerSecond <= 0.0f)
+		{
+			std::cerr << "[Scene] Invalid fixed tick rate " << ticksPerSecond << std::endl;
+			return;
+		}
+
+		m_FixedTimeStep = 1.0f / ticksPerSecond;
+	}
+
 	std::shared_ptr<Scene> Scene::CreateEmpty()
 	{
 		return std::make_shared<Scene>("Empty");
@@ -0,0 +1,1178 @@
+#include "Scene/SceneBinarySerializer.h"
+#include "Scene/Scene.h"
+#include "Scene/SceneSerializer.h"
+#include "ECS/Components/Components.h"
+#include "IO/MemoryStream.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Luden
+{
+	namespace
+	{
+		constexpr char s_Magic[4] = { 'L','S','C','B' };
+		constexpr uint32_t s_NoEntity = UINT32_MAX;
+
+		// Stored in the pack, never renumber
+		enum class SceneBlock : uint16_t
+		{
+			End = 0,
+			Relationship = 1,
+			Damage = 2,
+			Draggable = 3,
+			FollowPlayer = 4,
+			Gravity = 5,
+			Health = 6,
+			Input = 7,
+			Camera2D = 8,
+			RigidBody2D = 9,
+			BoxCollider2D = 10,
+			CircleCollider2D = 11,
+			CapsuleCollider2D = 12,
+			PolygonCollider2D = 13,
+			ChainCollider2D = 14,
+			Prefab = 15,
+			NativeScript = 16,
+			SpriteAnimator = 17,
+			Text = 18,
+			SpriteRenderer = 19,
+			Tilemap = 20,
+			ParticleEmitter = 21,
+			Lifespan = 22,
+			Invincibility = 23,
+			Patrol = 24,
+			State = 25,
+			Transform = 26
+		};
+
+		//==============================================================================
+		/// Records
+		// Plain fields only. Records are value initialized before being filled so their padding is zero and the same
+		// scene always packs to the same bytes. Variable length data lives in the block elements, by first index and count.
+		struct RelationshipRecord { uint32_t Parent; uint32_t FirstChild; uint32_t ChildCount; };
+		struct DamageRecord { int32_t Damage; };
+		struct DraggableRecord { uint8_t Dragging; };
+		struct FollowPlayerRecord { glm::vec2 Home; float Speed; };
+		struct GravityRecord { float Gravity; };
+		struct HealthRecord { int32_t Max; int32_t Current; };
+		struct InputRecord { int32_t Priority; uint8_t Enabled; uint8_t ConsumeInput; };
+		struct Camera2DRecord { int8_t Type; uint8_t Primary; };
+		struct RigidBody2DRecord { int32_t BodyType; float Mass; float LinearDrag; float AngularDrag; float GravityScale; uint8_t FixedRotation; uint8_t IsBullet; };
+		struct ShapeFilterRecord { uint16_t CategoryBits; uint16_t MaskBits; uint16_t GroupIndex; uint8_t CollisionEvents; uint8_t IsSensor; };
+		struct BoxCollider2DRecord { glm::vec2 Offset; glm::vec2 Size; float Density; float Friction; float Restitution; ShapeFilterRecord Filter; };
+		struct CircleCollider2DRecord { glm::vec2 Offset; float Radius; float Density; float Friction; float Restitution; ShapeFilterRecord Filter; };
+		struct CapsuleCollider2DRecord { glm::vec2 Offset; float Height; float Radius; float Density; float Friction; float Restitution; ShapeFilterRecord Filter; uint8_t Horizontal; };
+		struct PolygonCollider2DRecord { glm::vec2 Offset; float Radius; float Density; float Friction; float Restitution; uint32_t FirstPoint; uint32_t PointCount; ShapeFilterRecord Filter; };
+		struct ChainCollider2DRecord { float Friction; float Restitution; uint32_t FirstPoint; uint32_t PointCount; uint16_t CategoryBits; uint16_t MaskBits; uint16_t GroupIndex; uint8_t Loop; };
+		struct PrefabRecord { uint64_t PrefabID; uint64_t EntityID; };
+		struct NativeScriptRecord { uint64_t ScriptHandle; };
+		struct SpriteAnimatorRecord { uint32_t FirstAnimation; uint32_t AnimationCount; uint32_t CurrentAnimation; uint32_t CurrentFrame; float FrameTimer; float PlaybackSpeed; uint32_t Tint; };
+		struct TextRecord { uint64_t FontHandle; uint32_t Text; uint32_t CharacterSize; uint32_t FillColor; uint32_t OutlineColor; float OutlineThickness; float LetterSpacing; float LineSpacing; uint32_t Style; uint8_t LineAlignment; uint8_t TextOrientation; };
+		struct SpriteRendererRecord { uint64_t SpriteHandle; uint32_t Tint; };
+		struct TilemapRecord { uint64_t TilesetHandle; uint32_t Tint; float Friction; float Restitution; uint32_t FirstChunk; uint32_t ChunkCount; uint16_t CategoryBits; uint16_t MaskBits; uint8_t GenerateColliders; };
+		struct TilemapChunkRecord { int32_t X; int32_t Y; std::array<uint16_t, TilemapChunk::Size * TilemapChunk::Size> Tiles; };
+		struct ParticleEmitterRecord { uint64_t EmitterHandle; float SimulationSpeed; uint8_t Playing; };
+		struct LifespanRecord { int32_t Lifespan; int32_t FrameCreated; };
+		struct InvincibilityRecord { int32_t Frames; };
+		struct PatrolRecord { uint32_t FirstPosition; uint32_t PositionCount; uint32_t CurrentPosition; float Speed; };
+		struct StateRecord { uint32_t State; uint32_t PreviousState; uint8_t ChangeAnimation; };
+		struct TransformRecord { glm::vec3 Translation; glm::vec3 Scale; float Angle; };
+
+		template<typename Record, typename Element = uint8_t>
+		struct ComponentBlock
+		{
+			static_assert(std::is_trivially_copyable_v<Record> && std::is_trivially_copyable_v<Element>);
+
+			std::vector<uint32_t> Entities; // Index of the entity each record belongs to
+			std::vector<Record> Records;
+			std::vector<Element> Elements;
+
+			Record& Push(uint32_t entityIndex)
+			{
+				Entities.push_back(entityIndex);
+				return Records.emplace_back();
+			}
+
+			template<typename Container>
+			uint32_t PushElements(const Container& elements)
+			{
+				uint32_t first = (uint32_t)Elements.size();
+				Elements.insert(Elements.end(), elements.begin(), elements.end());
+				return first;
+			}
+
+			bool HasElements(uint32_t first, uint32_t count) const { return (uint64_t)first + count <= Elements.size(); }
+
+			uint64_t GetPayloadSize() const
+			{
+				return sizeof(uint32_t) * 2 + Entities.size() * sizeof(uint32_t) + Records.size() * sizeof(Record) + Elements.size() * sizeof(Element);
+			}
+		};
+
+		template<typename T>
+		void WriteArrayData(StreamWriter& stream, const std::vector<T>& array)
+		{
+			if (!array.empty())
+				stream.WriteData((const char*)array.data(), array.size() * sizeof(T));
+		}
+
+		template<typename T>
+		bool ReadArrayData(StreamReader& stream, std::vector<T>& array, uint64_t count)
+		{
+			array.resize(count);
+			return count == 0 || stream.ReadData((char*)array.data(), count * sizeof(T));
+		}
+
+		template<typename Record, typename Element>
+		void WriteBlock(StreamWriter& stream, SceneBlock type, const ComponentBlock<Record, Element>& block)
+		{
+			if (block.Records.empty())
+				return;
+
+			stream.WriteRaw<uint16_t>((uint16_t)type);
+			stream.WriteRaw<uint64_t>(block.GetPayloadSize());
+			stream.WriteRaw<uint32_t>((uint32_t)block.Records.size());
+			stream.WriteRaw<uint32_t>((uint32_t)block.Elements.size());
+			WriteArrayData(stream, block.Entities);
+			WriteArrayData(stream, block.Records);
+			WriteArrayData(stream, block.Elements);
+		}
+
+		template<typename Record, typename Element>
+		bool ReadBlock(StreamReader& stream, uint64_t payloadSize, size_t entityCount, ComponentBlock<Record, Element>& block)
+		{
+			uint32_t recordCount = 0;
+			uint32_t elementCount = 0;
+			stream.ReadRaw<uint32_t>(recordCount);
+			stream.ReadRaw<uint32_t>(elementCount);
+
+			// A record layout that changed without a version bump shows up here
+			uint64_t expectedSize = sizeof(uint32_t) * 2 + (uint64_t)recordCount * (sizeof(uint32_t) + sizeof(Record)) + (uint64_t)elementCount * sizeof(Element);
+			if (!stream || expectedSize != payloadSize)
+				return false;
+
+			if (!ReadArrayData(stream, block.Entities, recordCount) || !ReadArrayData(stream, block.Records, recordCount) || !ReadArrayData(stream, block.Elements, elementCount))
+				return false;
+
+			for (uint32_t entityIndex : block.Entities)
+			{
+				if (entityIndex >= entityCount)
+					return false;
+			}
+			return true;
+		}
+
+		class StringTable
+		{
+		public:
+			uint32_t Add(const std::string& string)
+			{
+				auto [it, inserted] = m_Indices.try_emplace(string, (uint32_t)m_Strings.size());
+				if (inserted)
+					m_Strings.push_back(string);
+				return it->second;
+			}
+
+			const std::vector<std::string>& GetStrings() const { return m_Strings; }
+		private:
+			std::vector<std::string> m_Strings;
+			std::unordered_map<std::string, uint32_t> m_Indices;
+		};
+
+		ShapeFilterRecord PackFilter(uint16_t categoryBits, uint16_t maskBits, uint16_t groupIndex, uint8_t collisionEvents, bool isSensor)
+		{
+			ShapeFilterRecord record{};
+			record.CategoryBits = categoryBits;
+			record.MaskBits = maskBits;
+			record.GroupIndex = groupIndex;
+			record.CollisionEvents = collisionEvents;
+			record.IsSensor = isSensor;
+			return record;
+		}
+
+		template<typename T>
+		void UnpackFilter(const ShapeFilterRecord& record, T& component)
+		{
+			component.CategoryBits = record.CategoryBits;
+			component.MaskBits = record.MaskBits;
+			component.GroupIndex = record.GroupIndex;
+			component.CollisionEvents = record.CollisionEvents;
+			component.IsSensor = record.IsSensor != 0;
+		}
+	}
+
+	SceneBinarySerializer::SceneBinarySerializer(std::shared_ptr<Scene> scene)
+		: m_Scene(scene)
+	{
+	}
+
+	bool SceneBinarySerializer::Serialize(StreamWriter& stream)
+	{
+		auto& entities = m_Scene->GetEntityManager().GetEntities();
+
+		std::unordered_map<UUID, uint32_t> entityIndices;
+		entityIndices.reserve(entities.size());
+		for (uint32_t i = 0; i < (uint32_t)entities.size(); i++)
+			entityIndices[entities[i].UUID()] = i;
+
+		auto indexOf = [&entityIndices](UUID entityID)
+		{
+			auto it = entityIndices.find(entityID);
+			return it != entityIndices.end() ? it->second : s_NoEntity;
+		};
+
+		StringTable strings;
+		std::vector<uint64_t> entityIDs;
+		std::vector<uint32_t> entityTags;
+		entityIDs.reserve(entities.size());
+		entityTags.reserve(entities.size());
+
+		ComponentBlock<RelationshipRecord, uint32_t> relationships;
+		ComponentBlock<DamageRecord> damages;
+		ComponentBlock<DraggableRecord> draggables;
+		ComponentBlock<FollowPlayerRecord> followPlayers;
+		ComponentBlock<GravityRecord> gravities;
+		ComponentBlock<HealthRecord> healths;
+		ComponentBlock<InputRecord> inputs;
+		ComponentBlock<Camera2DRecord> cameras;
+		ComponentBlock<RigidBody2DRecord> rigidBodies;
+		ComponentBlock<BoxCollider2DRecord> boxColliders;
+		ComponentBlock<CircleCollider2DRecord> circleColliders;
+		ComponentBlock<CapsuleCollider2DRecord> capsuleColliders;
+		ComponentBlock<PolygonCollider2DRecord, glm::vec2> polygonColliders;
+		ComponentBlock<ChainCollider2DRecord, glm::vec2> chainColliders;
+		ComponentBlock<PrefabRecord> prefabs;
+		ComponentBlock<NativeScriptRecord> scripts;
+		ComponentBlock<SpriteAnimatorRecord, uint64_t> spriteAnimators;
+		ComponentBlock<TextRecord> texts;
+		ComponentBlock<SpriteRendererRecord> spriteRenderers;
+		ComponentBlock<TilemapRecord, TilemapChunkRecord> tilemaps;
+		ComponentBlock<ParticleEmitterRecord> particleEmitters;
+		ComponentBlock<LifespanRecord> lifespans;
+		ComponentBlock<InvincibilityRecord> invincibilities;
+		ComponentBlock<PatrolRecord, glm::vec2> patrols;
+		ComponentBlock<StateRecord> states;
+		ComponentBlock<TransformRecord> transforms;
+
+		for (uint32_t i = 0; i < (uint32_t)entities.size(); i++)
+		{
+			const Entity& e = entities[i];
+			entityIDs.push_back(e.UUID());
+			entityTags.push_back(strings.Add(e.Tag()));
+
+			if (e.Has<RelationshipComponent>())
+			{
+				const auto& c = e.Get<RelationshipComponent>();
+				auto& record = relationships.Push(i);
+				record.Parent = c.ParentHandle != 0 ? indexOf(c.ParentHandle) : s_NoEntity;
+				record.FirstChild = (uint32_t)relationships.Elements.size();
+				for (UUID child : c.Children)
+				{
+					uint32_t childIndex = indexOf(child);
+					if (childIndex != s_NoEntity)
+						relationships.Elements.push_back(childIndex);
+				}
+				record.ChildCount = (uint32_t)relationships.Elements.size() - record.FirstChild;
+			}
+
+			if (e.Has<DamageComponent>())
+				damages.Push(i).Damage = e.Get<DamageComponent>().damage;
+
+			if (e.Has<DraggableComponent>())
+				draggables.Push(i).Dragging = e.Get<DraggableComponent>().dragging;
+
+			if (e.Has<FollowPLayerComponent>())
+			{
+				const auto& c = e.Get<FollowPLayerComponent>();
+				auto& record = followPlayers.Push(i);
+				record.Home = c.home;
+				record.Speed = c.speed;
+			}
+
+			if (e.Has<GravityComponent>())
+				gravities.Push(i).Gravity = e.Get<GravityComponent>().gravity;
+
+			if (e.Has<HealthComponent>())
+			{
+				const auto& c = e.Get<HealthComponent>();
+				auto& record = healths.Push(i);
+				record.Max = c.max;
+				record.Current = c.current;
+			}
+
+			if (e.Has<InputComponent>())
+			{
+				const auto& c = e.Get<InputComponent>();
+				auto& record = inputs.Push(i);
+				record.Priority = c.priority;
+				record.Enabled = c.enabled;
+				record.ConsumeInput = c.consumeInput;
+			}
+
+			if (e.Has<Camera2DComponent>())
+			{
+				const auto& c = e.Get<Camera2DComponent>();
+				auto& record = cameras.Push(i);
+				record.Type = (int8_t)c.Camera.GetType();
+				record.Primary = c.Primary;
+			}
+
+			if (e.Has<RigidBody2DComponent>())
+			{
+				const auto& c = e.Get<RigidBody2DComponent>();
+				auto& record = rigidBodies.Push(i);
+				record.BodyType = (int32_t)c.BodyType;
+				record.Mass = c.Mass;
+				record.LinearDrag = c.LinearDrag;
+				record.AngularDrag = c.AngularDrag;
+				record.GravityScale = c.GravityScale;
+				record.FixedRotation = c.FixedRotation;
+				record.IsBullet = c.IsBullet;
+			}
+
+			if (e.Has<BoxCollider2DComponent>())
+			{
+				const auto& c = e.Get<BoxCollider2DComponent>();
+				auto& record = boxColliders.Push(i);
+				record.Offset = c.Offset;
+				record.Size = c.Size;
+				record.Density = c.Density;
+				record.Friction = c.Friction;
+				record.Restitution = c.Restitution;
+				record.Filter = PackFilter(c.CategoryBits, c.MaskBits, c.GroupIndex, c.CollisionEvents, c.IsSensor);
+			}
+
+			if (e.Has<CircleCollider2DComponent>())
+			{
+				const auto& c = e.Get<CircleCollider2DComponent>();
+				auto& record = circleColliders.Push(i);
+				record.Offset = c.Offset;
+				record.Radius = c.Radius;
+				record.Density = c.Density;
+				record.Friction = c.Friction;
+				record.Restitution = c.Restitution;
+				record.Filter = PackFilter(c.CategoryBits, c.MaskBits, c.GroupIndex, c.CollisionEvents, c.IsSensor);
+			}
+
+			if (e.Has<CapsuleCollider2DComponent>())
+			{
+				const auto& c = e.Get<CapsuleCollider2DComponent>();
+				auto& record = capsuleColliders.Push(i);
+				record.Offset = c.Offset;
+				record.Height = c.Height;
+				record.Radius = c.Radius;
+				record.Horizontal = c.Horizontal;
+				record.Density = c.Density;
+				record.Friction = c.Friction;
+				record.Restitution = c.Restitution;
+				record.Filter = PackFilter(c.CategoryBits, c.MaskBits, c.GroupIndex, c.CollisionEvents, c.IsSensor);
+			}
+
+			if (e.Has<PolygonCollider2DComponent>())
+			{
+				const auto& c = e.Get<PolygonCollider2DComponent>();
+				auto& record = polygonColliders.Push(i);
+				record.Offset = c.Offset;
+				record.FirstPoint = polygonColliders.PushElements(c.Points);
+				record.PointCount = (uint32_t)c.Points.size();
+				record.Radius = c.Radius;
+				record.Density = c.Density;
+				record.Friction = c.Friction;
+				record.Restitution = c.Restitution;
+				record.Filter = PackFilter(c.CategoryBits, c.MaskBits, c.GroupIndex, c.CollisionEvents, c.IsSensor);
+			}
+
+			if (e.Has<ChainCollider2DComponent>())
+			{
+				const auto& c = e.Get<ChainCollider2DComponent>();
+				auto& record = chainColliders.Push(i);
+				record.FirstPoint = chainColliders.PushElements(c.Points);
+				record.PointCount = (uint32_t)c.Points.size();
+				record.Loop = c.Loop;
+				record.Friction = c.Friction;
+				record.Restitution = c.Restitution;
+				record.CategoryBits = c.CategoryBits;
+				record.MaskBits = c.MaskBits;
+				record.GroupIndex = c.GroupIndex;
+			}
+
+			if (e.Has<PrefabComponent>())
+			{
+				const auto& c = e.Get<PrefabComponent>();
+				auto& record = prefabs.Push(i);
+				record.PrefabID = c.PrefabID;
+				record.EntityID = c.EntityID;
+			}
+
+			if (e.Has<NativeScriptComponent>())
+				scripts.Push(i).ScriptHandle = e.Get<NativeScriptComponent>().ScriptHandle;
+
+			if (e.Has<SpriteRendererComponent>())
+			{
+				const auto& c = e.Get<SpriteRendererComponent>();
+				auto& record = spriteRenderers.Push(i);
+				record.SpriteHandle = c.spriteHandle;
+				record.Tint = c.tint.toInteger();
+			}
+
+			if (e.Has<TilemapComponent>())
+			{
+				const auto& c = e.Get<TilemapComponent>();
+				auto& record = tilemaps.Push(i);
+				record.TilesetHandle = c.TilesetHandle;
+				record.Tint = c.Tint.toInteger();
+				record.GenerateColliders = c.GenerateColliders;
+				record.Friction = c.Friction;
+				record.Restitution = c.Restitution;
+				record.CategoryBits = c.CategoryBits;
+				record.MaskBits = c.MaskBits;
+				record.FirstChunk = (uint32_t)tilemaps.Elements.size();
+				record.ChunkCount = (uint32_t)c.Chunks.size();
+
+				for (const auto& [key, chunk] : c.Chunks)
+				{
+					auto& chunkRecord = tilemaps.Elements.emplace_back();
+					chunkRecord.X = TilemapComponent::ChunkKeyX(key);
+					chunkRecord.Y = TilemapComponent::ChunkKeyY(key);
+					chunkRecord.Tiles = chunk.Tiles;
+				}
+			}
+
+			if (e.Has<ParticleEmitterComponent>())
+			{
+				const auto& c = e.Get<ParticleEmitterComponent>();
+				auto& record = particleEmitters.Push(i);
+				record.EmitterHandle = c.EmitterHandle;
+				record.Playing = c.Playing;
+				record.SimulationSpeed = c.SimulationSpeed;
+			}
+
+			if (e.Has<SpriteAnimatorComponent>())
+			{
+				const auto& c = e.Get<SpriteAnimatorComponent>();
+				auto& record = spriteAnimators.Push(i);
+				record.FirstAnimation = (uint32_t)spriteAnimators.Elements.size();
+				record.AnimationCount = (uint32_t)c.animationHandles.size();
+				for (ResourceHandle handle : c.animationHandles)
+					spriteAnimators.Elements.push_back(handle);
+
+				record.CurrentAnimation = (uint32_t)c.currentAnimationIndex;
+				record.CurrentFrame = (uint32_t)c.currentFrame;
+				record.FrameTimer = c.frameTimer;
+				record.PlaybackSpeed = c.playbackSpeed;
+				record.Tint = c.tint.toInteger();
+			}
+
+			if (e.Has<TextComponent>())
+			{
+				const auto& c = e.Get<TextComponent>();
+				auto& record = texts.Push(i);
+				record.FontHandle = c.fontHandle;
+				record.Text = strings.Add(c.text);
+				record.CharacterSize = c.characterSize;
+				record.FillColor = c.fillColor.toInteger();
+				record.OutlineColor = c.outlineColor.toInteger();
+				record.OutlineThickness = c.outlineThickness;
+				record.LetterSpacing = c.letterSpacing;
+				record.LineSpacing = c.lineSpacing;
+				record.Style = c.style;
+				record.LineAlignment = (uint8_t)c.lineAlignment;
+				record.TextOrientation = (uint8_t)c.textOrientation;
+			}
+
+			if (e.Has<InvincibilityComponent>())
+				invincibilities.Push(i).Frames = e.Get<InvincibilityComponent>().iframes;
+
+			if (e.Has<LifespanComponent>())
+			{
+				const auto& c = e.Get<LifespanComponent>();
+				auto& record = lifespans.Push(i);
+				record.Lifespan = c.lifespan;
+				record.FrameCreated = c.frameCreated;
+			}
+
+			if (e.Has<PatrolComponent>())
+			{
+				const auto& c = e.Get<PatrolComponent>();
+				auto& record = patrols.Push(i);
+				record.FirstPosition = patrols.PushElements(c.positions);
+				record.PositionCount = (uint32_t)c.positions.size();
+				record.CurrentPosition = (uint32_t)c.currentPosition;
+				record.Speed = c.speed;
+			}
+
+			if (e.Has<StateComponent>())
+			{
+				const auto& c = e.Get<StateComponent>();
+				auto& record = states.Push(i);
+				record.State = strings.Add(c.state);
+				record.PreviousState = strings.Add(c.previousState);
+				record.ChangeAnimation = c.changeAnimation;
+			}
+
+			if (e.Has<TransformComponent>())
+			{
+				const auto& c = e.Get<TransformComponent>();
+				auto& record = transforms.Push(i);
+				record.Translation = c.Translation;
+				record.Scale = c.Scale;
+				record.Angle = c.angle;
+			}
+		}
+
+		stream.WriteData(s_Magic, sizeof(s_Magic));
+		stream.WriteRaw<uint32_t>(Version);
+		stream.WriteRaw<uint64_t>(m_Scene->Handle);
+		stream.WriteString(m_Scene->GetName());
+		stream.WriteRaw<int32_t>(m_Scene->GetPhysicsManager().GetSubStepCount());
+		stream.WriteRaw<uint8_t>(m_Scene->GetPhysicsManager().IsContinuousEnabled());
+
+		stream.WriteArray(strings.GetStrings());
+
+		stream.WriteRaw<uint32_t>((uint32_t)entityIDs.size());
+		WriteArrayData(stream, entityIDs);
+		WriteArrayData(stream, entityTags);
+
+		WriteBlock(stream, SceneBlock::Relationship, relationships);
+		WriteBlock(stream, SceneBlock::Damage, damages);
+		WriteBlock(stream, SceneBlock::Draggable, draggables);
+		WriteBlock(stream, SceneBlock::FollowPlayer, followPlayers);
+		WriteBlock(stream, SceneBlock::Gravity, gravities);
+		WriteBlock(stream, SceneBlock::Health, healths);
+		WriteBlock(stream, SceneBlock::Input, inputs);
+		WriteBlock(stream, SceneBlock::Camera2D, cameras);
+		WriteBlock(stream, SceneBlock::RigidBody2D, rigidBodies);
+		WriteBlock(stream, SceneBlock::BoxCollider2D, boxColliders);
+		WriteBlock(stream, SceneBlock::CircleCollider2D, circleColliders);
+		WriteBlock(stream, SceneBlock::CapsuleCollider2D, capsuleColliders);
+		WriteBlock(stream, SceneBlock::PolygonCollider2D, polygonColliders);
+		WriteBlock(stream, SceneBlock::ChainCollider2D, chainColliders);
+		WriteBlock(stream, SceneBlock::Prefab, prefabs);
+		WriteBlock(stream, SceneBlock::NativeScript, scripts);
+		WriteBlock(stream, SceneBlock::SpriteAnimator, spriteAnimators);
+		WriteBlock(stream, SceneBlock::Text, texts);
+		WriteBlock(stream, SceneBlock::SpriteRenderer, spriteRenderers);
+		WriteBlock(stream, SceneBlock::Tilemap, tilemaps);
+		WriteBlock(stream, SceneBlock::ParticleEmitter, particleEmitters);
+		WriteBlock(stream, SceneBlock::Lifespan, lifespans);
+		WriteBlock(stream, SceneBlock::Invincibility, invincibilities);
+		WriteBlock(stream, SceneBlock::Patrol, patrols);
+		WriteBlock(stream, SceneBlock::State, states);
+		WriteBlock(stream, SceneBlock::Transform, transforms);
+		stream.WriteRaw<uint16_t>((uint16_t)SceneBlock::End);
+
+		return stream.IsStreamGood();
+	}
+
+	bool SceneBinarySerializer::Deserialize(StreamReader& stream)
+	{
+		char magic[4] = {};
+		uint32_t version = 0;
+		stream.ReadData(magic, sizeof(magic));
+		stream.ReadRaw<uint32_t>(version);
+
+		if (!stream || memcmp(magic, s_Magic, sizeof(magic)) != 0)
+		{
+			std::cerr << "[SceneBinarySerializer] Not a binary scene" << std::endl;
+			return false;
+		}
+
+		if (version != Version)
+		{
+			std::cerr << "[SceneBinarySerializer] Scene version " << version << " does not match the engine version " << Version << std::endl;
+			return false;
+		}
+
+		uint64_t sceneHandle = 0;
+		std::string name;
+		int32_t subStepCount = 4;
+		uint8_t continuous = 1;
+		stream.ReadRaw<uint64_t>(sceneHandle);
+		stream.ReadString(name);
+		stream.ReadRaw<int32_t>(subStepCount);
+		stream.ReadRaw<uint8_t>(continuous);
+
+		std::vector<std::string> strings;
+		stream.ReadArray(strings);
+
+		uint32_t entityCount = 0;
+		std::vector<uint64_t> entityIDs;
+		std::vector<uint32_t> entityTags;
+		stream.ReadRaw<uint32_t>(entityCount);
+		if (!stream || !ReadArrayData(stream, entityIDs, entityCount) || !ReadArrayData(stream, entityTags, entityCount))
+		{
+			std::cerr << "[SceneBinarySerializer] Scene is truncated" << std::endl;
+			return false;
+		}
+
+		for (uint32_t tag : entityTags)
+		{
+			if (tag >= strings.size())
+			{
+				std::cerr << "[SceneBinarySerializer] Entity tag out of the string table" << std::endl;
+				return false;
+			}
+		}
+
+		m_Scene->Handle = sceneHandle;
+		m_Scene->SetName(name);
+		m_Scene->GetPhysicsManager().SetSubStepCount(subStepCount);
+		m_Scene->GetPhysicsManager().SetContinuousEnabled(continuous != 0);
+
+		m_Scene->GetEntityManager().Clear();
+
+		std::vector<Entity> entities;
+		entities.reserve(entityCount);
+		for (uint32_t i = 0; i < entityCount; i++)
+			entities.push_back(m_Scene->CreateEntityImmediate(strings[entityTags[i]], entityIDs[i]));
+
+		auto hasString = [&strings](uint32_t index) { return index < strings.size(); };
+
+		// Reads one block and hands each record to apply, which returns false when the record points out of range
+		auto readComponents = [&](auto& block, uint64_t payloadSize, auto&& apply)
+		{
+			if (!ReadBlock(stream, payloadSize, entities.size(), block))
+				return false;
+
+			for (size_t i = 0; i < block.Records.size(); i++)
+			{
+				if (!apply(entities[block.Entities[i]], block.Records[i], block))
+					return false;
+			}
+			return true;
+		};
+
+		while (stream)
+		{
+			uint16_t type = 0;
+			stream.ReadRaw<uint16_t>(type);
+			if (!stream || (SceneBlock)type == SceneBlock::End)
+				break;
+
+			uint64_t payloadSize = 0;
+			stream.ReadRaw<uint64_t>(payloadSize);
+			uint64_t payloadEnd = stream.GetStreamPosition() + payloadSize;
+
+			bool valid = true;
+			switch ((SceneBlock)type)
+			{
+				case SceneBlock::Relationship:
+				{
+					ComponentBlock<RelationshipRecord, uint32_t> block;
+					valid = readComponents(block, payloadSize, [&](Entity& e, const RelationshipRecord& record, const auto& data)
+					{
+						if (!data.HasElements(record.FirstChild, record.ChildCount) || (record.Parent != s_NoEntity && record.Parent >= entityCount))
+							return false;
+
+						auto& c = e.Add<RelationshipComponent>(record.Parent != s_NoEntity ? entities[record.Parent].UUID() : UUID(0));
+						c.Children.reserve(record.ChildCount);
+						for (uint32_t i = 0; i < record.ChildCount; i++)
+						{
+							uint32_t child = data.Elements[record.FirstChild + i];
+							if (child >= entityCount)
+								return false;
+							c.Children.push_back(entities[child].UUID());
+						}
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Damage:
+				{
+					ComponentBlock<DamageRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const DamageRecord& record, const auto&)
+					{
+						e.Add<DamageComponent>(record.Damage);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Draggable:
+				{
+					ComponentBlock<DraggableRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const DraggableRecord& record, const auto&)
+					{
+						e.Add<DraggableComponent>(record.Dragging != 0);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::FollowPlayer:
+				{
+					ComponentBlock<FollowPlayerRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const FollowPlayerRecord& record, const auto&)
+					{
+						e.Add<FollowPLayerComponent>(record.Home, record.Speed);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Gravity:
+				{
+					ComponentBlock<GravityRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const GravityRecord& record, const auto&)
+					{
+						e.Add<GravityComponent>(record.Gravity);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Health:
+				{
+					ComponentBlock<HealthRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const HealthRecord& record, const auto&)
+					{
+						e.Add<HealthComponent>(record.Max, record.Current);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Input:
+				{
+					ComponentBlock<InputRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const InputRecord& record, const auto&)
+					{
+						auto& c = e.Add<InputComponent>();
+						c.priority = record.Priority;
+						c.enabled = record.Enabled != 0;
+						c.consumeInput = record.ConsumeInput != 0;
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Camera2D:
+				{
+					ComponentBlock<Camera2DRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const Camera2DRecord& record, const auto&)
+					{
+						auto& c = e.Add<Camera2DComponent>();
+						c.Camera.SetType((Camera2D::Type)record.Type);
+						c.Primary = record.Primary != 0;
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::RigidBody2D:
+				{
+					ComponentBlock<RigidBody2DRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const RigidBody2DRecord& record, const auto&)
+					{
+						auto& c = e.Add<RigidBody2DComponent>();
+						c.BodyType = (RigidBody2DComponent::Type)record.BodyType;
+						c.FixedRotation = record.FixedRotation != 0;
+						c.Mass = record.Mass;
+						c.LinearDrag = record.LinearDrag;
+						c.AngularDrag = record.AngularDrag;
+						c.GravityScale = record.GravityScale;
+						c.IsBullet = record.IsBullet != 0;
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::BoxCollider2D:
+				{
+					ComponentBlock<BoxCollider2DRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const BoxCollider2DRecord& record, const auto&)
+					{
+						auto& c = e.Add<BoxCollider2DComponent>();
+						c.Offset = record.Offset;
+						c.Size = record.Size;
+						c.Density = record.Density;
+						c.Friction = record.Friction;
+						c.Restitution = record.Restitution;
+						UnpackFilter(record.Filter, c);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::CircleCollider2D:
+				{
+					ComponentBlock<CircleCollider2DRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const CircleCollider2DRecord& record, const auto&)
+					{
+						auto& c = e.Add<CircleCollider2DComponent>();
+						c.Offset = record.Offset;
+						c.Radius = record.Radius;
+						c.Density = record.Density;
+						c.Friction = record.Friction;
+						c.Restitution = record.Restitution;
+						UnpackFilter(record.Filter, c);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::CapsuleCollider2D:
+				{
+					ComponentBlock<CapsuleCollider2DRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const CapsuleCollider2DRecord& record, const auto&)
+					{
+						auto& c = e.Add<CapsuleCollider2DComponent>();
+						c.Offset = record.Offset;
+						c.Height = record.Height;
+						c.Radius = record.Radius;
+						c.Horizontal = record.Horizontal != 0;
+						c.Density = record.Density;
+						c.Friction = record.Friction;
+						c.Restitution = record.Restitution;
+						UnpackFilter(record.Filter, c);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::PolygonCollider2D:
+				{
+					ComponentBlock<PolygonCollider2DRecord, glm::vec2> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const PolygonCollider2DRecord& record, const auto& data)
+					{
+						if (!data.HasElements(record.FirstPoint, record.PointCount))
+							return false;
+
+						auto& c = e.Add<PolygonCollider2DComponent>();
+						c.Offset = record.Offset;
+						c.Points.assign(data.Elements.begin() + record.FirstPoint, data.Elements.begin() + record.FirstPoint + record.PointCount);
+						c.Radius = record.Radius;
+						c.Density = record.Density;
+						c.Friction = record.Friction;
+						c.Restitution = record.Restitution;
+						UnpackFilter(record.Filter, c);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::ChainCollider2D:
+				{
+					ComponentBlock<ChainCollider2DRecord, glm::vec2> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const ChainCollider2DRecord& record, const auto& data)
+					{
+						if (!data.HasElements(record.FirstPoint, record.PointCount))
+							return false;
+
+						auto& c = e.Add<ChainCollider2DComponent>();
+						c.Points.assign(data.Elements.begin() + record.FirstPoint, data.Elements.begin() + record.FirstPoint + record.PointCount);
+						c.Loop = record.Loop != 0;
+						c.Friction = record.Friction;
+						c.Restitution = record.Restitution;
+						c.CategoryBits = record.CategoryBits;
+						c.MaskBits = record.MaskBits;
+						c.GroupIndex = record.GroupIndex;
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Prefab:
+				{
+					ComponentBlock<PrefabRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const PrefabRecord& record, const auto&)
+					{
+						auto& c = e.Add<PrefabComponent>();
+						c.PrefabID = record.PrefabID;
+						c.EntityID = record.EntityID;
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::NativeScript:
+				{
+					ComponentBlock<NativeScriptRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const NativeScriptRecord& record, const auto&)
+					{
+						auto& c = e.Add<NativeScriptComponent>();
+						c.ScriptHandle = record.ScriptHandle;
+
+						if (c.ScriptHandle != 0)
+							c.BindFromHandle(c.ScriptHandle);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::SpriteAnimator:
+				{
+					ComponentBlock<SpriteAnimatorRecord, uint64_t> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const SpriteAnimatorRecord& record, const auto& data)
+					{
+						if (!data.HasElements(record.FirstAnimation, record.AnimationCount))
+							return false;
+
+						auto& c = e.Add<SpriteAnimatorComponent>();
+						c.animationHandles.reserve(record.AnimationCount);
+						for (uint32_t i = 0; i < record.AnimationCount; i++)
+							c.animationHandles.push_back(data.Elements[record.FirstAnimation + i]);
+
+						c.currentAnimationIndex = record.CurrentAnimation;
+						c.currentFrame = record.CurrentFrame;
+						c.frameTimer = record.FrameTimer;
+						c.playbackSpeed = record.PlaybackSpeed;
+						c.tint = sf::Color(record.Tint);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Text:
+				{
+					ComponentBlock<TextRecord> block;
+					valid = readComponents(block, payloadSize, [&](Entity& e, const TextRecord& record, const auto&)
+					{
+						if (!hasString(record.Text))
+							return false;
+
+						auto& c = e.Add<TextComponent>(record.FontHandle, strings[record.Text]);
+						c.characterSize = record.CharacterSize;
+						c.fillColor = sf::Color(record.FillColor);
+						c.outlineColor = sf::Color(record.OutlineColor);
+						c.outlineThickness = record.OutlineThickness;
+						c.letterSpacing = record.LetterSpacing;
+						c.lineSpacing = record.LineSpacing;
+						c.style = record.Style;
+						c.lineAlignment = (TextComponent::LineAlignment)record.LineAlignment;
+						c.textOrientation = (TextComponent::TextOrientation)record.TextOrientation;
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::SpriteRenderer:
+				{
+					ComponentBlock<SpriteRendererRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const SpriteRendererRecord& record, const auto&)
+					{
+						auto& c = e.Add<SpriteRendererComponent>(record.SpriteHandle);
+						c.tint = sf::Color(record.Tint);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Tilemap:
+				{
+					ComponentBlock<TilemapRecord, TilemapChunkRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const TilemapRecord& record, const auto& data)
+					{
+						if (!data.HasElements(record.FirstChunk, record.ChunkCount))
+							return false;
+
+						auto& c = e.Add<TilemapComponent>();
+						c.TilesetHandle = record.TilesetHandle;
+						c.Tint = sf::Color(record.Tint);
+						c.GenerateColliders = record.GenerateColliders != 0;
+						c.Friction = record.Friction;
+						c.Restitution = record.Restitution;
+						c.CategoryBits = record.CategoryBits;
+						c.MaskBits = record.MaskBits;
+
+						// Whole chunks are copied, the tile count SetTile would keep is recomputed instead
+						for (uint32_t i = 0; i < record.ChunkCount; i++)
+						{
+							const auto& chunkRecord = data.Elements[record.FirstChunk + i];
+
+							TilemapChunk chunk;
+							chunk.Tiles = chunkRecord.Tiles;
+							for (uint16_t tile : chunk.Tiles)
+								chunk.TileCount += tile != 0;
+
+							if (chunk.TileCount == 0)
+								continue;
+
+							chunk.Revision = ++c.Revision;
+							c.Chunks[TilemapComponent::ChunkKey(chunkRecord.X, chunkRecord.Y)] = chunk;
+						}
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::ParticleEmitter:
+				{
+					ComponentBlock<ParticleEmitterRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const ParticleEmitterRecord& record, const auto&)
+					{
+						auto& c = e.Add<ParticleEmitterComponent>();
+						c.EmitterHandle = record.EmitterHandle;
+						c.Playing = record.Playing != 0;
+						c.SimulationSpeed = record.SimulationSpeed;
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Lifespan:
+				{
+					ComponentBlock<LifespanRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const LifespanRecord& record, const auto&)
+					{
+						e.Add<LifespanComponent>(record.Lifespan, record.FrameCreated);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Invincibility:
+				{
+					ComponentBlock<InvincibilityRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const InvincibilityRecord& record, const auto&)
+					{
+						e.Add<InvincibilityComponent>(record.Frames);
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Patrol:
+				{
+					ComponentBlock<PatrolRecord, glm::vec2> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const PatrolRecord& record, const auto& data)
+					{
+						if (!data.HasElements(record.FirstPosition, record.PositionCount))
+							return false;
+
+						auto& c = e.Add<PatrolComponent>();
+						c.positions.assign(data.Elements.begin() + record.FirstPosition, data.Elements.begin() + record.FirstPosition + record.PositionCount);
+						c.currentPosition = record.CurrentPosition;
+						c.speed = record.Speed;
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::State:
+				{
+					ComponentBlock<StateRecord> block;
+					valid = readComponents(block, payloadSize, [&](Entity& e, const StateRecord& record, const auto&)
+					{
+						if (!hasString(record.State) || !hasString(record.PreviousState))
+							return false;
+
+						auto& c = e.Add<StateComponent>(strings[record.State]);
+						c.previousState = strings[record.PreviousState];
+						c.changeAnimation = record.ChangeAnimation != 0;
+						return true;
+					});
+					break;
+				}
+				case SceneBlock::Transform:
+				{
+					ComponentBlock<TransformRecord> block;
+					valid = readComponents(block, payloadSize, [](Entity& e, const TransformRecord& record, const auto&)
+					{
+						e.Add<TransformComponent>(record.Translation, record.Scale, record.Angle);
+						return true;
+					});
+					break;
+				}
+				default:
+					// Written by a newer engine, the payload size lets it be skipped
+					break;
+			}
+
+			if (!valid)
+			{
+				std::cerr << "[SceneBinarySerializer] Component block " << type << " is corrupt" << std::endl;
+				return false;
+			}
+
+			stream.SetStreamPosition(payloadEnd);
+		}
+
+		if (!stream)
+		{
+			std::cerr << "[SceneBinarySerializer] Scene is truncated" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	namespace
+	{
+		// Frees the scene's entities from the global pool, the scene itself does not on destruction
+		void ReleaseEntities(Scene& scene)
+		{
+			for (auto& entity : scene.GetEntityManager().GetEntities())
+				EntityMemoryPool::Instance().DestroyEntity(entity.UUID());
+
+			for (auto& entity : scene.GetEntityManager().GetPendingEntities())
+				EntityMemoryPool::Instance().DestroyEntity(entity.UUID());
+
+			scene.GetEntityManager().Clear();
+		}
+	}
+
+	SceneLoadBenchmarkResult SceneBinarySerializer::RunLoadBenchmark(uint32_t entityCount, uint32_t iterationCount)
+	{
+		SceneLoadBenchmarkResult result;
+		result.EntityCount = entityCount;
+		result.IterationCount = iterationCount;
+
+		std::vector<uint8_t> binary;
+		std::string jsonText;
+		{
+			auto source = std::make_shared<Scene>("Benchmark");
+
+			constexpr uint32_t groupSize = 8;
+			Entity parent;
+			for (uint32_t i = 0; i < entityCount; i++)
+			{
+				bool isRoot = i % groupSize == 0;
+				Entity entity = isRoot ? source->CreateEntityImmediate("Entity") : source->CreateChildEntityImmediate(parent, "Child");
+				if (isRoot)
+					parent = entity;
+
+				entity.Get<TransformComponent>().Translation = { (float)(i % 256) * 16.0f, (float)(i / 256) * 16.0f, 0.0f };
+				entity.Add<SpriteRendererComponent>();
+
+				if (i % 3 == 0)
+				{
+					entity.Add<RigidBody2DComponent>();
+					entity.Add<BoxCollider2DComponent>();
+				}
+			}
+
+			MemoryStreamWriter writer(binary);
+			SceneBinarySerializer(source).Serialize(writer);
+
+			// Packs used to store the scene as JSON text, parsing it is part of the cost
+			nlohmann::json json;
+			SceneSerializer(source).SerializeToJSON(json);
+			jsonText = json.dump();
+
+			// Loading recreates the same UUIDs
+			ReleaseEntities(*source);
+		}
+
+		result.BinarySize = binary.size();
+
+		using Clock = std::chrono::steady_clock;
+		double binaryTime = 0.0;
+		double jsonTime = 0.0;
+
+		for (uint32_t i = 0; i < iterationCount; i++)
+		{
+			{
+				auto scene = std::make_shared<Scene>();
+				MemoryStreamReader reader(BufferView(binary.data(), binary.size()));
+
+				auto start = Clock::now();
+				SceneBinarySerializer(scene).Deserialize(reader);
+				binaryTime += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+				ReleaseEntities(*scene);
+			}
+
+			{
+				auto scene = std::make_shared<Scene>();
+
+				auto start = Clock::now();
+				nlohmann::json json = nlohmann::json::parse(jsonText);
+				SceneSerializer(scene).DeserializeFromJSON(json);
+				jsonTime += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+				ReleaseEntities(*scene);
+			}
+		}
+
+		if (iterationCount > 0)
+		{
+			result.BinaryLoadTime = (float)(binaryTime / iterationCount);
+			result.JsonLoadTime = (float)(jsonTime / iterationCount);
+		}
+
+		return result;
+	}
+}
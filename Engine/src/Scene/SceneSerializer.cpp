@@ -1,4 +1,5 @@
 #include "Scene/SceneSerializer.h"
+#include "Scene/SceneBinarySerializer.h"
 #include "ECS/Components/Components.h"
 #include "Resource/EditorResourceManager.h"
 #include "Project/Project.h"
@@ -124,7 +125,8 @@ namespace Luden
 					{"Mass", c.Mass},
 					{"LinearDrag", c.LinearDrag},
 					{"AngularDrag", c.AngularDrag},
-					{"GravityScale", c.GravityScale}
+					{"GravityScale", c.GravityScale},
+					{"IsBullet", c.IsBullet}
 				};
 			}
 
@@ -139,7 +141,9 @@ namespace Luden
 					{"Restitution", c.Restitution},
 					{"CategoryBits", c.CategoryBits},  
 					{"MaskBits", c.MaskBits},          
-					{"GroupIndex", c.GroupIndex}
+					{"GroupIndex", c.GroupIndex},
+					{"CollisionEvents", c.CollisionEvents},
+					{"IsSensor", c.IsSensor}
 				};
 			}
 
@@ -154,6 +158,67 @@ namespace Luden
 					{"Restitution", c.Restitution},
 					{"CategoryBits", c.CategoryBits},  
 					{"MaskBits", c.MaskBits},          
+					{"GroupIndex", c.GroupIndex},
+					{"CollisionEvents", c.CollisionEvents},
+					{"IsSensor", c.IsSensor}
+				};
+			}
+
+			if (e.Has<CapsuleCollider2DComponent>())
+			{
+				const auto& c = e.Get<CapsuleCollider2DComponent>();
+				jEntity["CapsuleCollider2DComponent"] = {
+					{"Offset", {c.Offset.x, c.Offset.y}},
+					{"Height", c.Height},
+					{"Radius", c.Radius},
+					{"Horizontal", c.Horizontal},
+					{"Density", c.Density},
+					{"Friction", c.Friction},
+					{"Restitution", c.Restitution},
+					{"CategoryBits", c.CategoryBits},
+					{"MaskBits", c.MaskBits},
+					{"GroupIndex", c.GroupIndex},
+					{"CollisionEvents", c.CollisionEvents},
+					{"IsSensor", c.IsSensor}
+				};
+			}
+
+			if (e.Has<PolygonCollider2DComponent>())
+			{
+				const auto& c = e.Get<PolygonCollider2DComponent>();
+				json points = json::array();
+				for (const auto& p : c.Points)
+					points.push_back({ p.x, p.y });
+
+				jEntity["PolygonCollider2DComponent"] = {
+					{"Offset", {c.Offset.x, c.Offset.y}},
+					{"Points", points},
+					{"Radius", c.Radius},
+					{"Density", c.Density},
+					{"Friction", c.Friction},
+					{"Restitution", c.Restitution},
+					{"CategoryBits", c.CategoryBits},
+					{"MaskBits", c.MaskBits},
+					{"GroupIndex", c.GroupIndex},
+					{"CollisionEvents", c.CollisionEvents},
+					{"IsSensor", c.IsSensor}
+				};
+			}
+
+			if (e.Has<ChainCollider2DComponent>())
+			{
+				const auto& c = e.Get<ChainCollider2DComponent>();
+				json points = json::array();
+				for (const auto& p : c.Points)
+					points.push_back({ p.x, p.y });
+
+				jEntity["ChainCollider2DComponent"] = {
+					{"Points", points},
+					{"Loop", c.Loop},
+					{"Friction", c.Friction},
+					{"Restitution", c.Restitution},
+					{"CategoryBits", c.CategoryBits},
+					{"MaskBits", c.MaskBits},
 					{"GroupIndex", c.GroupIndex}
 				};
 			}
@@ -182,6 +247,57 @@ namespace Luden
 				};
 			}
 
+			if (e.Has<TilemapComponent>())
+			{
+				const auto& c = e.Get<TilemapComponent>();
+
+				// Tiles are run-length encoded as [tile, count, tile, count, ...]
+				json jChunks = json::array();
+				for (const auto& [key, chunk] : c.Chunks)
+				{
+					json jTiles = json::array();
+					for (size_t i = 0; i < chunk.Tiles.size();)
+					{
+						uint16_t tile = chunk.Tiles[i];
+						size_t count = 1;
+						while (i + count < chunk.Tiles.size() && chunk.Tiles[i + count] == tile)
+							count++;
+
+						jTiles.push_back(tile);
+						jTiles.push_back(count);
+						i += count;
+					}
+
+					jChunks.push_back({
+						{"X", TilemapComponent::ChunkKeyX(key)},
+						{"Y", TilemapComponent::ChunkKeyY(key)},
+						{"Tiles", jTiles}
+					});
+				}
+
+				jEntity["TilemapComponent"] = {
+					{"TilesetHandle", static_cast<uint64_t>(c.TilesetHandle)},
+					{"Tint", {c.Tint.r, c.Tint.g, c.Tint.b, c.Tint.a}},
+					{"GenerateColliders", c.GenerateColliders},
+					{"Friction", c.Friction},
+					{"Restitution", c.Restitution},
+					{"CategoryBits", c.CategoryBits},
+					{"MaskBits", c.MaskBits},
+					{"ChunkSize", TilemapChunk::Size},
+					{"Chunks", jChunks}
+				};
+			}
+
+			if (e.Has<ParticleEmitterComponent>())
+			{
+				const auto& c = e.Get<ParticleEmitterComponent>();
+				jEntity["ParticleEmitterComponent"] = {
+					{"EmitterHandle", static_cast<uint64_t>(c.EmitterHandle)},
+					{"Playing", c.Playing},
+					{"SimulationSpeed", c.SimulationSpeed}
+				};
+			}
+
 			if (e.Has<SpriteAnimatorComponent>())
 			{
 				const auto& c = e.Get<SpriteAnimatorComponent>();
@@ -263,6 +379,12 @@ namespace Luden
 			jEntities.push_back(jEntity);
 		}
 		outJson["Entities"] = jEntities;
+
+		const auto& physics = m_Scene->GetPhysicsManager();
+		outJson["Physics2D"] = {
+			{"SubStepCount", physics.GetSubStepCount()},
+			{"Continuous", physics.IsContinuousEnabled()}
+		};
 		return true;
 	}
 
@@ -274,6 +396,13 @@ namespace Luden
 		m_Scene->Handle = inJson["UUID"].get<uint64_t>();
 		m_Scene->SetName(inJson["Name"].get<std::string>());
 
+		if (inJson.contains("Physics2D"))
+		{
+			auto& physics = m_Scene->GetPhysicsManager();
+			physics.SetSubStepCount(inJson["Physics2D"].value("SubStepCount", 4));
+			physics.SetContinuousEnabled(inJson["Physics2D"].value("Continuous", true));
+		}
+
 		auto& entityManager = m_Scene->GetEntityManager();
 		entityManager.Clear();
 
@@ -352,6 +481,7 @@ namespace Luden
 				c.LinearDrag = jEntity["RigidBody2DComponent"]["LinearDrag"].get<float>();
 				c.AngularDrag = jEntity["RigidBody2DComponent"]["AngularDrag"].get<float>();
 				c.GravityScale = jEntity["RigidBody2DComponent"]["GravityScale"].get<float>();
+				c.IsBullet = jEntity["RigidBody2DComponent"].value("IsBullet", false);
 			}
 
 			if (jEntity.contains("BoxCollider2DComponent"))
@@ -370,6 +500,8 @@ namespace Luden
 				c.CategoryBits = jEntity["BoxCollider2DComponent"].value("CategoryBits", 1);  
 				c.MaskBits = jEntity["BoxCollider2DComponent"].value("MaskBits", 1);        
 				c.GroupIndex = jEntity["BoxCollider2DComponent"].value("GroupIndex", 0);
+				c.CollisionEvents = jEntity["BoxCollider2DComponent"].value("CollisionEvents", (uint8_t)CollisionEvent::All);
+				c.IsSensor = jEntity["BoxCollider2DComponent"].value("IsSensor", false);
 			}
 
 			if (jEntity.contains("CircleCollider2DComponent"))
@@ -383,9 +515,74 @@ namespace Luden
 				c.Density = jEntity["CircleCollider2DComponent"]["Density"].get<float>();
 				c.Friction = jEntity["CircleCollider2DComponent"]["Friction"].get<float>();
 				c.Restitution = jEntity["CircleCollider2DComponent"]["Restitution"].get<float>();
-				c.CategoryBits = jEntity["BoxCollider2DComponent"].value("CategoryBits", 1);  
-				c.MaskBits = jEntity["BoxCollider2DComponent"].value("MaskBits", 1);         
-				c.GroupIndex = jEntity["BoxCollider2DComponent"].value("GroupIndex", 0);
+				c.CategoryBits = jEntity["CircleCollider2DComponent"].value("CategoryBits", 1);  
+				c.MaskBits = jEntity["CircleCollider2DComponent"].value("MaskBits", 1);         
+				c.GroupIndex = jEntity["CircleCollider2DComponent"].value("GroupIndex", 0);
+				c.CollisionEvents = jEntity["CircleCollider2DComponent"].value("CollisionEvents", (uint8_t)CollisionEvent::All);
+				c.IsSensor = jEntity["CircleCollider2DComponent"].value("IsSensor", false);
+			}
+
+			if (jEntity.contains("CapsuleCollider2DComponent"))
+			{
+				e.Add<CapsuleCollider2DComponent>();
+				auto& c = e.Get<CapsuleCollider2DComponent>();
+				const auto& jCapsule = jEntity["CapsuleCollider2DComponent"];
+
+				auto offset = jCapsule["Offset"];
+				c.Offset = { offset[0].get<float>(), offset[1].get<float>() };
+				c.Height = jCapsule.value("Height", 1.0f);
+				c.Radius = jCapsule.value("Radius", 0.25f);
+				c.Horizontal = jCapsule.value("Horizontal", false);
+				c.Density = jCapsule.value("Density", 1.0f);
+				c.Friction = jCapsule.value("Friction", 1.0f);
+				c.Restitution = jCapsule.value("Restitution", 0.0f);
+				c.CategoryBits = jCapsule.value("CategoryBits", 1);
+				c.MaskBits = jCapsule.value("MaskBits", 1);
+				c.GroupIndex = jCapsule.value("GroupIndex", 0);
+				c.CollisionEvents = jCapsule.value("CollisionEvents", (uint8_t)CollisionEvent::All);
+				c.IsSensor = jCapsule.value("IsSensor", false);
+			}
+
+			if (jEntity.contains("PolygonCollider2DComponent"))
+			{
+				e.Add<PolygonCollider2DComponent>();
+				auto& c = e.Get<PolygonCollider2DComponent>();
+				const auto& jPolygon = jEntity["PolygonCollider2DComponent"];
+
+				auto offset = jPolygon["Offset"];
+				c.Offset = { offset[0].get<float>(), offset[1].get<float>() };
+
+				c.Points.clear();
+				for (const auto& p : jPolygon["Points"])
+					c.Points.emplace_back(p[0].get<float>(), p[1].get<float>());
+
+				c.Radius = jPolygon.value("Radius", 0.0f);
+				c.Density = jPolygon.value("Density", 1.0f);
+				c.Friction = jPolygon.value("Friction", 1.0f);
+				c.Restitution = jPolygon.value("Restitution", 0.0f);
+				c.CategoryBits = jPolygon.value("CategoryBits", 1);
+				c.MaskBits = jPolygon.value("MaskBits", 1);
+				c.GroupIndex = jPolygon.value("GroupIndex", 0);
+				c.CollisionEvents = jPolygon.value("CollisionEvents", (uint8_t)CollisionEvent::All);
+				c.IsSensor = jPolygon.value("IsSensor", false);
+			}
+
+			if (jEntity.contains("ChainCollider2DComponent"))
+			{
+				e.Add<ChainCollider2DComponent>();
+				auto& c = e.Get<ChainCollider2DComponent>();
+				const auto& jChain = jEntity["ChainCollider2DComponent"];
+
+				c.Points.clear();
+				for (const auto& p : jChain["Points"])
+					c.Points.emplace_back(p[0].get<float>(), p[1].get<float>());
+
+				c.Loop = jChain.value("Loop", false);
+				c.Friction = jChain.value("Friction", 1.0f);
+				c.Restitution = jChain.value("Restitution", 0.0f);
+				c.CategoryBits = jChain.value("CategoryBits", 1);
+				c.MaskBits = jChain.value("MaskBits", 1);
+				c.GroupIndex = jChain.value("GroupIndex", 0);
 			}
 
 			if (jEntity.contains("InvincibilityComponent"))
@@ -413,8 +610,8 @@ namespace Luden
 				e.Add<StateComponent>(
 					jEntity["StateComponent"]["state"]
 				);
-				auto stateComponent = e.Get<StateComponent>();
-				stateComponent.previousState = jEntity["StateComponent"]["previousState"],
+				auto& stateComponent = e.Get<StateComponent>();
+				stateComponent.previousState = jEntity["StateComponent"]["previousState"];
 				stateComponent.changeAnimation = jEntity["StateComponent"]["changeAnimation"];
 			}
 
@@ -467,6 +664,66 @@ namespace Luden
 				}
 			}
 
+			if (jEntity.contains("ParticleEmitterComponent"))
+			{
+				const auto& jEmitter = jEntity["ParticleEmitterComponent"];
+
+				auto& c = e.Add<ParticleEmitterComponent>();
+				c.EmitterHandle = jEmitter.value("EmitterHandle", (uint64_t)0);
+				c.Playing = jEmitter.value("Playing", true);
+				c.SimulationSpeed = jEmitter.value("SimulationSpeed", 1.0f);
+			}
+
+			if (jEntity.contains("TilemapComponent"))
+			{
+				const auto& jTilemap = jEntity["TilemapComponent"];
+
+				auto& c = e.Add<TilemapComponent>();
+				c.TilesetHandle = jTilemap.value("TilesetHandle", (uint64_t)0);
+				c.GenerateColliders = jTilemap.value("GenerateColliders", true);
+				c.Friction = jTilemap.value("Friction", 1.0f);
+				c.Restitution = jTilemap.value("Restitution", 0.0f);
+				c.CategoryBits = jTilemap.value("CategoryBits", 1);
+				c.MaskBits = jTilemap.value("MaskBits", 0x00FF);
+
+				if (jTilemap.contains("Tint"))
+				{
+					const auto& jTint = jTilemap["Tint"];
+					c.Tint = sf::Color(
+						jTint[0].get<uint8_t>(),
+						jTint[1].get<uint8_t>(),
+						jTint[2].get<uint8_t>(),
+						jTint[3].get<uint8_t>()
+					);
+				}
+
+				int32_t chunkSize = jTilemap.value("ChunkSize", TilemapChunk::Size);
+				if (jTilemap.contains("Chunks"))
+				{
+					for (const auto& jChunk : jTilemap["Chunks"])
+					{
+						int32_t originX = jChunk["X"].get<int32_t>() * chunkSize;
+						int32_t originY = jChunk["Y"].get<int32_t>() * chunkSize;
+
+						const auto& jTiles = jChunk["Tiles"];
+						int32_t index = 0;
+						for (size_t i = 0; i + 1 < jTiles.size(); i += 2)
+						{
+							uint16_t tile = jTiles[i].get<uint16_t>();
+							int32_t count = jTiles[i + 1].get<int32_t>();
+
+							if (tile != 0)
+							{
+								for (int32_t n = 0; n < count; n++)
+									c.SetTile(originX + (index + n) % chunkSize, originY + (index + n) / chunkSize, tile);
+							}
+
+							index += count;
+						}
+					}
+				}
+			}
+
 			if (jEntity.contains("SpriteAnimatorComponent"))
 			{
 				const auto& jAnim = jEntity["SpriteAnimatorComponent"];
@@ -542,27 +799,24 @@ namespace Luden
 		return true;
 	}
 
-	bool SceneSerializer::SerializeToResourcePack(FileStreamWriter& stream, ResourceSerializationInfo& outInfo)
+	bool SceneSerializer::SerializeToResourcePack(StreamWriter& stream, ResourceSerializationInfo& outInfo)
 	{
-		json outJson;
-		SerializeToJSON(outJson);
-
 		outInfo.Offset = stream.GetStreamPosition();
-		std::string jsonStr = outJson.dump();
-		stream.WriteString(jsonStr);
+
+		SceneBinarySerializer serializer(m_Scene);
+		if (!serializer.Serialize(stream))
+			return false;
+
 		outInfo.Size = stream.GetStreamPosition() - outInfo.Offset;
 		return true;
 	}
 
-	bool SceneSerializer::DeserializeFromResourcePack(FileStreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo)
+	bool SceneSerializer::DeserializeFromResourcePack(StreamReader& stream, const ResourcePackFile::SceneInfo& sceneInfo)
 	{
 		stream.SetStreamPosition(sceneInfo.PackedOffset);
 
-		std::string jsonStr;
-		stream.ReadString(jsonStr);
-
-		json inJson = json::parse(jsonStr);
-		return DeserializeFromJSON(inJson);
+		SceneBinarySerializer serializer(m_Scene);
+		return serializer.Deserialize(stream);
 	}
 
 }
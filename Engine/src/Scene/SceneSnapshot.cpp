@@ -0,0 +1,58 @@
+#include "Scene/SceneSnapshot.h"
+
+#include <algorithm>
+
+namespace Luden
+{
+	void SceneSnapshotBuffer::SetCapacity(uint32_t capacity)
+	{
+		m_Snapshots.resize(capacity);
+		Clear();
+	}
+
+	SceneSnapshot& SceneSnapshotBuffer::Acquire(uint64_t tick)
+	{
+		SceneSnapshot& snapshot = m_Snapshots[m_Head];
+		snapshot.Tick = tick;
+
+		m_Head = (m_Head + 1) % GetCapacity();
+		m_Count = std::min(m_Count + 1, GetCapacity());
+		return snapshot;
+	}
+
+	const SceneSnapshot* SceneSnapshotBuffer::Find(uint64_t tick) const
+	{
+		for (uint32_t age = 0; age < m_Count; age++)
+		{
+			const SceneSnapshot& snapshot = m_Snapshots[SlotOf(age)];
+			if (snapshot.Tick == tick)
+				return &snapshot;
+		}
+		return nullptr;
+	}
+
+	void SceneSnapshotBuffer::DiscardAfter(uint64_t tick)
+	{
+		while (m_Count > 0 && m_Snapshots[SlotOf(0)].Tick > tick)
+		{
+			m_Head = SlotOf(0);
+			m_Count--;
+		}
+	}
+
+	void SceneSnapshotBuffer::Clear()
+	{
+		m_Head = 0;
+		m_Count = 0;
+	}
+
+	const SceneSnapshot* SceneSnapshotBuffer::GetOldest() const
+	{
+		return m_Count > 0 ? &m_Snapshots[SlotOf(m_Count - 1)] : nullptr;
+	}
+
+	const SceneSnapshot* SceneSnapshotBuffer::GetNewest() const
+	{
+		return m_Count > 0 ? &m_Snapshots[SlotOf(0)] : nullptr;
+	}
+}
@@ -21,5 +21,10 @@ namespace Luden
 		{
 			DebugManager::Instance().DrawBox(center, extent, color, duration);
 		}
+
+		void ClearPersistentDebugDraw()
+		{
+			DebugManager::Instance().ClearPersistent();
+		}
 	}
 }
\ No newline at end of file
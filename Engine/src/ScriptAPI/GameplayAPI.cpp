@@ -14,6 +14,7 @@
 #include <cmath>
 #include <iostream>
 #include <random>
+#include <unordered_set>
 #include <SFML/Graphics/RenderWindow.hpp>
 
 
@@ -36,14 +37,8 @@ namespace Luden
 				return {};
 			}
 
-			Entity entity = scene->Instantiate(prefab, &location, nullptr, nullptr);
-
-			if (entity.Has<RigidBody2DComponent>())
-			{
-				scene->GetPhysicsManager().RegisterEntity(entity);
-			}
-
-			return entity;
+			// Instantiating while playing queues the physics bodies of the new entities
+			return scene->Instantiate(prefab, &location, nullptr, nullptr);
 		}
 
 		Entity SpawnPrefabAsChild(PrefabRef prefab, Entity parent, const glm::vec3& localPosition)
@@ -67,14 +62,7 @@ namespace Luden
 				return {};
 			}
 
-			Entity entity = scene->InstantiateChild(prefab, parent, &localPosition, nullptr, nullptr);
-
-			if (entity.Has<RigidBody2DComponent>())
-			{
-				scene->GetPhysicsManager().RegisterEntity(entity);
-			}
-
-			return entity;
+			return scene->InstantiateChild(prefab, parent, &localPosition, nullptr, nullptr);
 		}
 
 		Entity SpawnEntity(const String& tag, const Vec3& location)
@@ -224,10 +212,9 @@ namespace Luden
 			{
 				if (entity.Has<TransformComponent>())
 				{
-					auto& translation = entity.Get<TransformComponent>().Translation;
+					Vec3 offset = entity.Get<TransformComponent>().Translation - center;
 
-					// glm::distance returns length(a -b), so we have to use radiusSquared
-					if (glm::distance(center, translation) <= radiusSquared)
+					if (glm::dot(offset, offset) <= radiusSquared)
 						result.push_back(entity);
 				}
 			}
@@ -699,30 +686,29 @@ namespace Luden
 			if (!cameraEntity.IsValid() || !cameraEntity.Has<Camera2DComponent>())
 				return { viewportMouseX, viewportMouseY };
 
-			sf::RenderTexture* renderTexture = GEngine.GetRenderTexture();
-			if (!renderTexture)
-				return { viewportMouseX, viewportMouseY };
-
 			auto& camera = cameraEntity.Get<Camera2DComponent>();
 			const sf::View& view = camera.Camera.GetView();
 
-			sf::Vector2u textureSize = renderTexture->getSize();
-
-			float scaleX = (float)textureSize.x / viewportSize.x;
-			float scaleY = (float)textureSize.y / viewportSize.y;
+			// Map through the view directly so the result does not depend on how the scene is presented
+			// (offscreen texture, letterboxed window or editor viewport)
+			sf::Vector2f normalized = {
+				2.0f * viewportMouseX / viewportSize.x - 1.0f,
+				1.0f - 2.0f * viewportMouseY / viewportSize.y
+			};
+			sf::Vector2f worldPos = view.getInverseTransform().transformPoint(normalized);
 
-
-			float textureMouseX = viewportMouseX * scaleX;
-			float textureMouseY = viewportMouseY * scaleY;
+			return { worldPos.x, worldPos.y };
+		}
 
 
-			sf::Vector2i texturePixel((int)textureMouseX, (int)textureMouseY);
-			sf::Vector2f worldPos = renderTexture->mapPixelToCoords(texturePixel, view);
+		static bool HasPhysicsBody(Entity entity)
+		{
+			if (entity.Has<RigidBody2DComponent>() && b2Body_IsValid(entity.Get<RigidBody2DComponent>().RuntimeBodyId))
+				return true;
 
-			return { worldPos.x, worldPos.y };
+			return entity.Has<TilemapComponent>() && b2Body_IsValid(entity.Get<TilemapComponent>().RuntimeBodyId);
 		}
 
-
 		Entity GetEntityUnderMouse()
 		{
 			Vec2 mouseWorld = GetMousePosition();
@@ -730,8 +716,23 @@ namespace Luden
 			if (!scene)
 				return {};
 
+			// Entities with a body are hit through their colliders, the broadphase finds them without testing shapes
+			// one by one. The others keep the rect test. The scan keeps the entity order as precedence, the order the
+			// broadphase reports overlaps in is arbitrary
+			std::unordered_set<EntityID> colliderHits;
+			for (Entity& hit : Physics2DAPI::OverlapPoint(mouseWorld))
+				colliderHits.insert(hit.UUID());
+
 			for (auto& entity : scene->GetEntityManager().GetEntities())
 			{
+				if (HasPhysicsBody(entity))
+				{
+					if (colliderHits.contains(entity.UUID()))
+						return entity;
+
+					continue;
+				}
+
 				if (!entity.Has<TransformComponent>())
 					continue;
 
@@ -764,10 +765,6 @@ namespace Luden
 			if (!cameraEntity.IsValid() || !cameraEntity.Has<Camera2DComponent>())
 				return false;
 
-			sf::RenderTexture* renderTexture = GEngine.GetRenderTexture();
-			if (!renderTexture)
-				return false;
-
 			auto& camera = cameraEntity.Get<Camera2DComponent>();
 			const sf::View& view = camera.Camera.GetView();
 
@@ -786,12 +783,11 @@ namespace Luden
 
 		Vec2 GetScreenSize()
 		{
-			sf::RenderTexture* renderTexture = GEngine.GetRenderTexture();
-			if (!renderTexture)
+			Scene* scene = GetCurrentScene();
+			if (!scene)
 				return { 0.0f, 0.0f };
 
-			sf::Vector2u size = renderTexture->getSize();
-			return { static_cast<float>(size.x), static_cast<float>(size.y) };
+			return { static_cast<float>(scene->GetViewportWidth()), static_cast<float>(scene->GetViewportHeight()) };
 		}
 
 		Vec2 GetWorldBounds()
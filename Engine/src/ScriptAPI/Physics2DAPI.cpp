@@ -3,14 +3,99 @@
 #include "ECS/Entity.h"
 #include "Core/EngineContext.h"
 #include "Scene/Scene.h"
+#include "Physics2D/CollisionChannelRegistry.h"
 
 #include <glm/vec2.hpp>
 #include "glm/trigonometric.hpp"
 
+#include <algorithm>
+#include <unordered_set>
+
 namespace Luden
 {
 	namespace Physics2DAPI
 	{
+		static constexpr uint32_t s_RaycastBatchRange = 64; // Minimum rays per job
+
+		struct OverlapContext
+		{
+			Scene* scene;
+			std::vector<Entity>* entities;
+			std::unordered_set<UUID> seen; // Entities with several shapes are reported once
+		};
+
+		struct ShapeCastContext
+		{
+			b2ShapeId shapeId = b2_nullShapeId;
+			b2Vec2 point = { 0.0f, 0.0f };
+			b2Vec2 normal = { 0.0f, 0.0f };
+			float fraction = 1.0f;
+		};
+
+		// Nullptr when no scene is simulating
+		static Scene* GetQueryScene()
+		{
+			Scene* scene = GEngine.GetActiveScene();
+			if (!scene || !b2World_IsValid(scene->GetPhysicsWorldId()))
+				return nullptr;
+
+			return scene;
+		}
+
+		// Scripts work in pixels with y down, the physics world in meters with y up
+		static b2Vec2 ToPhysicsPosition(Physics2DManager& manager, glm::vec2 position)
+		{
+			float scale = manager.GetPhysicsScale();
+			return { position.x / scale, (manager.GetViewportHeight() - position.y) / scale };
+		}
+
+		static glm::vec2 ToWorldPosition(Physics2DManager& manager, b2Vec2 position)
+		{
+			float scale = manager.GetPhysicsScale();
+			return { position.x * scale, manager.GetViewportHeight() - position.y * scale };
+		}
+
+		static b2QueryFilter MakeQueryFilter(uint16_t channelMask)
+		{
+			b2QueryFilter filter = b2DefaultQueryFilter();
+			// Box2D also tests the shape mask against the query category, all bits so only the channel mask filters
+			filter.categoryBits = B2_DEFAULT_MASK_BITS;
+			filter.maskBits = channelMask;
+			return filter;
+		}
+
+		static bool CollectOverlap(b2ShapeId shapeId, void* ctx)
+		{
+			OverlapContext* context = static_cast<OverlapContext*>(ctx);
+
+			Entity entity = context->scene->FindEntityByShapeId(shapeId);
+			if (entity.IsValid() && context->seen.insert(entity.UUID()).second)
+				context->entities->push_back(entity);
+
+			return true;
+		}
+
+		static std::vector<Entity> OverlapProxy(Scene* scene, const b2ShapeProxy& proxy, uint16_t channelMask)
+		{
+			std::vector<Entity> entities;
+
+			OverlapContext context{ scene, &entities };
+			b2World_OverlapShape(scene->GetPhysicsWorldId(), &proxy, MakeQueryFilter(channelMask), CollectOverlap, &context);
+
+			return entities;
+		}
+
+		static b2ShapeProxy MakeWorldProxy(Physics2DManager& manager, const std::vector<glm::vec2>& points, float radius)
+		{
+			b2Vec2 physicsPoints[B2_MAX_POLYGON_VERTICES];
+			int count = std::min((int)points.size(), B2_MAX_POLYGON_VERTICES);
+
+			for (int i = 0; i < count; i++)
+				physicsPoints[i] = ToPhysicsPosition(manager, points[i]);
+
+			return b2MakeProxy(physicsPoints, count, radius / manager.GetPhysicsScale());
+		}
+
 		b2WorldId GetPhysicsWorld()
 		{
 			return GEngine.GetActiveScene()->GetPhysicsWorldId();
@@ -197,13 +282,9 @@ namespace Luden
 			result.normal = { hit.normal.x, hit.normal.y };
 			result.fraction = hit.fraction; 
 
-			if (b2Shape_IsValid(hit.shapeId)) {
-				b2BodyId bodyId = b2Shape_GetBody(hit.shapeId);
-				Entity hitEntity = GEngine.GetActiveScene()->FindEntityByBodyId(bodyId);
-
-				if (hitEntity.IsValid()) {
-					result.hitEntityId = hitEntity.UUID();
-				}
+			Entity hitEntity = GEngine.GetActiveScene()->FindEntityByShapeId(hit.shapeId);
+			if (hitEntity.IsValid()) {
+				result.hitEntityId = hitEntity.UUID();
 			}
 
 			return result;
@@ -240,15 +321,10 @@ namespace Luden
 					hit.fraction = fraction;
 					hit.shapeId = shapeId;
 
-					if (b2Shape_IsValid(shapeId))
+					Entity hitEntity = context->scene->FindEntityByShapeId(shapeId);
+					if (hitEntity.IsValid())
 					{
-						b2BodyId bodyId = b2Shape_GetBody(shapeId);
-						Entity hitEntity = context->scene->FindEntityByBodyId(bodyId);
-
-						if (hitEntity.IsValid())
-						{
-							hit.hitEntityId = hitEntity.UUID();
-						}
+						hit.hitEntityId = hitEntity.UUID();
 					}
 
 					context->hits->push_back(hit);
@@ -265,5 +341,142 @@ namespace Luden
 
 			return results;
 		}
+
+		uint16_t ChannelMask(const std::vector<std::string>& channelNames)
+		{
+			return CollisionChannelRegistry::Instance().CreateMask(channelNames);
+		}
+
+		std::vector<Entity> OverlapPoint(glm::vec2 point, uint16_t channelMask)
+		{
+			Scene* scene = GetQueryScene();
+			if (!scene)
+				return {};
+
+			return OverlapProxy(scene, MakeWorldProxy(scene->GetPhysicsManager(), { point }, 0.0f), channelMask);
+		}
+
+		std::vector<Entity> OverlapCircle(glm::vec2 center, float radius, uint16_t channelMask)
+		{
+			Scene* scene = GetQueryScene();
+			if (!scene)
+				return {};
+
+			return OverlapProxy(scene, MakeWorldProxy(scene->GetPhysicsManager(), { center }, radius), channelMask);
+		}
+
+		std::vector<Entity> OverlapAABB(glm::vec2 min, glm::vec2 max, uint16_t channelMask)
+		{
+			std::vector<Entity> entities;
+
+			Scene* scene = GetQueryScene();
+			if (!scene)
+				return entities;
+
+			auto& manager = scene->GetPhysicsManager();
+			b2Vec2 a = ToPhysicsPosition(manager, min);
+			b2Vec2 b = ToPhysicsPosition(manager, max);
+
+			b2AABB box;
+			box.lowerBound = { std::min(a.x, b.x), std::min(a.y, b.y) };
+			box.upperBound = { std::max(a.x, b.x), std::max(a.y, b.y) };
+
+			OverlapContext context{ scene, &entities };
+			b2World_OverlapAABB(scene->GetPhysicsWorldId(), box, MakeQueryFilter(channelMask), CollectOverlap, &context);
+
+			return entities;
+		}
+
+		std::vector<Entity> OverlapPolygon(const std::vector<glm::vec2>& points, uint16_t channelMask)
+		{
+			Scene* scene = GetQueryScene();
+			if (!scene || points.empty())
+				return {};
+
+			return OverlapProxy(scene, MakeWorldProxy(scene->GetPhysicsManager(), points, 0.0f), channelMask);
+		}
+
+		RaycastHit ShapeCast(const std::vector<glm::vec2>& points, float radius, glm::vec2 translation, uint16_t channelMask)
+		{
+			RaycastHit result;
+
+			Scene* scene = GetQueryScene();
+			if (!scene || points.empty())
+				return result;
+
+			auto& manager = scene->GetPhysicsManager();
+			b2ShapeProxy proxy = MakeWorldProxy(manager, points, radius);
+			b2Vec2 physicsTranslation = { translation.x / manager.GetPhysicsScale(), -translation.y / manager.GetPhysicsScale() };
+
+			auto castCallback = [](b2ShapeId shapeId, b2Vec2 point, b2Vec2 normal, float fraction, void* ctx) -> float
+				{
+					ShapeCastContext* context = static_cast<ShapeCastContext*>(ctx);
+					context->shapeId = shapeId;
+					context->point = point;
+					context->normal = normal;
+					context->fraction = fraction;
+
+					// Clip the sweep so only closer hits are reported afterwards
+					return fraction;
+				};
+
+			ShapeCastContext context;
+			b2World_CastShape(scene->GetPhysicsWorldId(), &proxy, physicsTranslation, MakeQueryFilter(channelMask), castCallback, &context);
+
+			if (!b2Shape_IsValid(context.shapeId))
+				return result;
+
+			result.hit = true;
+			result.point = ToWorldPosition(manager, context.point);
+			result.normal = { context.normal.x, -context.normal.y };
+			result.fraction = context.fraction;
+			result.shapeId = context.shapeId;
+
+			Entity hitEntity = scene->FindEntityByShapeId(context.shapeId);
+			if (hitEntity.IsValid())
+				result.hitEntityId = hitEntity.UUID();
+
+			return result;
+		}
+
+		std::vector<RaycastHit> RaycastBatch(std::span<const Ray> rays, uint16_t channelMask)
+		{
+			std::vector<RaycastHit> results(rays.size());
+
+			Scene* scene = GetQueryScene();
+			if (!scene || rays.empty())
+				return results;
+
+			auto& manager = scene->GetPhysicsManager();
+			b2WorldId worldId = scene->GetPhysicsWorldId();
+			b2QueryFilter filter = MakeQueryFilter(channelMask);
+
+			// Queries only read the world, so rays can be cast concurrently as long as nothing steps it meanwhile
+			GEngine.GetJobSystem().ParallelFor((uint32_t)rays.size(), s_RaycastBatchRange, [&](uint32_t begin, uint32_t end)
+				{
+					for (uint32_t i = begin; i < end; i++)
+					{
+						b2Vec2 origin = ToPhysicsPosition(manager, rays[i].start);
+						b2Vec2 target = ToPhysicsPosition(manager, rays[i].end);
+
+						b2RayResult hit = b2World_CastRayClosest(worldId, origin, b2Sub(target, origin), filter);
+						if (!hit.hit)
+							continue;
+
+						RaycastHit& result = results[i];
+						result.hit = true;
+						result.point = ToWorldPosition(manager, hit.point);
+						result.normal = { hit.normal.x, -hit.normal.y };
+						result.fraction = hit.fraction;
+						result.shapeId = hit.shapeId;
+
+						Entity hitEntity = scene->FindEntityByShapeId(hit.shapeId);
+						if (hitEntity.IsValid())
+							result.hitEntityId = hitEntity.UUID();
+					}
+				});
+
+			return results;
+		}
 	}
-}
\ No newline at end of file
+}
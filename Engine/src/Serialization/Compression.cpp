@@ -0,0 +1,30 @@
+#include "Serialization/Compression.h"
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+namespace Luden
+{
+	bool Compression::CompressLZ4(BufferView source, std::vector<uint8_t>& outCompressed)
+	{
+		if (source.Size == 0 || source.Size > LZ4_MAX_INPUT_SIZE)
+			return false;
+
+		outCompressed.resize(LZ4_compressBound((int)source.Size));
+		int compressedSize = LZ4_compress_HC((const char*)source.Data, (char*)outCompressed.data(), (int)source.Size, (int)outCompressed.size(), LZ4HC_CLEVEL_DEFAULT);
+		if (compressedSize <= 0)
+			return false;
+
+		outCompressed.resize(compressedSize);
+		return true;
+	}
+
+	bool Compression::DecompressLZ4(BufferView source, void* destination, uint64_t destinationSize)
+	{
+		if (source.Size > LZ4_MAX_INPUT_SIZE || destinationSize > LZ4_MAX_INPUT_SIZE)
+			return false;
+
+		int decompressedSize = LZ4_decompress_safe((const char*)source.Data, (char*)destination, (int)source.Size, (int)destinationSize);
+		return decompressedSize >= 0 && (uint64_t)decompressedSize == destinationSize;
+	}
+}
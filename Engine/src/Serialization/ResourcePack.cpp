@@ -1,15 +1,68 @@
 #include "Serialization/ResourcePack.h"
 
 #include "Core/Platform.h"
+#include "Graphics/Animation.h"
+#include "Graphics/ParticleEmitter.h"
+#include "Graphics/Sprite.h"
+#include "Graphics/Tileset.h"
+#include "IO/MemoryStream.h"
 #include "Resource/ResourceManager.h"
 #include "Resource/ResourceImporter.h"
+#include "Scene/Prefab.h"
 #include "Scene/Scene.h"
 #include "Scene/SceneSerializer.h"
+#include "Serialization/TextureAtlasBuilder.h"
+#include "Serialization/Compression.h"
 #include "Audio/Sound.h"
 #include "Audio/Music.h"
 
+#include <algorithm>
+#include <iostream>
+#include <unordered_set>
+
 namespace Luden {
 
+	// Every resource goes into the table once, scenes only keep the range of their indices into it
+	static void BuildIndex(ResourcePackFile::IndexTable& index, const std::map<uint64_t, ResourcePackFile::ResourceInfo>& resources, const std::unordered_map<ResourceHandle, std::unordered_set<ResourceHandle>>& sceneDependencies)
+	{
+		index.Resources.clear();
+		index.Resources.reserve(resources.size());
+		index.ResourceNames.clear();
+		index.ResourceNames.reserve(resources.size());
+		for (const auto& [handle, resourceInfo] : resources)
+		{
+			index.Resources.push_back(resourceInfo);
+			index.Resources.back().Handle = handle;
+
+			// Atlas pages are not in the registry and get no name
+			const ResourceMetadata metadata = Project::GetEditorResourceManager()->GetMetadata(handle);
+			index.ResourceNames.push_back(metadata.IsValid() ? ResourceNameIndex::GetResourceName(metadata.FilePath) : std::string());
+		}
+
+		auto findIndex = [&index](uint64_t handle)
+			{
+				auto it = std::lower_bound(index.Resources.begin(), index.Resources.end(), handle, [](const ResourcePackFile::ResourceInfo& info, uint64_t value) { return info.Handle < value; });
+				return (uint32_t)(it - index.Resources.begin());
+			};
+
+		index.Dependencies.clear();
+		for (auto& [sceneHandle, sceneInfo] : index.Scenes)
+		{
+			sceneInfo.FirstDependency = (uint32_t)index.Dependencies.size();
+
+			auto it = sceneDependencies.find(sceneHandle);
+			if (it != sceneDependencies.end())
+			{
+				for (ResourceHandle resourceHandle : it->second)
+					index.Dependencies.push_back(findIndex(resourceHandle));
+			}
+
+			// Sorted ranges can be binary searched, and follow the table order
+			std::sort(index.Dependencies.begin() + sceneInfo.FirstDependency, index.Dependencies.end());
+			sceneInfo.DependencyCount = (uint32_t)index.Dependencies.size() - sceneInfo.FirstDependency;
+		}
+	}
+
 	ResourcePack::ResourcePack(const std::filesystem::path& path)
 		: m_Path(path)
 	{
@@ -48,52 +101,69 @@ namespace Luden {
 
 		const ResourcePackFile::SceneInfo& sceneInfo = it->second;
 
-		FileStreamReader stream(m_Path);
-		std::shared_ptr<Scene> scene = ResourceImporter::DeserializeSceneFromResourcePack(stream, sceneInfo);
+		std::shared_ptr<Scene> scene;
+		if (sceneInfo.Flags & (uint16_t)ResourcePackFlag::CompressedLZ4)
+		{
+			std::vector<uint8_t> sceneData;
+			if (!DecompressEntry(sceneInfo.PackedOffset, sceneInfo.PackedSize, sceneInfo.UnpackedSize, sceneData))
+				return nullptr;
+
+			ResourcePackFile::SceneInfo unpackedInfo;
+			unpackedInfo.PackedSize = sceneInfo.UnpackedSize;
+			unpackedInfo.UnpackedSize = sceneInfo.UnpackedSize;
+
+			MemoryStreamReader stream(BufferView(sceneData.data(), sceneData.size()));
+			scene = ResourceImporter::DeserializeSceneFromResourcePack(stream, unpackedInfo);
+		}
+		else
+		{
+			MemoryStreamReader stream(m_Mapping.GetView());
+			scene = ResourceImporter::DeserializeSceneFromResourcePack(stream, sceneInfo);
+		}
+
+		if (!scene)
+			return nullptr;
+
 		scene->Handle = sceneHandle;
 		return scene;
 	}
 
-	std::shared_ptr<Resource> ResourcePack::LoadResource(ResourceHandle sceneHandle, ResourceHandle resourceHandle)
+	std::shared_ptr<Resource> ResourcePack::LoadResource(ResourceHandle resourceHandle)
 	{
-		const ResourcePackFile::ResourceInfo* resourceInfo = nullptr;
+		std::shared_ptr<Resource> resource = DecodeResource(resourceHandle);
+		if (!resource || !ResourceImporter::FinalizeResource(resource))
+			return nullptr;
 
-		bool foundResource = false;
-		if (sceneHandle)
-		{
-			// Fast(er) path
-			auto it = m_File.Index.Scenes.find(sceneHandle);
-			if (it != m_File.Index.Scenes.end())
-			{
-				const ResourcePackFile::SceneInfo& sceneInfo = it->second;
-				auto resourceIt = sceneInfo.Resources.find(resourceHandle);
-				if (resourceIt != sceneInfo.Resources.end())
-				{
-					foundResource = true;
-					resourceInfo = &resourceIt->second;
-				}
-			}
-		}
+		return resource;
+	}
 
-		if (!foundResource)
-		{
-			// Slow(er) path
-			for (const auto& [handle, sceneInfo] : m_File.Index.Scenes)
-			{
-				auto resourceIt = sceneInfo.Resources.find(resourceHandle);
-				if (resourceIt != sceneInfo.Resources.end())
-				{
-					resourceInfo = &resourceIt->second;
-					break;
-				}
-			}
+	std::shared_ptr<Resource> ResourcePack::DecodeResource(ResourceHandle resourceHandle) const
+	{
+		const ResourcePackFile::ResourceInfo* resourceInfo = FindResourceInfo(resourceHandle);
+		if (!resourceInfo)
+			return nullptr;
 
-			if (!resourceInfo)
+		std::shared_ptr<Resource> resource;
+		if (resourceInfo->Flags & (uint16_t)ResourcePackFlag::CompressedLZ4)
+		{
+			// Only types that do not keep pointing into their data once decoded are compressed, see the pack serializer
+			std::vector<uint8_t> resourceData;
+			if (!DecompressEntry(resourceInfo->PackedOffset, resourceInfo->PackedSize, resourceInfo->UnpackedSize, resourceData))
 				return nullptr;
+
+			ResourcePackFile::ResourceInfo unpackedInfo = *resourceInfo;
+			unpackedInfo.PackedOffset = 0;
+			unpackedInfo.PackedSize = resourceInfo->UnpackedSize;
+
+			MemoryStreamReader stream(BufferView(resourceData.data(), resourceData.size()));
+			resource = ResourceImporter::DeserializeFromResourcePack(stream, unpackedInfo);
+		}
+		else
+		{
+			MemoryStreamReader stream(m_Mapping.GetView());
+			resource = ResourceImporter::DeserializeFromResourcePack(stream, *resourceInfo);
 		}
 
-		FileStreamReader stream(m_Path);
-		std::shared_ptr<Resource> resource = ResourceImporter::DeserializeFromResourcePack(stream, *resourceInfo);
 		if (!resource)
 			return nullptr;
 
@@ -101,9 +171,44 @@ namespace Luden {
 		return resource;
 	}
 
+	bool ResourcePack::DecompressEntry(uint64_t offset, uint64_t packedSize, uint64_t unpackedSize, std::vector<uint8_t>& outData) const
+	{
+		BufferView mapping = m_Mapping.GetView();
+		if (offset + packedSize > mapping.Size)
+		{
+			std::cerr << "[ResourcePack] Compressed entry at " << offset << " is out of the pack" << std::endl;
+			return false;
+		}
+
+		outData.resize(unpackedSize);
+		if (!Compression::DecompressLZ4(mapping.SubView(offset, packedSize), outData.data(), unpackedSize))
+		{
+			std::cerr << "[ResourcePack] Failed to decompress entry at " << offset << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	std::vector<ResourceHandle> ResourcePack::GetSceneDependencies(ResourceHandle sceneHandle) const
+	{
+		std::vector<ResourceHandle> dependencies;
+
+		auto it = m_File.Index.Scenes.find(sceneHandle);
+		if (it == m_File.Index.Scenes.end())
+			return dependencies;
+
+		const ResourcePackFile::SceneInfo& sceneInfo = it->second;
+		dependencies.reserve(sceneInfo.DependencyCount);
+		for (uint32_t i = 0; i < sceneInfo.DependencyCount; i++)
+			dependencies.push_back(m_File.Index.Resources[m_File.Index.Dependencies[sceneInfo.FirstDependency + i]].Handle);
+
+		return dependencies;
+	}
+
 	bool ResourcePack::IsResourceHandleValid(ResourceHandle resourceHandle) const
 	{
-		return m_ResourceHandleIndex.find(resourceHandle) != m_ResourceHandleIndex.end();
+		return m_ResourceLookup.contains(resourceHandle) || m_File.Index.Scenes.contains(resourceHandle);
 	}
 
 	bool ResourcePack::IsResourceHandleValid(ResourceHandle sceneHandle, ResourceHandle resourceHandle) const
@@ -112,63 +217,55 @@ namespace Luden {
 		if (sceneIterator == m_File.Index.Scenes.end())
 			return false;
 
+		auto resourceIt = m_ResourceLookup.find(resourceHandle);
+		if (resourceIt == m_ResourceLookup.end())
+			return false;
+
+		// A scene's indices are sorted, so its range can be searched for the resource's index directly
 		const auto& sceneInfo = sceneIterator->second;
-		return sceneInfo.Resources.find(resourceHandle) != sceneInfo.Resources.end();
+		auto first = m_File.Index.Dependencies.begin() + sceneInfo.FirstDependency;
+		return std::binary_search(first, first + sceneInfo.DependencyCount, resourceIt->second);
 	}
 
-	Buffer ResourcePack::ReadAppBinary()
+	BufferView ResourcePack::ReadAppBinary() const
 	{
-		FileStreamReader stream(m_Path);
+		MemoryStreamReader stream(m_Mapping.GetView());
 		stream.SetStreamPosition(m_File.Index.PackedAppBinaryOffset);
-		Buffer buffer;
-		stream.ReadBuffer(buffer);
+		BufferView buffer;
+		stream.ReadBufferView(buffer);
 		return buffer;
 	}
 
-	uint64_t ResourcePack::GetBuildVersion()
+	uint64_t ResourcePack::GetBuildVersion() const
 	{
 		return m_File.Header.BuildVersion;
 	}
 
-	ResourceType ResourcePack::GetResourceType(ResourceHandle sceneHandle, ResourceHandle resourceHandle) const
+	ResourceType ResourcePack::GetResourceType(ResourceHandle resourceHandle) const
 	{
-		const ResourcePackFile::ResourceInfo* resourceInfo = nullptr;
+		const ResourcePackFile::ResourceInfo* resourceInfo = FindResourceInfo(resourceHandle);
+		if (!resourceInfo)
+			return ResourceType::None;
 
-		bool foundResource = false;
-		if (sceneHandle)
-		{
-			// Fast(er) path
-			auto it = m_File.Index.Scenes.find(sceneHandle);
-			if (it != m_File.Index.Scenes.end())
-			{
-				const ResourcePackFile::SceneInfo& sceneInfo = it->second;
-				auto resourceIt = sceneInfo.Resources.find(resourceHandle);
-				if (resourceIt != sceneInfo.Resources.end())
-				{
-					foundResource = true;
-					resourceInfo = &resourceIt->second;
-				}
-			}
-		}
+		return (ResourceType)resourceInfo->Type;
+	}
 
-		if (!foundResource)
-		{
-			// Slow(er) path
-			for (const auto& [handle, sceneInfo] : m_File.Index.Scenes)
-			{
-				auto resourceIt = sceneInfo.Resources.find(resourceHandle);
-				if (resourceIt != sceneInfo.Resources.end())
-				{
-					resourceInfo = &resourceIt->second;
-					break;
-				}
-			}
+	const ResourcePackFile::SceneInfo* ResourcePack::FindSceneInfo(ResourceHandle sceneHandle) const
+	{
+		auto it = m_File.Index.Scenes.find(sceneHandle);
+		if (it == m_File.Index.Scenes.end())
+			return nullptr;
 
-			if (!resourceInfo)
-				return ResourceType::None;
-		}
+		return &it->second;
+	}
 
-		return (ResourceType)resourceInfo->Type;
+	const ResourcePackFile::ResourceInfo* ResourcePack::FindResourceInfo(ResourceHandle resourceHandle) const
+	{
+		auto it = m_ResourceLookup.find(resourceHandle);
+		if (it == m_ResourceLookup.end())
+			return nullptr;
+
+		return &m_File.Index.Resources[it->second];
 	}
 
 	std::shared_ptr<ResourcePack> ResourcePack::CreateFromActiveProject(std::atomic<float>& progress)
@@ -184,6 +281,13 @@ namespace Luden {
 
 		std::unordered_set<ResourceHandle> fullResourceList;
 
+		// Gathered per scene, flattened into the index's resource table once every scene is known
+		std::map<uint64_t, ResourcePackFile::ResourceInfo> packResources;
+		std::unordered_map<ResourceHandle, std::unordered_set<ResourceHandle>> sceneDependencies;
+
+		// Sprites of each scene get packed into shared atlas pages
+		TextureAtlasBuilder atlasBuilder;
+
 		// Note: user could create more scenes on main thread while resource pack thread is busy serializing these ones!
 		std::unordered_set<ResourceHandle> sceneHandles = ResourceManager::GetAllResourcesWithType<Scene>();
 		uint32_t sceneCount = (uint32_t)sceneHandles.size();
@@ -200,11 +304,29 @@ namespace Luden {
 		std::unordered_set<ResourceHandle> audioFiles = ResourceManager::GetAllResourcesWithType<Sound>();
 		fullResourceList.insert(audioFiles.begin(), audioFiles.end());
 
-		for (const auto sceneHandle : sceneHandles)
+		// Scripts spawn prefabs by name and no scene references them, so every prefab ships with every scene like the
+		// audio files, together with the resources its entities use
+		std::unordered_set<ResourceHandle> prefabResources;
+		for (ResourceHandle prefabHandle : ResourceManager::GetAllResourcesWithType<Prefab>())
+		{
+			std::shared_ptr<Prefab> prefab = ResourceManager::GetResource<Prefab>(prefabHandle);
+			if (!prefab || !prefab->GetScene())
+				continue;
+
+			std::unordered_set<ResourceHandle> prefabResourceList = prefab->GetResourceList(false);
+			prefabResources.insert(prefabResourceList.begin(), prefabResourceList.end());
+			prefabResources.insert(prefabHandle);
+		}
+
+		// Scenes are gathered in a fixed order so the atlas comes out the same when nothing changed
+		std::vector<ResourceHandle> sortedSceneHandles(sceneHandles.begin(), sceneHandles.end());
+		std::sort(sortedSceneHandles.begin(), sortedSceneHandles.end());
+
+		for (const auto sceneHandle : sortedSceneHandles)
 		{
 			const auto metadata = Project::GetEditorResourceManager()->GetMetadata(sceneHandle);
 
-			std::shared_ptr<Scene> scene = std::shared_ptr<Scene>();
+			std::shared_ptr<Scene> scene = std::make_shared<Scene>();
 			SceneSerializer serializer(scene);
 			//TODO: Log ("Deserializing Scene: {}", metadata.FilePath);
 			if (serializer.Deserialize(Project::GetActiveResourceDirectory() / metadata.FilePath))
@@ -228,14 +350,67 @@ namespace Luden {
 				}
 
 				sceneResourceList.insert(audioFiles.begin(), audioFiles.end());
+				sceneResourceList.insert(prefabResources.begin(), prefabResources.end());
 
-				ResourcePackFile::SceneInfo& sceneInfo = resourcePackFile.Index.Scenes[sceneHandle];
+				// Gather every sprite the scene can draw, including animation frames and particles, and tileset textures
+				std::unordered_set<ResourceHandle> sceneSprites;
+				std::unordered_set<ResourceHandle> tilesetTextures;
 				for (ResourceHandle resourceHandle : sceneResourceList)
 				{
-					ResourcePackFile::ResourceInfo& resourceInfo = sceneInfo.Resources[resourceHandle];
+					ResourceType type = ResourceManager::GetResourceType(resourceHandle);
+					if (type == ResourceType::Sprite)
+					{
+						sceneSprites.insert(resourceHandle);
+					}
+					else if (type == ResourceType::Animation)
+					{
+						std::shared_ptr<Animation> animation = ResourceManager::GetResource<Animation>(resourceHandle);
+						if (!animation)
+							continue;
+
+						for (const auto& frame : animation->GetFrames())
+						{
+							if (frame.spriteHandle != 0)
+								sceneSprites.insert(frame.spriteHandle);
+						}
+					}
+					else if (type == ResourceType::ParticleEmitter)
+					{
+						std::shared_ptr<ParticleEmitter> emitter = ResourceManager::GetResource<ParticleEmitter>(resourceHandle);
+						if (emitter && emitter->SpriteHandle != 0)
+							sceneSprites.insert(emitter->SpriteHandle);
+					}
+					else if (type == ResourceType::Tileset)
+					{
+						// Tilesets are already laid out as a grid, their texture is packed as is
+						std::shared_ptr<Tileset> tileset = ResourceManager::GetResource<Tileset>(resourceHandle);
+						if (tileset && tileset->GetTextureHandle() != 0)
+							tilesetTextures.insert(tileset->GetTextureHandle());
+					}
+				}
+
+				std::unordered_set<ResourceHandle> sceneTextures = atlasBuilder.AddSprites(sceneSprites);
+				sceneTextures.insert(tilesetTextures.begin(), tilesetTextures.end());
+				sceneResourceList.insert(sceneSprites.begin(), sceneSprites.end());
+
+				resourcePackFile.Index.Scenes.try_emplace(sceneHandle);
+				for (ResourceHandle resourceHandle : sceneResourceList)
+				{
+					ResourcePackFile::ResourceInfo& resourceInfo = packResources[resourceHandle];
 					resourceInfo.Type = (uint16_t)ResourceManager::GetResourceType(resourceHandle);
+					resourceInfo.Flags = (uint16_t)ResourcePackFlag::None;
 				}
 
+				for (ResourceHandle textureHandle : sceneTextures)
+				{
+					ResourcePackFile::ResourceInfo& resourceInfo = packResources[textureHandle];
+					resourceInfo.Type = (uint16_t)ResourceType::Texture;
+					resourceInfo.Flags = atlasBuilder.GetPage(textureHandle) ? (uint16_t)ResourcePackFlag::AtlasPage : (uint16_t)ResourcePackFlag::None;
+				}
+
+				sceneResourceList.insert(sceneTextures.begin(), sceneTextures.end());
+				sceneDependencies[sceneHandle] = sceneResourceList;
+
 				fullResourceList.insert(sceneResourceList.begin(), sceneResourceList.end());
 			}
 			else
@@ -261,27 +436,35 @@ namespace Luden {
 
 		//TODO: Log("Project contains {} used resources", fullResourceList.size());
 
-		Buffer appBinary;
-
-		ResourcePackSerializer::Serialize(Project::GetActiveResourceDirectory() / "ResourcePack.hap", resourcePackFile, appBinary, progress);
-		progress = 1.0f;
+		BuildIndex(resourcePackFile.Index, packResources, sceneDependencies);
 
-		std::unordered_map<ResourceHandle, ResourcePackFile::ResourceInfo> serializedResources;
-		for (auto& [sceneHandle, sceneInfo] : resourcePackFile.Index.Scenes)
+		for (const auto& [spriteHandle, region] : atlasBuilder.GetRegions())
 		{
-			for (auto& [resourceHandle, resourceInfo] : sceneInfo.Resources)
-			{
-				if (serializedResources.find(resourceHandle) == serializedResources.end())
-				{
-					serializedResources[resourceHandle] = resourceInfo;
-				}
-			}
+			resourcePackFile.Index.AtlasRegions[spriteHandle] = {
+				(uint64_t)region.PageHandle,
+				region.Rect.position.x, region.Rect.position.y,
+				region.Rect.size.x, region.Rect.size.y
+			};
 		}
+		//TODO: Log("Packed {} sprites into {} atlas pages", atlasBuilder.GetRegions().size(), atlasBuilder.GetPages().size());
 
-		for (const auto& [handle, info] : serializedResources)
-		{
-			const auto& metadata = Project::GetEditorResourceManager()->GetMetadata(handle);
-		}
+		Buffer appBinary;
+
+		// The previous build stays mapped while the new one is written next to it, then the new one replaces it
+		std::filesystem::path packPath = Project::GetActiveResourceDirectory() / "ResourcePack.hap";
+		std::filesystem::path buildPath = packPath;
+		buildPath += ".tmp";
+
+		std::shared_ptr<ResourcePack> basePack = std::filesystem::exists(packPath) ? Load(packPath) : nullptr;
+		ResourcePackSerializer::Serialize(buildPath, resourcePackFile, appBinary, atlasBuilder, progress, basePack.get());
+		basePack = nullptr;
+
+		std::error_code error;
+		std::filesystem::rename(buildPath, packPath, error);
+		if (error)
+			std::cerr << "[ResourcePack] Failed to replace " << packPath << ": " << error.message() << std::endl;
+
+		progress = 1.0f;
 
 		return nullptr;
 	}
@@ -293,25 +476,25 @@ namespace Luden {
 
 	std::shared_ptr<ResourcePack> ResourcePack::Load(const std::filesystem::path& path)
 	{
-		std::shared_ptr<ResourcePack> resourcePack = std::shared_ptr<ResourcePack>();
-
-		if (resourcePack == nullptr)
+		std::shared_ptr<ResourcePack> resourcePack = std::make_shared<ResourcePack>(path);
+		if (!resourcePack->m_Mapping.Open(path))
 			return nullptr;
 
-		resourcePack->m_Path = path;
-		bool success = ResourcePackSerializer::DeserializeIndex(resourcePack->m_Path, resourcePack->m_File);
-		if (!success)
+		MemoryStreamReader stream(resourcePack->m_Mapping.GetView());
+		if (!ResourcePackSerializer::DeserializeIndex(stream, resourcePack->m_File))
+		{
+			std::cerr << "[ResourcePack] Invalid resource pack " << path << std::endl;
 			return nullptr;
+		}
 
-		// Populate resource handle index
-		const auto& index = resourcePack->m_File.Index;
-		for (const auto& [sceneHandle, sceneInfo] : index.Scenes)
+		// Populate resource lookup
+		const auto& resources = resourcePack->m_File.Index.Resources;
+		const auto& names = resourcePack->m_File.Index.ResourceNames;
+		resourcePack->m_ResourceLookup.reserve(resources.size());
+		for (uint32_t i = 0; i < (uint32_t)resources.size(); i++)
 		{
-			resourcePack->m_ResourceHandleIndex.insert(sceneHandle);
-			for (const auto& [resourceHandle, resourceInfo] : sceneInfo.Resources)
-			{
-				resourcePack->m_ResourceHandleIndex.insert(resourceHandle);
-			}
+			resourcePack->m_ResourceLookup[resources[i].Handle] = i;
+			resourcePack->m_NameIndex.Add((ResourceType)resources[i].Type, names[i], resources[i].Handle);
 		}
 
 		return resourcePack;
@@ -1,10 +1,20 @@
 #include "Serialization/ResourcePackSerializer.h"
+#include "Serialization/TextureAtlasBuilder.h"
+#include "Serialization/Compression.h"
+#include "Serialization/ResourcePack.h"
+#include "Scene/SceneBinarySerializer.h"
+#include "Core/Hash.h"
+#include "Core/JobSystem.h"
 #include "Resource/ResourceImporter.h"
+#include "Resource/ResourceManager.h"
+#include "Project/Project.h"
+#include "Graphics/Sprite.h"
 #include "IO/FileStream.h"
+#include "IO/MemoryStream.h"
+#include "IO/MappedFile.h"
 
 #include <filesystem>
 #include <fstream>
-#include <unordered_set>
 
 namespace Luden {
 
@@ -15,15 +25,294 @@ namespace Luden {
 			std::filesystem::create_directories(directory);
 	}
 
-	void ResourcePackSerializer::Serialize(const std::filesystem::path& path, ResourcePackFile& file, Buffer appBinary, std::atomic<float>& progress)
+	static bool SerializeAtlasPage(ResourceHandle pageHandle, const TextureAtlasBuilder& atlas, StreamWriter& stream, ResourceSerializationInfo& outInfo)
+	{
+		const TextureAtlasPage* page = atlas.GetPage(pageHandle);
+		if (!page)
+			return false;
+
+		// Stored like any other texture so TextureSerializer can load it back
+		return ResourceImporter::SerializeTextureImageToResourcePack(page->Image, stream, outInfo);
+	}
+
+	static bool SerializeAtlasSprite(ResourceHandle spriteHandle, const ResourcePackFile::AtlasRegion& region, StreamWriter& stream, ResourceSerializationInfo& outInfo)
+	{
+		auto sprite = ResourceManager::GetResource<Sprite>(spriteHandle);
+		if (!sprite)
+			return false;
+
+		Sprite atlasSprite = *sprite;
+		atlasSprite.SetTextureHandle(region.PageHandle);
+		atlasSprite.SetTextureRect({ { region.X, region.Y }, { region.Width, region.Height } });
+		return ResourceImporter::SerializeSpriteToResourcePack(atlasSprite, stream, outInfo);
+	}
+
+	// Serializers of these types copy the source file, the others serialize the resource the editor has loaded
+	static bool SerializesFromFile(ResourceType type)
+	{
+		switch (type)
+		{
+			case ResourceType::Texture:
+			case ResourceType::Sound:
+			case ResourceType::Music:
+			case ResourceType::Font:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	static bool SerializeResource(ResourceHandle handle, const ResourcePackFile::ResourceInfo& resourceInfo, const std::filesystem::path& sourcePath, const ResourcePackFile& file, const TextureAtlasBuilder& atlas, StreamWriter& stream, ResourceSerializationInfo& outInfo)
+	{
+		if (resourceInfo.Flags & (uint16_t)ResourcePackFlag::AtlasPage)
+			return SerializeAtlasPage(handle, atlas, stream, outInfo);
+
+		if ((ResourceType)resourceInfo.Type == ResourceType::Sprite)
+		{
+			auto regionIt = file.Index.AtlasRegions.find(handle);
+			if (regionIt != file.Index.AtlasRegions.end())
+				return SerializeAtlasSprite(handle, regionIt->second, stream, outInfo);
+		}
+
+		if (SerializesFromFile((ResourceType)resourceInfo.Type))
+			return ResourceImporter::SerializeFileToResourcePack((ResourceType)resourceInfo.Type, sourcePath, stream, outInfo);
+
+		return ResourceImporter::SerializeToResourcePack(handle, stream, outInfo);
+	}
+
+	struct PackedEntry
+	{
+		uint64_t Offset = 0;
+		uint64_t PackedSize = 0;
+		uint64_t UnpackedSize = 0;
+		bool Compressed = false;
+	};
+
+	// Types the runtime keeps reading from the mapped pack after loading are stored raw, a decompressed copy would
+	// have to stay resident for as long as the resource lives
+	static bool CanCompress(ResourceType type)
+	{
+		switch (type)
+		{
+			case ResourceType::Font: // sf::Font reads its data lazily
+			case ResourceType::Music: // Streamed while it plays, and already Ogg/FLAC/MP3
+				return false;
+			default:
+				return true;
+		}
+	}
+
+	template<typename T>
+	static void ApplyEntry(const PackedEntry& entry, T& info)
+	{
+		info.PackedOffset = entry.Offset;
+		info.PackedSize = entry.PackedSize;
+		info.UnpackedSize = entry.UnpackedSize;
+
+		if (entry.Compressed)
+			info.Flags |= (uint16_t)ResourcePackFlag::CompressedLZ4;
+		else
+			info.Flags &= ~(uint16_t)ResourcePackFlag::CompressedLZ4;
+	}
+
+	// Entry of the base pack that can be copied instead of building it again
+	struct BaseEntry
+	{
+		bool Valid = false;
+		uint64_t PackedOffset = 0;
+		uint64_t PackedSize = 0;
+		uint64_t UnpackedSize = 0;
+		uint64_t SourceHash = 0;
+		uint64_t ContentHash = 0;
+		uint16_t Flags = 0;
+	};
+
+	template<typename T>
+	static BaseEntry MakeBaseEntry(const T* info, BufferView baseData)
+	{
+		BaseEntry base;
+		if (!info || info->PackedOffset > baseData.Size || info->PackedSize > baseData.Size - info->PackedOffset)
+			return base;
+
+		base.Valid = true;
+		base.PackedOffset = info->PackedOffset;
+		base.PackedSize = info->PackedSize;
+		base.UnpackedSize = info->UnpackedSize;
+		base.SourceHash = info->SourceHash;
+		base.ContentHash = info->ContentHash;
+		base.Flags = info->Flags;
+		return base;
+	}
+
+	// A scene or resource on its way into the pack. Workers fill in everything but its place in the file
+	struct BuildEntry
+	{
+		ResourceHandle Handle = 0;
+		ResourcePackFile::SceneInfo* Scene = nullptr; // Either Scene or Resource is set
+		ResourcePackFile::ResourceInfo* Resource = nullptr;
+		BaseEntry Base;
+		std::filesystem::path SourcePath; // Resolved by the build thread, the editor's resource manager is not thread safe
+
+		uint64_t SourceHash = 0;
+		uint64_t ContentHash = 0;
+		bool Reused = false; // Copied from the base pack
+		bool Failed = false;
+
+		std::vector<uint8_t> Data; // As it is written, compressed when Compressed is set
+		uint64_t UnpackedSize = 0;
+		bool Compressed = false;
+
+		JobCounter Counter;
+	};
+
+	// Scenes fill the global entity pool while they are serialized and prefabs read their entities from it,
+	// so both stay on the build thread
+	static bool SerializesOnBuildThread(const BuildEntry& entry)
+	{
+		return entry.Scene || (ResourceType)entry.Resource->Type == ResourceType::Prefab;
+	}
+
+	template<typename SerializeFunction>
+	static bool SerializeToBuffer(std::vector<uint8_t>& outData, SerializeFunction serialize)
+	{
+		ResourceSerializationInfo serializationInfo;
+		MemoryStreamWriter stream(outData);
+		if (!serialize(stream, serializationInfo))
+			return false;
+
+		// Only the range the serializer reports goes into the pack
+		outData.erase(outData.begin(), outData.begin() + serializationInfo.Offset);
+		outData.resize(serializationInfo.Size);
+		return true;
+	}
+
+	// Runs on the build workers. When the data comes out the same as in the base pack its bytes are copied instead,
+	// which skips compression
+	static void BuildEntryData(BuildEntry& entry, const ResourcePackFile& file, const TextureAtlasBuilder& atlas)
+	{
+		if (entry.Reused || entry.Failed)
+			return;
+
+		// Serialized by the build thread before they get here
+		if (!SerializesOnBuildThread(entry) && !SerializeToBuffer(entry.Data, [&](StreamWriter& stream, ResourceSerializationInfo& outInfo) { return SerializeResource(entry.Handle, *entry.Resource, entry.SourcePath, file, atlas, stream, outInfo); }))
+		{
+			entry.Failed = true;
+			return;
+		}
+
+		BufferView data(entry.Data.data(), entry.Data.size());
+		entry.ContentHash = Hash::Bytes(data);
+		entry.UnpackedSize = data.Size;
+
+		if (entry.Base.Valid && entry.Base.ContentHash == entry.ContentHash && entry.Base.UnpackedSize == data.Size)
+		{
+			entry.Reused = true;
+			std::vector<uint8_t>().swap(entry.Data);
+			return;
+		}
+
+		// Compressed entries are only kept when they save at least an eighth, otherwise the load pays for nothing
+		ResourceType type = entry.Scene ? ResourceType::Scene : (ResourceType)entry.Resource->Type;
+		std::vector<uint8_t> compressed;
+		if (CanCompress(type) && Compression::CompressLZ4(data, compressed) && compressed.size() <= data.Size - data.Size / 8)
+		{
+			entry.Data.swap(compressed);
+			entry.Compressed = true;
+		}
+	}
+
+	static void WriteEntry(FileStreamWriter& stream, BufferView baseData, BuildEntry& entry)
+	{
+		PackedEntry packed;
+		packed.Offset = stream.GetStreamPosition();
+
+		if (entry.Reused)
+		{
+			stream.WriteData((const char*)baseData.Data + entry.Base.PackedOffset, entry.Base.PackedSize);
+			packed.UnpackedSize = entry.Base.UnpackedSize;
+			packed.Compressed = entry.Base.Flags & (uint16_t)ResourcePackFlag::CompressedLZ4;
+		}
+		else
+		{
+			stream.WriteData((const char*)entry.Data.data(), entry.Data.size());
+			packed.UnpackedSize = entry.UnpackedSize;
+			packed.Compressed = entry.Compressed;
+		}
+
+		packed.PackedSize = stream.GetStreamPosition() - packed.Offset;
+
+		if (entry.Scene)
+		{
+			ApplyEntry(packed, *entry.Scene);
+			entry.Scene->SourceHash = entry.SourceHash;
+			entry.Scene->ContentHash = entry.ContentHash;
+		}
+		else
+		{
+			ApplyEntry(packed, *entry.Resource);
+			entry.Resource->SourceHash = entry.SourceHash;
+			entry.Resource->ContentHash = entry.ContentHash;
+		}
+
+		std::vector<uint8_t>().swap(entry.Data);
+	}
+
+	static uint64_t HashSourceFile(const std::filesystem::path& path, uint64_t seed)
+	{
+		if (path.empty() || !std::filesystem::exists(path))
+			return 0;
+
+		MappedFile source;
+		if (!source.Open(path))
+			return 0;
+
+		return Hash::Bytes(source.GetView(), seed);
+	}
+
+	static uint64_t HashSceneSource(const std::filesystem::path& sourcePath)
+	{
+		uint64_t seed = Hash::Combine((uint64_t)ResourceType::Scene, SceneBinarySerializer::Version);
+		return HashSourceFile(sourcePath, seed);
+	}
+
+	// Covers whatever SerializeResource reads. Resources are hashed from their files on disk, atlas pages from
+	// their pixels and atlased sprites additionally from their region
+	static uint64_t HashResourceSource(const ResourcePackFile::ResourceInfo& resourceInfo, const std::filesystem::path& sourcePath, uint64_t textureSettings, const ResourcePackFile& file, const TextureAtlasBuilder& atlas)
+	{
+		uint64_t seed = Hash::Combine(resourceInfo.Type, resourceInfo.Flags & (uint16_t)ResourcePackFlag::AtlasPage);
+
+		// Switching the texture format or import settings rebuilds every texture
+		if ((ResourceType)resourceInfo.Type == ResourceType::Texture)
+			seed = Hash::Combine(seed, textureSettings);
+
+		if (resourceInfo.Flags & (uint16_t)ResourcePackFlag::AtlasPage)
+		{
+			const TextureAtlasPage* page = atlas.GetPage(resourceInfo.Handle);
+			if (!page)
+				return 0;
+
+			sf::Vector2u size = page->Image.getSize();
+			seed = Hash::Combine(seed, ((uint64_t)size.x << 32) | size.y);
+			return Hash::Bytes(page->Image.getPixelsPtr(), (uint64_t)size.x * size.y * 4, seed);
+		}
+
+		if ((ResourceType)resourceInfo.Type == ResourceType::Sprite)
+		{
+			auto regionIt = file.Index.AtlasRegions.find(resourceInfo.Handle);
+			if (regionIt != file.Index.AtlasRegions.end())
+				seed = Hash::Bytes(&regionIt->second, sizeof(ResourcePackFile::AtlasRegion), seed);
+		}
+
+		return HashSourceFile(sourcePath, seed);
+	}
+
+	void ResourcePackSerializer::Serialize(const std::filesystem::path& path, ResourcePackFile& file, Buffer appBinary, const TextureAtlasBuilder& atlas, std::atomic<float>& progress, const ResourcePack* basePack)
 	{
 		// Print Info
 		//TODO: LOG "Serializing ResourcePack to {}", path.string());
 		//TODO: LOG("  {} scenes", file.Index.Scenes.size());
-		uint32_t resourceCount = 0;
-		for (const auto& [sceneHandle, sceneInfo] : file.Index.Scenes)
-			resourceCount += uint32_t(sceneInfo.Resources.size());
-		//TODO: LOG("  {} resources (including duplicates)", resourceCount);
+		//TODO: LOG("  {} resources", file.Index.Resources.size());
+		//TODO: LOG("  {} atlas pages, {} atlased sprites", atlas.GetPages().size(), file.Index.AtlasRegions.size());
 
 		FileStreamWriter serializer(path);
 
@@ -37,91 +326,186 @@ namespace Luden {
 		uint64_t indexTableSize = CalculateIndexTableSize(file);
 		serializer.WriteZero(indexTableSize);
 
-		std::unordered_map<ResourceHandle, ResourceSerializationInfo> serializedResources;
-
-		float progressIncrement = 0.4f / (float)file.Index.Scenes.size();
-
 		// Write app binary data
 		file.Index.PackedAppBinaryOffset = serializer.GetStreamPosition();
 		serializer.WriteBuffer(appBinary);
 		file.Index.PackedAppBinarySize = serializer.GetStreamPosition() - file.Index.PackedAppBinaryOffset;
 		appBinary.Release();
 
-		// Write resource data + fill in offset + size
-		for (auto& [sceneHandle, sceneInfo] : file.Index.Scenes)
+		file.Header.BaseBuildVersion = basePack ? basePack->GetBuildVersion() : 0;
+		BufferView baseData = basePack ? basePack->GetData() : BufferView();
+
+		// Resources are written in the order the scenes first use them, so a scene's data stays close together
+		std::vector<std::pair<ResourceHandle, uint32_t>> order; // Scene, end of the resources written after it in resourceOrder
+		std::vector<uint32_t> resourceOrder;
+		std::vector<bool> orderedResources(file.Index.Resources.size(), false);
+		for (const auto& [sceneHandle, sceneInfo] : file.Index.Scenes)
 		{
-			// Serialize Scene
-			ResourceSerializationInfo serializationInfo;
-			ResourceImporter::SerializeToResourcePack(sceneHandle, serializer, serializationInfo);
-			file.Index.Scenes[sceneHandle].PackedOffset = serializationInfo.Offset;
-			file.Index.Scenes[sceneHandle].PackedSize = serializationInfo.Size;
+			for (uint32_t i = 0; i < sceneInfo.DependencyCount; i++)
+			{
+				uint32_t resourceIndex = file.Index.Dependencies[sceneInfo.FirstDependency + i];
+				if (orderedResources[resourceIndex])
+					continue;
+
+				orderedResources[resourceIndex] = true;
+				resourceOrder.push_back(resourceIndex);
+			}
+			order.push_back({ sceneHandle, (uint32_t)resourceOrder.size() });
+		}
 
-			// Serialize Resources
-			for (auto& [resourceHandle, resourceInfo] : sceneInfo.Resources)
+		uint32_t entryCount = (uint32_t)(order.size() + resourceOrder.size());
+		std::vector<BuildEntry> entries(entryCount);
+		{
+			auto editorResourceManager = Project::GetEditorResourceManager();
+
+			uint32_t entryIndex = 0;
+			uint32_t resourceIndex = 0;
+			for (const auto& [sceneHandle, resourceEnd] : order)
 			{
-				if (serializedResources.find(resourceHandle) != serializedResources.end())
+				BuildEntry& sceneEntry = entries[entryIndex++];
+				sceneEntry.Handle = sceneHandle;
+				sceneEntry.Scene = &file.Index.Scenes[sceneHandle];
+				sceneEntry.Base = MakeBaseEntry(basePack ? basePack->FindSceneInfo(sceneHandle) : nullptr, baseData);
+				sceneEntry.SourcePath = editorResourceManager->GetFileSystemPath(sceneHandle);
+
+				for (; resourceIndex < resourceEnd; resourceIndex++)
 				{
-					// Has already been serialized
-					serializationInfo = serializedResources.at(resourceHandle);
-					file.Index.Scenes[sceneHandle].Resources[resourceHandle].PackedOffset = serializationInfo.Offset;
-					file.Index.Scenes[sceneHandle].Resources[resourceHandle].PackedSize = serializationInfo.Size;
+					BuildEntry& resourceEntry = entries[entryIndex++];
+					resourceEntry.Resource = &file.Index.Resources[resourceOrder[resourceIndex]];
+					resourceEntry.Handle = resourceEntry.Resource->Handle;
+
+					// Atlas pages only exist in the atlas builder
+					if (!(resourceEntry.Resource->Flags & (uint16_t)ResourcePackFlag::AtlasPage))
+						resourceEntry.SourcePath = editorResourceManager->GetFileSystemPath(resourceEntry.Handle);
+
+					const ResourcePackFile::ResourceInfo* baseInfo = basePack ? basePack->FindResourceInfo(resourceEntry.Handle) : nullptr;
+					if (baseInfo && baseInfo->Type == resourceEntry.Resource->Type)
+						resourceEntry.Base = MakeBaseEntry(baseInfo, baseData);
 				}
-				else
+			}
+		}
+
+		// The build gets its own workers, so the engine's pool keeps serving the editor's frames
+		JobSystem workers;
+		workers.Init();
+
+		const ProjectConfig& config = Project::GetActiveProject()->GetConfig();
+		uint64_t textureSettings = Hash::Combine(Hash::Combine(config.PackDecodedTextures, config.GenerateTextureMipmaps), config.PremultiplyTextureAlpha);
+
+		float startProgress = progress;
+		float progressRange = 1.0f - startProgress;
+
+		// Entries whose sources did not change are copied from the base pack without serializing them
+		workers.ParallelFor(entryCount, 1, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
 				{
-					// Serialize resource
-					if (ResourceImporter::SerializeToResourcePack(resourceHandle, serializer, serializationInfo))
-					{
-						file.Index.Scenes[sceneHandle].Resources[resourceHandle].PackedOffset = serializationInfo.Offset;
-						file.Index.Scenes[sceneHandle].Resources[resourceHandle].PackedSize = serializationInfo.Size;
-						serializedResources[resourceHandle] = serializationInfo;
-					}
-					else
+					BuildEntry& entry = entries[i];
+					entry.SourceHash = entry.Scene ? HashSceneSource(entry.SourcePath) : HashResourceSource(*entry.Resource, entry.SourcePath, textureSettings, file, atlas);
+
+					if (entry.Base.Valid && entry.SourceHash != 0 && entry.Base.SourceHash == entry.SourceHash)
 					{
-						//TODO: LOG ERROR("Failed to serialize resource with handle {}", resourceHandle);
+						entry.Reused = true;
+						entry.ContentHash = entry.Base.ContentHash;
 					}
 				}
+			});
+
+		progress = startProgress + progressRange * 0.1f;
+
+		// The editor's resource manager is not thread safe. Resources serialized from their loaded form are loaded
+		// here, the workers then only look them up
+		for (const BuildEntry& entry : entries)
+		{
+			if (entry.Reused || !entry.Resource || (entry.Resource->Flags & (uint16_t)ResourcePackFlag::AtlasPage))
+				continue;
+
+			if (!SerializesFromFile((ResourceType)entry.Resource->Type))
+				Project::GetResourceManager()->GetResource(entry.Handle);
+		}
+
+		// Workers serialize, hash and compress ahead of the writer. The window bounds how much data waits in memory
+		uint32_t window = workers.GetWorkerCount() * 2;
+		uint32_t submitted = 0;
+		uint32_t reusedCount = 0;
+
+		for (uint32_t i = 0; i < entryCount; i++)
+		{
+			for (; submitted < entryCount && submitted <= i + window; submitted++)
+			{
+				BuildEntry& entry = entries[submitted];
+
+				if (SerializesOnBuildThread(entry) && !entry.Reused)
+				{
+					ResourceHandle handle = entry.Handle;
+					if (!SerializeToBuffer(entry.Data, [handle](StreamWriter& stream, ResourceSerializationInfo& outInfo) { return ResourceImporter::SerializeToResourcePack(handle, stream, outInfo); }))
+						entry.Failed = true;
+				}
+
+				workers.Submit([&entry, &file, &atlas]() { BuildEntryData(entry, file, atlas); }, &entry.Counter);
 			}
 
-			progress = progress + progressIncrement;
+			BuildEntry& entry = entries[i];
+			workers.Wait(entry.Counter);
+
+			if (entry.Failed)
+			{
+				//TODO: LOG ERROR("Failed to serialize resource with handle {}", entry.Handle);
+			}
+			else
+			{
+				WriteEntry(serializer, baseData, entry);
+				reusedCount += entry.Reused ? 1 : 0;
+			}
+
+			progress = startProgress + progressRange * (0.1f + 0.85f * (float)(i + 1) / (float)entryCount);
 		}
 
-		//TODO: LOG("Serialized {} resources into ResourcePack", serializedResources.size());
+		//TODO: LOG("Rebuilt {} entries, reused {} from build {}", entryCount - reusedCount, reusedCount, file.Header.BaseBuildVersion);
+		file.Header.ReusedEntries = reusedCount;
+		file.Header.RebuiltEntries = entryCount - reusedCount;
+
+		serializer.SetStreamPosition(0);
+		serializer.WriteRaw<ResourcePackFile::FileHeader>(file.Header);
 
 		serializer.SetStreamPosition(indexPos);
 		serializer.WriteRaw<uint64_t>(file.Index.PackedAppBinaryOffset);
 		serializer.WriteRaw<uint64_t>(file.Index.PackedAppBinarySize);
 
-		uint64_t begin = indexPos;
 		serializer.WriteRaw<uint32_t>((uint32_t)file.Index.Scenes.size()); // Write scene map size
 		for (auto& [sceneHandle, sceneInfo] : file.Index.Scenes)
 		{
 			serializer.WriteRaw<uint64_t>(sceneHandle);
 			serializer.WriteRaw<uint64_t>(sceneInfo.PackedOffset);
 			serializer.WriteRaw<uint64_t>(sceneInfo.PackedSize);
+			serializer.WriteRaw<uint64_t>(sceneInfo.UnpackedSize);
+			serializer.WriteRaw<uint64_t>(sceneInfo.SourceHash);
+			serializer.WriteRaw<uint64_t>(sceneInfo.ContentHash);
 			serializer.WriteRaw<uint16_t>(sceneInfo.Flags);
-
-			serializer.WriteMap(file.Index.Scenes[sceneHandle].Resources);
+			serializer.WriteRaw<uint32_t>(sceneInfo.FirstDependency);
+			serializer.WriteRaw<uint32_t>(sceneInfo.DependencyCount);
 		}
 
-		progress = progress + 0.1f;
+		serializer.WriteArray(file.Index.Resources);
+		serializer.WriteArray(file.Index.Dependencies);
+		serializer.WriteArray(file.Index.ResourceNames);
+		serializer.WriteMap(file.Index.AtlasRegions);
+
+		progress = startProgress + progressRange;
 	}
 
-	bool ResourcePackSerializer::DeserializeIndex(const std::filesystem::path& path, ResourcePackFile& file)
+	bool ResourcePackSerializer::DeserializeIndex(StreamReader& stream, ResourcePackFile& file)
 	{
-		// Print Info
-		//TODO: LOG("Resource Pack", "Deserializing Resource Pack from {}", path.string());
-
-		FileStreamReader stream(path);
 		if (!stream.IsStreamGood())
 			return false;
 
 		stream.ReadRaw<ResourcePackFile::FileHeader>(file.Header);
-		bool validHeader = memcmp(file.Header.HEADER, "HZAP", 4) == 0;
+		ResourcePackFile current;
+		bool validHeader = memcmp(file.Header.HEADER, current.Header.HEADER, 4) == 0;
 
 		if (!validHeader)
 			return false;
 
-		ResourcePackFile current;
 		if (file.Header.Version != current.Header.Version)
 		{
 			//TODO: LOG("ResourcePack version {} is not compatible with current version {}", file.Header.Version, current.Header.Version);
@@ -142,24 +526,65 @@ namespace Luden {
 			ResourcePackFile::SceneInfo& sceneInfo = file.Index.Scenes[sceneHandle];
 			stream.ReadRaw<uint64_t>(sceneInfo.PackedOffset);
 			stream.ReadRaw<uint64_t>(sceneInfo.PackedSize);
+			stream.ReadRaw<uint64_t>(sceneInfo.UnpackedSize);
+			stream.ReadRaw<uint64_t>(sceneInfo.SourceHash);
+			stream.ReadRaw<uint64_t>(sceneInfo.ContentHash);
 			stream.ReadRaw<uint16_t>(sceneInfo.Flags);
+			stream.ReadRaw<uint32_t>(sceneInfo.FirstDependency);
+			stream.ReadRaw<uint32_t>(sceneInfo.DependencyCount);
+		}
 
-			stream.ReadMap(sceneInfo.Resources);
+		uint32_t resourceCount = 0;
+		stream.ReadRaw<uint32_t>(resourceCount);
+		if (resourceCount)
+			stream.ReadArray(file.Index.Resources, resourceCount);
+
+		uint32_t dependencyCount = 0;
+		stream.ReadRaw<uint32_t>(dependencyCount);
+		if (dependencyCount)
+			stream.ReadArray(file.Index.Dependencies, dependencyCount);
+
+		uint32_t nameCount = 0;
+		stream.ReadRaw<uint32_t>(nameCount);
+		if (nameCount)
+			stream.ReadArray(file.Index.ResourceNames, nameCount);
+
+		stream.ReadMap(file.Index.AtlasRegions);
+
+		if (!stream.IsStreamGood() || file.Index.ResourceNames.size() != file.Index.Resources.size())
+			return false;
+
+		// Every range has to stay inside the tables, the runtime indexes them without checking again
+		for (const auto& [sceneHandle, sceneInfo] : file.Index.Scenes)
+		{
+			if ((uint64_t)sceneInfo.FirstDependency + sceneInfo.DependencyCount > file.Index.Dependencies.size())
+				return false;
+		}
+
+		for (uint32_t resourceIndex : file.Index.Dependencies)
+		{
+			if (resourceIndex >= file.Index.Resources.size())
+				return false;
 		}
 
 		//TODO: LOG("Resource Pack", "Deserialized index with {} scenes from ResourcePack", sceneCount);
-		return true;
+		return stream.IsStreamGood();
 	}
 
 	uint64_t ResourcePackSerializer::CalculateIndexTableSize(const ResourcePackFile& file)
 	{
 		uint64_t appInfoSize = sizeof(uint64_t) * 2;
-		uint64_t sceneMapSize = sizeof(uint32_t) + (sizeof(ResourceHandle) + sizeof(uint64_t) * 2 + sizeof(uint16_t)) * file.Index.Scenes.size();
-		uint64_t resourceMapSize = 0;
-		for (const auto& [sceneHandle, sceneInfo] : file.Index.Scenes)
-			resourceMapSize += sizeof(uint32_t) + (sizeof(ResourceHandle) + sizeof(ResourcePackFile::ResourceInfo)) * sceneInfo.Resources.size();
+		uint64_t sceneMapSize = sizeof(uint32_t) + (sizeof(ResourceHandle) + sizeof(uint64_t) * 5 + sizeof(uint16_t) + sizeof(uint32_t) * 2) * file.Index.Scenes.size();
+		uint64_t resourceTableSize = sizeof(uint32_t) + sizeof(ResourcePackFile::ResourceInfo) * file.Index.Resources.size();
+		uint64_t dependencyTableSize = sizeof(uint32_t) + sizeof(uint32_t) * file.Index.Dependencies.size();
+
+		uint64_t nameTableSize = sizeof(uint32_t);
+		for (const std::string& name : file.Index.ResourceNames)
+			nameTableSize += sizeof(size_t) + name.size();
+
+		uint64_t atlasMapSize = sizeof(uint32_t) + (sizeof(uint64_t) + sizeof(ResourcePackFile::AtlasRegion)) * file.Index.AtlasRegions.size();
 
-		return appInfoSize + sceneMapSize + resourceMapSize;
+		return appInfoSize + sceneMapSize + resourceTableSize + dependencyTableSize + nameTableSize + atlasMapSize;
 	}
 
 }
@@ -0,0 +1,367 @@
+#include "Serialization/TextureAtlasBuilder.h"
+
+#include "Core/Hash.h"
+#include "Graphics/Sprite.h"
+#include "Project/Project.h"
+#include "Resource/ResourceManager.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace Luden
+{
+	//////////////////////////////////////////////////////////////////////////////////
+	// MaxRectsBin
+	//////////////////////////////////////////////////////////////////////////////////
+
+	TextureAtlasBuilder::MaxRectsBin::MaxRectsBin(uint32_t width, uint32_t height)
+	{
+		m_FreeRects.push_back({ { 0, 0 }, { (int)width, (int)height } });
+	}
+
+	bool TextureAtlasBuilder::MaxRectsBin::Insert(sf::Vector2i size, sf::IntRect& outRect)
+	{
+		int score = 0;
+		if (!FindPosition(size, outRect, score))
+			return false;
+
+		PlaceRect(outRect);
+		return true;
+	}
+
+	bool TextureAtlasBuilder::MaxRectsBin::FindPosition(sf::Vector2i size, sf::IntRect& outRect, int& outScore) const
+	{
+		int bestShortSide = std::numeric_limits<int>::max();
+		int bestLongSide = std::numeric_limits<int>::max();
+		bool found = false;
+
+		for (const auto& freeRect : m_FreeRects)
+		{
+			if (freeRect.size.x < size.x || freeRect.size.y < size.y)
+				continue;
+
+			int leftoverX = freeRect.size.x - size.x;
+			int leftoverY = freeRect.size.y - size.y;
+			int shortSide = std::min(leftoverX, leftoverY);
+			int longSide = std::max(leftoverX, leftoverY);
+
+			if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+			{
+				outRect = { freeRect.position, size };
+				bestShortSide = shortSide;
+				bestLongSide = longSide;
+				found = true;
+			}
+		}
+
+		outScore = bestShortSide;
+		return found;
+	}
+
+	void TextureAtlasBuilder::MaxRectsBin::PlaceRect(const sf::IntRect& rect)
+	{
+		m_NewFreeRects.clear();
+
+		for (size_t i = 0; i < m_FreeRects.size();)
+		{
+			if (SplitFreeRect(m_FreeRects[i], rect))
+			{
+				m_FreeRects[i] = m_FreeRects.back();
+				m_FreeRects.pop_back();
+			}
+			else
+			{
+				i++;
+			}
+		}
+
+		m_FreeRects.insert(m_FreeRects.end(), m_NewFreeRects.begin(), m_NewFreeRects.end());
+		PruneFreeRects();
+
+		m_UsedSize.x = std::max(m_UsedSize.x, rect.position.x + rect.size.x);
+		m_UsedSize.y = std::max(m_UsedSize.y, rect.position.y + rect.size.y);
+	}
+
+	bool TextureAtlasBuilder::MaxRectsBin::SplitFreeRect(const sf::IntRect& freeRect, const sf::IntRect& usedRect)
+	{
+		if (!freeRect.findIntersection(usedRect))
+			return false;
+
+		int freeRight = freeRect.position.x + freeRect.size.x;
+		int freeBottom = freeRect.position.y + freeRect.size.y;
+		int usedRight = usedRect.position.x + usedRect.size.x;
+		int usedBottom = usedRect.position.y + usedRect.size.y;
+
+		// Top and bottom leftovers
+		if (usedRect.position.y > freeRect.position.y)
+			m_NewFreeRects.push_back({ freeRect.position, { freeRect.size.x, usedRect.position.y - freeRect.position.y } });
+
+		if (usedBottom < freeBottom)
+			m_NewFreeRects.push_back({ { freeRect.position.x, usedBottom }, { freeRect.size.x, freeBottom - usedBottom } });
+
+		// Left and right leftovers
+		if (usedRect.position.x > freeRect.position.x)
+			m_NewFreeRects.push_back({ freeRect.position, { usedRect.position.x - freeRect.position.x, freeRect.size.y } });
+
+		if (usedRight < freeRight)
+			m_NewFreeRects.push_back({ { usedRight, freeRect.position.y }, { freeRight - usedRight, freeRect.size.y } });
+
+		return true;
+	}
+
+	void TextureAtlasBuilder::MaxRectsBin::PruneFreeRects()
+	{
+		auto contains = [](const sf::IntRect& outer, const sf::IntRect& inner)
+		{
+			return inner.position.x >= outer.position.x && inner.position.y >= outer.position.y
+				&& inner.position.x + inner.size.x <= outer.position.x + outer.size.x
+				&& inner.position.y + inner.size.y <= outer.position.y + outer.size.y;
+		};
+
+		for (size_t i = 0; i < m_FreeRects.size(); i++)
+		{
+			for (size_t j = i + 1; j < m_FreeRects.size();)
+			{
+				if (contains(m_FreeRects[j], m_FreeRects[i]))
+				{
+					m_FreeRects.erase(m_FreeRects.begin() + i);
+					i--;
+					break;
+				}
+
+				if (contains(m_FreeRects[i], m_FreeRects[j]))
+					m_FreeRects.erase(m_FreeRects.begin() + j);
+				else
+					j++;
+			}
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+	// TextureAtlasBuilder
+	//////////////////////////////////////////////////////////////////////////////////
+
+	TextureAtlasBuilder::TextureAtlasBuilder(uint32_t pageSize, uint32_t padding)
+		: m_PageSize(pageSize), m_Padding(padding)
+	{
+	}
+
+	std::unordered_set<ResourceHandle> TextureAtlasBuilder::AddSprites(const std::unordered_set<ResourceHandle>& spriteHandles)
+	{
+		struct PendingRegion
+		{
+			ResourceHandle TextureHandle = 0;
+			sf::IntRect SourceRect;
+			std::vector<ResourceHandle> Sprites;
+		};
+
+		std::unordered_set<ResourceHandle> textureHandles;
+		std::vector<PendingRegion> pending;
+
+		// Packed in a fixed order, an unchanged project has to produce the same pages for incremental pack builds
+		std::vector<ResourceHandle> sortedSpriteHandles(spriteHandles.begin(), spriteHandles.end());
+		std::sort(sortedSpriteHandles.begin(), sortedSpriteHandles.end());
+
+		for (ResourceHandle spriteHandle : sortedSpriteHandles)
+		{
+			auto regionIt = m_Regions.find(spriteHandle);
+			if (regionIt != m_Regions.end())
+			{
+				textureHandles.insert(regionIt->second.PageHandle);
+				continue;
+			}
+
+			auto sprite = ResourceManager::GetResource<Sprite>(spriteHandle);
+			if (!sprite || sprite->GetTextureHandle() == 0)
+				continue;
+
+			ResourceHandle textureHandle = sprite->GetTextureHandle();
+			const sf::Image* image = GetSourceImage(textureHandle);
+			if (!image)
+			{
+				textureHandles.insert(textureHandle);
+				continue;
+			}
+
+			sf::IntRect imageRect = { { 0, 0 }, { (int)image->getSize().x, (int)image->getSize().y } };
+			sf::IntRect sourceRect = sprite->UsesFullTexture() ? imageRect : sprite->GetTextureRect();
+
+			int maxRegionSize = (int)m_PageSize - (int)m_Padding;
+			bool outOfBounds = sourceRect.findIntersection(imageRect) != sourceRect;
+			if (outOfBounds || sourceRect.size.x <= 0 || sourceRect.size.y <= 0 || sourceRect.size.x > maxRegionSize || sourceRect.size.y > maxRegionSize)
+			{
+				// Keep the sprite on its own texture
+				textureHandles.insert(textureHandle);
+				continue;
+			}
+
+			// Sprites cut from the same texture region share one atlas slot
+			auto pendingIt = std::find_if(pending.begin(), pending.end(), [&](const PendingRegion& region)
+			{
+				return region.TextureHandle == textureHandle && region.SourceRect == sourceRect;
+			});
+
+			if (pendingIt != pending.end())
+				pendingIt->Sprites.push_back(spriteHandle);
+			else
+				pending.push_back({ textureHandle, sourceRect, { spriteHandle } });
+		}
+
+		// Largest regions first gives MaxRects the best chance
+		std::stable_sort(pending.begin(), pending.end(), [](const PendingRegion& a, const PendingRegion& b)
+		{
+			int maxA = std::max(a.SourceRect.size.x, a.SourceRect.size.y);
+			int maxB = std::max(b.SourceRect.size.x, b.SourceRect.size.y);
+			if (maxA != maxB)
+				return maxA > maxB;
+			return a.SourceRect.size.x * a.SourceRect.size.y > b.SourceRect.size.x * b.SourceRect.size.y;
+		});
+
+		// Only pages created for this batch are filled, so each scene owns its own pages
+		size_t firstPage = m_Pages.size();
+		std::vector<MaxRectsBin> bins;
+
+		int border = (int)m_Padding / 2;
+		for (const auto& region : pending)
+		{
+			sf::Vector2i paddedSize = { region.SourceRect.size.x + (int)m_Padding, region.SourceRect.size.y + (int)m_Padding };
+
+			int bestBin = -1;
+			int bestScore = std::numeric_limits<int>::max();
+			sf::IntRect placement;
+			for (size_t i = 0; i < bins.size(); i++)
+			{
+				sf::IntRect rect;
+				int score = 0;
+				if (bins[i].FindPosition(paddedSize, rect, score) && score < bestScore)
+				{
+					bestBin = (int)i;
+					bestScore = score;
+					placement = rect;
+				}
+			}
+
+			if (bestBin == -1)
+			{
+				bins.emplace_back(m_PageSize, m_PageSize);
+				m_Pages.push_back({ GetPageHandle((uint32_t)m_Pages.size()), sf::Image({ m_PageSize, m_PageSize }, sf::Color::Transparent) });
+
+				bestBin = (int)bins.size() - 1;
+				bins.back().Insert(paddedSize, placement);
+			}
+			else
+			{
+				bins[bestBin].PlaceRect(placement);
+			}
+
+			TextureAtlasPage& page = m_Pages[firstPage + bestBin];
+			sf::IntRect destRect = { { placement.position.x + border, placement.position.y + border }, region.SourceRect.size };
+
+			const sf::Image* source = GetSourceImage(region.TextureHandle);
+			if (!page.Image.copy(*source, { (unsigned)destRect.position.x, (unsigned)destRect.position.y }, region.SourceRect))
+			{
+				std::cerr << "[TextureAtlasBuilder] Failed to copy region of texture " << (uint64_t)region.TextureHandle << " into atlas page\n";
+				continue;
+			}
+
+			ExtrudeEdges(page.Image, destRect);
+
+			for (ResourceHandle spriteHandle : region.Sprites)
+				m_Regions[spriteHandle] = { page.Handle, destRect };
+
+			textureHandles.insert(page.Handle);
+		}
+
+		// Shrink the new pages down to what was actually used
+		for (size_t i = 0; i < bins.size(); i++)
+		{
+			TextureAtlasPage& page = m_Pages[firstPage + i];
+			sf::Vector2i usedSize = bins[i].GetUsedSize();
+			sf::Vector2u croppedSize = { (unsigned)usedSize.x, (unsigned)usedSize.y };
+			if (croppedSize == page.Image.getSize())
+				continue;
+
+			sf::Image cropped(croppedSize, sf::Color::Transparent);
+			if (cropped.copy(page.Image, { 0, 0 }, { { 0, 0 }, usedSize }))
+				page.Image = std::move(cropped);
+		}
+
+		return textureHandles;
+	}
+
+	const TextureAtlasRegion* TextureAtlasBuilder::GetRegion(ResourceHandle spriteHandle) const
+	{
+		auto it = m_Regions.find(spriteHandle);
+		if (it == m_Regions.end())
+			return nullptr;
+
+		return &it->second;
+	}
+
+	const TextureAtlasPage* TextureAtlasBuilder::GetPage(ResourceHandle pageHandle) const
+	{
+		for (const auto& page : m_Pages)
+		{
+			if (page.Handle == pageHandle)
+				return &page;
+		}
+
+		return nullptr;
+	}
+
+	ResourceHandle TextureAtlasBuilder::GetPageHandle(uint32_t pageIndex)
+	{
+		static const uint64_t seed = Hash::Bytes("TextureAtlasPage", 16);
+		return ResourceHandle(Hash::Combine(seed, pageIndex));
+	}
+
+	const sf::Image* TextureAtlasBuilder::GetSourceImage(ResourceHandle textureHandle)
+	{
+		auto it = m_SourceImages.find(textureHandle);
+		if (it != m_SourceImages.end())
+			return &it->second;
+
+		if (m_FailedImages.find(textureHandle) != m_FailedImages.end())
+			return nullptr;
+
+		sf::Image image;
+		auto path = Project::GetEditorResourceManager()->GetFileSystemPath(textureHandle);
+		if (!image.loadFromFile(path))
+		{
+			std::cerr << "[TextureAtlasBuilder] Failed to load texture " << path << ", sprites using it will not be atlased\n";
+			m_FailedImages.insert(textureHandle);
+			return nullptr;
+		}
+
+		return &m_SourceImages.emplace(textureHandle, std::move(image)).first->second;
+	}
+
+	void TextureAtlasBuilder::ExtrudeEdges(sf::Image& page, const sf::IntRect& rect) const
+	{
+		// Repeat the border pixels into the padding so bilinear filtering never samples a neighbour
+		int border = (int)m_Padding / 2;
+		if (border == 0)
+			return;
+
+		sf::Vector2u pageSize = page.getSize();
+		int right = rect.position.x + rect.size.x - 1;
+		int bottom = rect.position.y + rect.size.y - 1;
+
+		for (int y = rect.position.y - border; y <= bottom + border; y++)
+		{
+			for (int x = rect.position.x - border; x <= right + border; x++)
+			{
+				if (x < 0 || y < 0 || x >= (int)pageSize.x || y >= (int)pageSize.y)
+					continue;
+
+				if (x >= rect.position.x && x <= right && y >= rect.position.y && y <= bottom)
+					continue;
+
+				int sourceX = std::clamp(x, rect.position.x, right);
+				int sourceY = std::clamp(y, rect.position.y, bottom);
+				page.setPixel({ (unsigned)x, (unsigned)y }, page.getPixel({ (unsigned)sourceX, (unsigned)sourceY }));
+			}
+		}
+	}
+}
@@ -12,6 +12,7 @@ namespace Luden
         virtual void OnCollisionBegin(const CollisionContact& contact) override;
         virtual void OnCollisionEnd(const CollisionContact& contact) override;
         virtual void OnCollisionHit(const CollisionContact& contact) override;
+        virtual uint8_t GetCollisionEvents() const override { return (uint8_t)CollisionEvent::Begin; }
 
     public:
         float m_Lifetime = 5.0f;
@@ -46,6 +46,18 @@ namespace Luden
         // TODO: On hit(high speed)
     }
 
+    void EnemySpawner::OnSaveState(StreamWriter& writer)
+    {
+        writer.WriteRaw<float>(m_SpawnTimer);
+        writer.WriteRaw<int>(m_CurrentEnemyCount);
+    }
+
+    void EnemySpawner::OnLoadState(StreamReader& reader)
+    {
+        reader.ReadRaw<float>(m_SpawnTimer);
+        reader.ReadRaw<int>(m_CurrentEnemyCount);
+    }
+
     void EnemySpawner::SpawnEnemy()
     {
         Vec3 spawnPos = GetRandomOffscreenPosition();
@@ -123,4 +123,22 @@ namespace Luden
         GameplayAPI::ReloadCurrentScene();
     }
 
+    void GameManager::OnSaveState(StreamWriter& writer)
+    {
+        writer.WriteRaw<int>(m_CurrentWave);
+        writer.WriteRaw<int>(m_Score);
+        writer.WriteRaw<float>(m_WaveDelayTimer);
+        writer.WriteRaw<bool>(m_WaitingForNextWave);
+        writer.WriteRaw<bool>(m_HasSpawnedEnemies);
+    }
+
+    void GameManager::OnLoadState(StreamReader& reader)
+    {
+        reader.ReadRaw<int>(m_CurrentWave);
+        reader.ReadRaw<int>(m_Score);
+        reader.ReadRaw<float>(m_WaveDelayTimer);
+        reader.ReadRaw<bool>(m_WaitingForNextWave);
+        reader.ReadRaw<bool>(m_HasSpawnedEnemies);
+    }
+
 }
@@ -14,6 +14,9 @@ namespace Luden
         virtual void OnCollisionBegin(const CollisionContact& contact) override;
         virtual void OnCollisionEnd(const CollisionContact& contact) override;
         virtual void OnCollisionHit(const CollisionContact& contact) override;
+        virtual uint8_t GetCollisionEvents() const override { return (uint8_t)CollisionEvent::None; }
+        virtual void OnSaveState(StreamWriter& writer) override;
+        virtual void OnLoadState(StreamReader& reader) override;
 
     public:
         Vec2 m_WorldGravity = { 0.0f, 0.0f };
@@ -27,6 +27,7 @@ IncludeDirs["imgui"] = "extern/imgui"
 IncludeDirs["ImGuiSFML"] = "extern/ImGui-SFML"
 IncludeDirs["IconFontCpp"] = "extern/IconFontCppHeaders"
 IncludeDirs["nfd"] = "extern/nfd/src/include"
+IncludeDirs["lz4"] = "extern/lz4/lib"
 
 -- Include sub-projects
 include "Engine"
@@ -79,6 +79,15 @@ if exist "extern\glm" (
     git clone https://github.com/g-truc/glm.git "extern\glm"
 )
 
+REM --- LZ4 ---
+if exist "extern\lz4" (
+    echo extern\lz4 already exists, pulling latest...
+    git -C "extern\lz4" pull
+) else (
+    echo Cloning LZ4...
+    git clone https://github.com/lz4/lz4.git "extern\lz4"
+)
+
 REM --- Box2D ---
 if exist "extern\Box2D" (
     echo extern\Box2D already exists, pulling latest...